@@ -0,0 +1,359 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "multipath-segment-fetcher.hpp"
+#include "logger.hpp"
+
+#include <ndn-cxx/lp/tags.hpp>
+
+#include <boost/lexical_cast.hpp>
+
+#include <cmath>
+#include <limits>
+
+namespace nlsr {
+
+INIT_LOGGER(MultipathSegmentFetcher);
+
+using ErrorCode = ndn::SegmentFetcher::ErrorCode;
+
+// key of the discovery Interest in m_pendingInterests
+constexpr uint64_t DISCOVERY = std::numeric_limits<uint64_t>::max();
+
+MultipathSegmentFetcher::MultipathSegmentFetcher(ndn::Face& face, const ndn::Name& baseName,
+                                                 ndn::security::Validator& validator,
+                                                 const Options& options)
+  : m_face(face)
+  , m_baseName(baseName)
+  , m_validator(validator)
+  , m_options(options)
+{
+}
+
+std::shared_ptr<MultipathSegmentFetcher>
+MultipathSegmentFetcher::start(ndn::Face& face, const ndn::Name& baseName, uint64_t faceId,
+                               ndn::security::Validator& validator, const Options& options)
+{
+  std::shared_ptr<MultipathSegmentFetcher> fetcher(
+    new MultipathSegmentFetcher(face, baseName, validator, options));
+  // keeps the fetcher alive until it completes, fails, or is stopped
+  fetcher->m_this = fetcher;
+  fetcher->addFace(faceId);
+  return fetcher;
+}
+
+void
+MultipathSegmentFetcher::addFace(uint64_t faceId)
+{
+  if (m_this == nullptr || m_faces.count(faceId) > 0) {
+    return;
+  }
+
+  auto& state = m_faces[faceId];
+  state.window = static_cast<double>(m_options.initialWindow);
+  NLSR_LOG_DEBUG("Fetching " << m_baseName << " via face " << faceId
+                 << " (" << m_faces.size() << " faces)");
+
+  // Until the size of the object is known, only the first face sends a discovery Interest.
+  // Additional faces are only worth probing for objects large enough for multipath
+  if (m_faces.size() == 1 || m_isMultipath) {
+    sendDiscoveryInterest(faceId);
+  }
+}
+
+void
+MultipathSegmentFetcher::stop()
+{
+  m_pendingInterests.clear();
+  m_this.reset();
+}
+
+void
+MultipathSegmentFetcher::sendDiscoveryInterest(uint64_t faceId)
+{
+  auto& state = m_faces.at(faceId);
+  state.isDiscovering = true;
+
+  ndn::Interest interest(m_baseName);
+  interest.setCanBePrefix(true);
+  interest.setMustBeFresh(true);
+  interest.setInterestLifetime(m_options.interestLifetime);
+  if (faceId != 0) {
+    interest.setTag(std::make_shared<ndn::lp::NextHopFaceIdTag>(faceId));
+  }
+
+  auto sendTime = ndn::time::steady_clock::now();
+  m_pendingInterests[{faceId, DISCOVERY}] = m_face.expressInterest(interest,
+    [this, faceId, sendTime] (const auto&, const auto& data) {
+      afterData(faceId, std::nullopt, data, sendTime);
+    },
+    [this, faceId] (const auto&, const auto& nack) {
+      afterFailure(faceId, std::nullopt, ErrorCode::NACK_ERROR,
+                   "Nack: " + boost::lexical_cast<std::string>(nack.getReason()));
+    },
+    [this, faceId] (const auto&) {
+      afterFailure(faceId, std::nullopt, ErrorCode::INTEREST_TIMEOUT, "Timeout");
+    });
+}
+
+void
+MultipathSegmentFetcher::fetchSegmentsInWindow()
+{
+  while (!m_segmentQueue.empty()) {
+    auto faceId = selectFace();
+    if (!faceId) {
+      break;
+    }
+    uint64_t segNum = m_segmentQueue.front();
+    m_segmentQueue.pop_front();
+    sendSegmentInterest(*faceId, segNum);
+  }
+}
+
+std::optional<uint64_t>
+MultipathSegmentFetcher::selectFace() const
+{
+  // faces without an RTT sample are assumed to answer within half an Interest lifetime
+  const double defaultRtt = static_cast<double>(
+    ndn::time::duration_cast<ndn::time::nanoseconds>(m_options.interestLifetime).count()) / 2;
+
+  std::optional<uint64_t> best;
+  double bestCost = std::numeric_limits<double>::max();
+  for (const auto& [faceId, state] : m_faces) {
+    if (!state.isEnabled || !state.versionName ||
+        state.outstanding >= static_cast<size_t>(std::floor(state.window))) {
+      continue;
+    }
+    double rtt = state.srtt ? static_cast<double>(state.srtt->count()) : defaultRtt;
+    double cost = static_cast<double>(state.outstanding + 1) * rtt;
+    if (cost < bestCost) {
+      bestCost = cost;
+      best = faceId;
+    }
+  }
+  return best;
+}
+
+void
+MultipathSegmentFetcher::sendSegmentInterest(uint64_t faceId, uint64_t segNum)
+{
+  auto& state = m_faces.at(faceId);
+  ++state.outstanding;
+
+  ndn::Interest interest(ndn::Name(*state.versionName).appendSegment(segNum));
+  interest.setInterestLifetime(m_options.interestLifetime);
+  if (faceId != 0) {
+    interest.setTag(std::make_shared<ndn::lp::NextHopFaceIdTag>(faceId));
+  }
+
+  NLSR_LOG_TRACE("Requesting " << interest.getName() << " via face " << faceId);
+  auto sendTime = ndn::time::steady_clock::now();
+  m_pendingInterests[{faceId, segNum}] = m_face.expressInterest(interest,
+    [this, faceId, segNum, sendTime] (const auto&, const auto& data) {
+      afterData(faceId, segNum, data, sendTime);
+    },
+    [this, faceId, segNum] (const auto&, const auto& nack) {
+      afterFailure(faceId, segNum, ErrorCode::NACK_ERROR,
+                   "Nack: " + boost::lexical_cast<std::string>(nack.getReason()));
+    },
+    [this, faceId, segNum] (const auto&) {
+      afterFailure(faceId, segNum, ErrorCode::INTEREST_TIMEOUT, "Timeout");
+    });
+}
+
+void
+MultipathSegmentFetcher::afterData(uint64_t faceId, std::optional<uint64_t> requestedSegNum,
+                                   const ndn::Data& data,
+                                   ndn::time::steady_clock::time_point sendTime)
+{
+  // keep the fetcher alive even if a signal handler stops it
+  auto self = m_this;
+  m_pendingInterests.erase({faceId, requestedSegNum.value_or(DISCOVERY)});
+  auto& state = m_faces.at(faceId);
+
+  const ndn::Name& dataName = data.getName();
+  if (dataName.size() != m_baseName.size() + 2 || !dataName[-1].isSegment() ||
+      !dataName[-2].isVersion()) {
+    NLSR_LOG_DEBUG("Unexpected Data " << dataName << " via face " << faceId);
+    state.isEnabled = false;
+    afterFailure(faceId, requestedSegNum, ErrorCode::DATA_HAS_NO_SEGMENT,
+                 "Data Name has no segment number");
+    return;
+  }
+
+  auto finalBlock = data.getFinalBlock();
+  if (finalBlock && !finalBlock->isSegment()) {
+    signalError(ErrorCode::FINALBLOCKID_NOT_SEGMENT,
+                "Received FinalBlockId did not contain a segment component");
+    return;
+  }
+
+  auto rtt = ndn::time::steady_clock::now() - sendTime;
+  state.srtt = state.srtt ?
+    ndn::time::nanoseconds(static_cast<int64_t>((1 - m_options.rttAlpha) * state.srtt->count() +
+                                                m_options.rttAlpha * rtt.count())) :
+    ndn::time::duration_cast<ndn::time::nanoseconds>(rtt);
+  state.nConsecutiveFailures = 0;
+
+  if (!requestedSegNum) {
+    state.isDiscovering = false;
+    if (!finalBlock) {
+      signalError(ErrorCode::FINALBLOCKID_NOT_SEGMENT, "Discovery Data has no FinalBlockId");
+      return;
+    }
+    uint64_t nSegments = finalBlock->toSegment() + 1;
+
+    if (!m_nSegments) {
+      m_nSegments = nSegments;
+      m_isMultipath = nSegments >= m_options.minSegmentsForMultipath;
+      for (uint64_t segNum = 0; segNum < nSegments; ++segNum) {
+        if (segNum != dataName[-1].toSegment()) {
+          m_segmentQueue.push_back(segNum);
+        }
+      }
+      NLSR_LOG_DEBUG(m_baseName << " has " << nSegments << " segments, fetching over "
+                     << (m_isMultipath ? "multiple paths" : "a single path"));
+      if (m_isMultipath) {
+        for (auto& [otherFaceId, otherState] : m_faces) {
+          if (!otherState.versionName && !otherState.isDiscovering) {
+            sendDiscoveryInterest(otherFaceId);
+          }
+        }
+      }
+    }
+    else if (nSegments != *m_nSegments) {
+      // a different segmentation cannot be mixed with the segments already received
+      NLSR_LOG_DEBUG("Face " << faceId << " holds a different segmentation of " << m_baseName);
+      state.isEnabled = false;
+      fetchSegmentsInWindow();
+      return;
+    }
+    state.versionName = dataName.getPrefix(-1);
+  }
+  else {
+    if (state.outstanding > 0) {
+      --state.outstanding;
+    }
+    state.window = std::min(state.window + 1.0 / state.window,
+                            static_cast<double>(m_options.maxWindow));
+  }
+
+  uint64_t segNum = dataName[-1].toSegment();
+  if (m_nSegments && segNum < *m_nSegments && m_receivedSegments.insert(segNum).second) {
+    m_validator.validate(data,
+      [this, self, segNum] (const ndn::Data& validated) {
+        if (m_this == nullptr) {
+          return;
+        }
+        afterSegmentValidated(validated);
+        m_validatedContents.emplace(segNum, validated.getContent());
+        if (m_validatedContents.size() == *m_nSegments) {
+          finalizeFetch();
+        }
+      },
+      [this, self] (const ndn::Data&, const ndn::security::ValidationError& error) {
+        if (m_this == nullptr) {
+          return;
+        }
+        signalError(ErrorCode::SEGMENT_VALIDATION_FAIL,
+                    "Segment validation failed: " + boost::lexical_cast<std::string>(error));
+      });
+  }
+
+  if (m_this != nullptr) {
+    fetchSegmentsInWindow();
+  }
+}
+
+void
+MultipathSegmentFetcher::afterFailure(uint64_t faceId, std::optional<uint64_t> segNum,
+                                      uint32_t errorCode, const std::string& reason)
+{
+  auto self = m_this;
+  m_pendingInterests.erase({faceId, segNum.value_or(DISCOVERY)});
+  auto& state = m_faces.at(faceId);
+  NLSR_LOG_DEBUG("Failed to fetch " << (segNum ? "segment " + std::to_string(*segNum) : "discovery")
+                 << " of " << m_baseName << " via face " << faceId << ": " << reason);
+
+  if (!segNum) {
+    state.isDiscovering = false;
+    if (!state.versionName) {
+      // a face that cannot even answer the discovery Interest is not used at all
+      state.isEnabled = false;
+    }
+  }
+  else {
+    if (state.outstanding > 0) {
+      --state.outstanding;
+    }
+    state.window = std::max(state.window / 2, 1.0);
+    if (++state.nConsecutiveFailures >= m_options.maxConsecutiveFaceFailures) {
+      NLSR_LOG_DEBUG("No longer using face " << faceId << " for " << m_baseName);
+      state.isEnabled = false;
+    }
+    if (++m_retries[*segNum] > m_options.maxRetriesPerSegment) {
+      signalError(errorCode, reason);
+      return;
+    }
+    m_segmentQueue.push_front(*segNum);
+  }
+
+  bool canProgress = false;
+  for (const auto& [id, s] : m_faces) {
+    canProgress = canProgress || (s.isEnabled && (s.versionName || s.isDiscovering));
+  }
+
+  if (!canProgress) {
+    // fail over to a face that was added but not probed yet
+    for (auto& [otherFaceId, otherState] : m_faces) {
+      if (otherState.isEnabled && !otherState.versionName) {
+        sendDiscoveryInterest(otherFaceId);
+        return;
+      }
+    }
+    signalError(errorCode, reason);
+    return;
+  }
+
+  fetchSegmentsInWindow();
+}
+
+void
+MultipathSegmentFetcher::finalizeFetch()
+{
+  auto self = m_this;
+  auto buffer = std::make_shared<ndn::Buffer>();
+  for (const auto& [segNum, content] : m_validatedContents) {
+    buffer->insert(buffer->end(), content.value_begin(), content.value_end());
+  }
+  stop();
+  onComplete(buffer);
+}
+
+void
+MultipathSegmentFetcher::signalError(uint32_t errorCode, const std::string& msg)
+{
+  auto self = m_this;
+  stop();
+  onError(errorCode, msg);
+}
+
+} // namespace nlsr
@@ -0,0 +1,173 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_MULTIPATH_SEGMENT_FETCHER_HPP
+#define NLSR_MULTIPATH_SEGMENT_FETCHER_HPP
+
+#include "common.hpp"
+#include "test-access-control.hpp"
+
+#include <ndn-cxx/face.hpp>
+#include <ndn-cxx/security/validator.hpp>
+#include <ndn-cxx/util/segment-fetcher.hpp>
+#include <ndn-cxx/util/signal.hpp>
+
+#include <boost/noncopyable.hpp>
+
+#include <deque>
+#include <map>
+#include <optional>
+#include <set>
+
+namespace nlsr {
+
+/*! \brief Fetches a segmented object by spreading segment Interests over several faces.
+
+  Every face in the fetcher is expected to be able to satisfy the whole object, e.g.
+  because a sync update for it arrived on that face. Each face first sends its own
+  discovery Interest, because neighbors may hold different versions of the same LSA
+  (the origin segments it anew for every requester). Segments with the same number
+  carry the same bytes in every version, and each one is validated on its own.
+
+  A face stays in use only while it performs well. Each face has a congestion window that
+  grows additively on Data and is halved on timeout or Nack, and a smoothed RTT. A pending
+  segment goes to the face with the lowest expected completion time,
+  <tt>(outstanding + 1) * srtt</tt>, among faces with room in their window. This
+  progressively moves load to the fastest responder. Objects with fewer than
+  Options::minSegmentsForMultipath segments are fetched from the first face that answers,
+  as a regular single-path fetch.
+
+  Errors are reported with the codes of ndn::SegmentFetcher::ErrorCode, so callers can
+  handle both fetchers the same way.
+ */
+class MultipathSegmentFetcher : boost::noncopyable
+{
+public:
+  struct Options
+  {
+    ndn::time::milliseconds interestLifetime = 4_s;
+    /// objects with fewer segments are fetched over a single face
+    size_t minSegmentsForMultipath = 4;
+    size_t initialWindow = 2;
+    size_t maxWindow = 16;
+    /// number of times one segment may be retransmitted before the fetch fails
+    size_t maxRetriesPerSegment = 4;
+    /// consecutive failures after which a face is no longer used
+    size_t maxConsecutiveFaceFailures = 3;
+    /// weight of a new sample in the smoothed RTT
+    double rttAlpha = 0.125;
+  };
+
+  /*! \brief Starts fetching \p baseName, initially through \p faceId.
+    \param faceId Face towards a holder of the object; 0 lets the forwarding strategy decide.
+   */
+  static std::shared_ptr<MultipathSegmentFetcher>
+  start(ndn::Face& face, const ndn::Name& baseName, uint64_t faceId,
+        ndn::security::Validator& validator, const Options& options);
+
+  /*! \brief Adds another face that can serve the object.
+
+    Ignored if the face is already known or the fetch has finished.
+   */
+  void
+  addFace(uint64_t faceId);
+
+  /*! \brief Stops the fetch; no signal is emitted afterwards.
+   */
+  void
+  stop();
+
+  size_t
+  getNFaces() const
+  {
+    return m_faces.size();
+  }
+
+private:
+  MultipathSegmentFetcher(ndn::Face& face, const ndn::Name& baseName,
+                          ndn::security::Validator& validator, const Options& options);
+
+  struct FaceState
+  {
+    std::optional<ndn::Name> versionName;
+    bool isDiscovering = false;
+    bool isEnabled = true;
+    size_t outstanding = 0;
+    double window = 0;
+    std::optional<ndn::time::nanoseconds> srtt;
+    size_t nConsecutiveFailures = 0;
+  };
+
+  void
+  sendDiscoveryInterest(uint64_t faceId);
+
+  void
+  fetchSegmentsInWindow();
+
+  std::optional<uint64_t>
+  selectFace() const;
+
+  void
+  sendSegmentInterest(uint64_t faceId, uint64_t segNum);
+
+  void
+  afterData(uint64_t faceId, std::optional<uint64_t> segNum, const ndn::Data& data,
+            ndn::time::steady_clock::time_point sendTime);
+
+  void
+  afterFailure(uint64_t faceId, std::optional<uint64_t> segNum, uint32_t errorCode,
+               const std::string& reason);
+
+  void
+  finalizeFetch();
+
+  void
+  signalError(uint32_t errorCode, const std::string& msg);
+
+public:
+  /// emitted once with the reassembled object
+  ndn::signal::Signal<MultipathSegmentFetcher, ndn::ConstBufferPtr> onComplete;
+  /// emitted once if the object cannot be fetched
+  ndn::signal::Signal<MultipathSegmentFetcher, uint32_t, std::string> onError;
+  /// emitted for every segment that passed validation
+  ndn::signal::Signal<MultipathSegmentFetcher, ndn::Data> afterSegmentValidated;
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  ndn::Face& m_face;
+  ndn::Name m_baseName;
+  ndn::security::Validator& m_validator;
+  Options m_options;
+
+  std::map<uint64_t, FaceState> m_faces;
+  std::map<std::pair<uint64_t, uint64_t>, ndn::ScopedPendingInterestHandle> m_pendingInterests;
+  std::optional<uint64_t> m_nSegments;
+  bool m_isMultipath = false;
+  std::deque<uint64_t> m_segmentQueue;
+  std::map<uint64_t, size_t> m_retries;
+  std::set<uint64_t> m_receivedSegments;
+  std::map<uint64_t, ndn::Block> m_validatedContents;
+
+  std::shared_ptr<MultipathSegmentFetcher> m_this;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_MULTIPATH_SEGMENT_FETCHER_HPP
@@ -33,6 +33,7 @@
 #include <boost/optional.hpp>
 #include <boost/property_tree/info_parser.hpp>
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
@@ -395,6 +396,61 @@ ConfFileProcessor::processConfSectionGeneral(const ConfigSection& section)
     return false;
   }
 
+  // lsdb-snapshot-interval
+  uint32_t snapshotInterval = section.get<uint32_t>("lsdb-snapshot-interval",
+                                                    LSDB_SNAPSHOT_INTERVAL_DEFAULT);
+  if (snapshotInterval <= LSDB_SNAPSHOT_INTERVAL_MAX) {
+    m_confParam.setLsdbSnapshotInterval(snapshotInterval);
+  }
+  else {
+    std::cerr << "Invalid value for lsdb-snapshot-interval. "
+              << "Allowed range: " << LSDB_SNAPSHOT_INTERVAL_MIN
+              << "-" << LSDB_SNAPSHOT_INTERVAL_MAX << std::endl;
+    return false;
+  }
+
+  // lsdb-bootstrap
+  std::string lsdbBootstrap = section.get<std::string>("lsdb-bootstrap", "off");
+  if (boost::iequals(lsdbBootstrap, "on")) {
+    m_confParam.setLsdbBootstrapEnabled(true);
+  }
+  else if (boost::iequals(lsdbBootstrap, "off")) {
+    m_confParam.setLsdbBootstrapEnabled(false);
+  }
+  else {
+    std::cerr << "Invalid setting for lsdb-bootstrap. "
+              << "Allowed values: on, off" << std::endl;
+    return false;
+  }
+
+  // lsa-fetch-multipath
+  std::string lsaFetchMultipath = section.get<std::string>("lsa-fetch-multipath", "off");
+  if (boost::iequals(lsaFetchMultipath, "on")) {
+    m_confParam.setLsaMultipathFetchEnabled(true);
+  }
+  else if (boost::iequals(lsaFetchMultipath, "off")) {
+    m_confParam.setLsaMultipathFetchEnabled(false);
+  }
+  else {
+    std::cerr << "Invalid setting for lsa-fetch-multipath. "
+              << "Allowed values: on, off" << std::endl;
+    return false;
+  }
+
+  // lsa-storage
+  std::string lsaStorage = section.get<std::string>("lsa-storage", "decoded");
+  if (boost::iequals(lsaStorage, "wire")) {
+    m_confParam.setLsaWireStorageEnabled(true);
+  }
+  else if (boost::iequals(lsaStorage, "decoded")) {
+    m_confParam.setLsaWireStorageEnabled(false);
+  }
+  else {
+    std::cerr << "Invalid setting for lsa-storage. "
+              << "Allowed values: decoded, wire" << std::endl;
+    return false;
+  }
+
   // sidecar-log-path
   try {
     // 設定ファイルに存在するかチェック（boost::property_tree::ptreeにはhas()がないため、get_optional()を使用）
@@ -411,6 +467,57 @@ ConfFileProcessor::processConfSectionGeneral(const ConfigSection& section)
     m_confParam.setSidecarLogPath("");
   }
 
+  // sidecar-log-timezone
+  std::string sidecarLogTimeZone = section.get<std::string>("sidecar-log-timezone", "local");
+  if (boost::iequals(sidecarLogTimeZone, "local")) {
+    m_confParam.setSidecarLogTimeZone(SidecarTimeZone::LOCAL);
+  }
+  else if (boost::iequals(sidecarLogTimeZone, "utc")) {
+    m_confParam.setSidecarLogTimeZone(SidecarTimeZone::UTC);
+  }
+  else {
+    std::cerr << "Invalid setting for sidecar-log-timezone. "
+              << "Allowed values: local, utc" << std::endl;
+    return false;
+  }
+
+  // sidecar-min-update-interval
+  uint32_t sidecarMinUpdateInterval = section.get<uint32_t>("sidecar-min-update-interval",
+                                                            SIDECAR_MIN_UPDATE_INTERVAL_DEFAULT);
+  if (sidecarMinUpdateInterval <= SIDECAR_MIN_UPDATE_INTERVAL_MAX) {
+    m_confParam.setSidecarMinUpdateInterval(ndn::time::milliseconds(sidecarMinUpdateInterval));
+  }
+  else {
+    std::cerr << "Invalid value for sidecar-min-update-interval. "
+              << "Allowed range: " << SIDECAR_MIN_UPDATE_INTERVAL_MIN
+              << "-" << SIDECAR_MIN_UPDATE_INTERVAL_MAX << std::endl;
+    return false;
+  }
+
+  // sidecar-shm-name
+  std::string sidecarShmName = section.get<std::string>("sidecar-shm-name", "");
+  if (!sidecarShmName.empty() &&
+      (sidecarShmName[0] != '/' || sidecarShmName.find('/', 1) != std::string::npos)) {
+    std::cerr << "Invalid value for sidecar-shm-name. "
+              << "It must start with '/' and contain no other '/'" << std::endl;
+    return false;
+  }
+  m_confParam.setSidecarShmName(sidecarShmName);
+
+  // sidecar-ingestion-thread
+  std::string sidecarIngestionThread = section.get<std::string>("sidecar-ingestion-thread", "off");
+  if (boost::iequals(sidecarIngestionThread, "on")) {
+    m_confParam.setSidecarIngestionThreadEnabled(true);
+  }
+  else if (boost::iequals(sidecarIngestionThread, "off")) {
+    m_confParam.setSidecarIngestionThreadEnabled(false);
+  }
+  else {
+    std::cerr << "Invalid setting for sidecar-ingestion-thread. "
+              << "Allowed values: on, off" << std::endl;
+    return false;
+  }
+
   return true;
 }
 
@@ -712,6 +819,39 @@ ConfFileProcessor::processConfSectionServiceFunction(const ConfigSection& sectio
     }
 
     m_confParam.setServiceFunctionWeights(processingWeight, loadWeight, usageWeight);
+
+    double latencyWeight = section.get<double>("latency-weight", 0.0);
+    if (latencyWeight < 0.0) {
+      std::cerr << "Invalid latency-weight in service-function section. "
+                << "Value must be non-negative" << std::endl;
+      return false;
+    }
+    m_confParam.setLatencyWeight(latencyWeight);
+
+    double smoothing = section.get<double>("advertise-smoothing", 0.5);
+    double absoluteThreshold = section.get<double>("advertise-absolute-threshold", 0.05);
+    double relativeThreshold = section.get<double>("advertise-relative-threshold", 0.2);
+    uint32_t minInterval = section.get<uint32_t>("advertise-min-interval", 5);
+    uint32_t maxInterval = section.get<uint32_t>("advertise-max-interval", 60);
+    if (smoothing <= 0.0 || smoothing > 1.0) {
+      std::cerr << "Invalid advertise-smoothing in service-function section. "
+                << "Value must be in (0.0, 1.0]" << std::endl;
+      return false;
+    }
+    if (absoluteThreshold < 0.0 || relativeThreshold < 0.0) {
+      std::cerr << "Invalid advertise thresholds in service-function section. "
+                << "Values must be non-negative" << std::endl;
+      return false;
+    }
+    if (maxInterval == 0 || minInterval > maxInterval) {
+      std::cerr << "Invalid advertise intervals in service-function section. "
+                << "advertise-max-interval must be positive and not below advertise-min-interval"
+                << std::endl;
+      return false;
+    }
+    m_confParam.setAdvertisementOptions(smoothing, absoluteThreshold, relativeThreshold,
+                                        ndn::time::seconds(minInterval),
+                                        ndn::time::seconds(maxInterval));
   
   // Parse utilization window setting
   uint32_t utilizationWindowSeconds = 1;  // デフォルト: 1秒
@@ -723,12 +863,137 @@ ConfFileProcessor::processConfSectionServiceFunction(const ConfigSection& sectio
     }
   }
   m_confParam.setUtilizationWindowSeconds(utilizationWindowSeconds);
+
+  // Parse worker capacity (0: advertised by the sidecar)
+  m_confParam.setWorkerCapacity(section.get<uint32_t>("worker-capacity", 0));
+
+  // Parse overload signalling (max-concurrency 0: the worker capacity)
+  m_confParam.setMaxConcurrency(section.get<uint32_t>("max-concurrency", 0));
+  double overloadClearRatio = section.get<double>("overload-clear-ratio", 0.8);
+  if (overloadClearRatio < 0.0 || overloadClearRatio > 1.0) {
+    std::cerr << "Invalid overload-clear-ratio in service-function section. "
+              << "Value must be between 0 and 1" << std::endl;
+    return false;
+  }
+  m_confParam.setOverloadClearRatio(overloadClearRatio);
+  m_confParam.setOverloadHoldTime(ndn::time::seconds(section.get<uint32_t>("overload-hold-time", 5)));
+
+  // Parse the function cost model, for all function prefixes and per function prefix
+  auto parseCostModel = [] (const std::string& value) -> std::optional<FunctionCostModelType> {
+    if (value == "linear") {
+      return FunctionCostModelType::LINEAR;
+    }
+    if (value == "queueing") {
+      return FunctionCostModelType::QUEUEING;
+    }
+    std::cerr << "Invalid cost model '" << value << "' in service-function section. "
+              << "Use 'linear' or 'queueing'" << std::endl;
+    return std::nullopt;
+  };
+  auto defaultCostModel = parseCostModel(section.get<std::string>("cost-model", "linear"));
+  if (!defaultCostModel) {
+    return false;
+  }
+  m_confParam.setDefaultFunctionCostModel(*defaultCostModel);
+
+  auto functionCostModels = section.get_child_optional("function-cost-model");
+  if (functionCostModels) {
+    for (const auto& [prefix, value] : *functionCostModels) {
+      auto costModel = parseCostModel(value.get_value<std::string>());
+      if (!costModel) {
+        return false;
+      }
+      m_confParam.setFunctionCostModel(ndn::Name(prefix), *costModel);
+    }
+  }
+
+  double queueingCostPerSecond = section.get<double>("queueing-cost-per-second", 1000.0);
+  if (queueingCostPerSecond <= 0.0) {
+    std::cerr << "Invalid queueing-cost-per-second in service-function section. "
+              << "Value must be positive" << std::endl;
+    return false;
+  }
+  m_confParam.setQueueingCostPerSecond(queueingCostPerSecond);
+
+  // Parse how far the utilization of remote instances may be extrapolated
+  m_confParam.setForecastHorizon(ndn::time::seconds(section.get<uint32_t>("forecast-horizon", 10)));
+
+  // Parse active probing of function prefixes (0: disabled)
+  uint32_t probeInterval = section.get<uint32_t>("probe-interval", 0);
+  uint32_t probeMaxFaces = section.get<uint32_t>("probe-max-faces", 4);
+  double probeCostPerSecond = section.get<double>("probe-cost-per-second", 1000.0);
+  double probeFailureCost = section.get<double>("probe-failure-cost", 100.0);
+  if (probeMaxFaces == 0 || probeCostPerSecond < 0.0 || probeFailureCost < 0.0) {
+    std::cerr << "Invalid probe settings in service-function section. probe-max-faces must be "
+              << "positive, probe costs must be non-negative" << std::endl;
+    return false;
+  }
+  m_confParam.setProbeOptions(ndn::time::seconds(probeInterval), probeMaxFaces,
+                              probeCostPerSecond, probeFailureCost);
+
+  // Parse the Service Function chains whose instances are selected together
+  for (const auto& [key, chainSection] : section) {
+    if (key != "sfc-chain") {
+      continue;
+    }
+    std::string chainName = chainSection.get<std::string>("name", "");
+    if (chainName.empty() || m_confParam.getServiceFunctionChains().count(chainName) > 0) {
+      std::cerr << "Each sfc-chain in service-function section needs a unique name" << std::endl;
+      return false;
+    }
+    std::vector<ndn::Name> stages;
+    for (const auto& [stageKey, stageValue] : chainSection) {
+      if (stageKey == "stage") {
+        stages.emplace_back(stageValue.get_value<std::string>());
+      }
+    }
+    if (stages.empty()) {
+      std::cerr << "sfc-chain " << chainName << " in service-function section has no stage" << std::endl;
+      return false;
+    }
+    m_confParam.addServiceFunctionChain(chainName, stages);
+  }
+
+  // Parse load balancing over Service Function instances
+  m_confParam.setLoadBalancingEnabled(section.get<bool>("load-balancing", false));
+  std::string loadBalancingStrategy = section.get<std::string>("load-balancing-strategy",
+                                                               m_confParam.getLoadBalancingStrategy().toUri());
+  ndn::Name loadBalancingStrategyName(loadBalancingStrategy);
+  if (loadBalancingStrategyName.empty()) {
+    std::cerr << "Invalid load-balancing-strategy in service-function section" << std::endl;
+    return false;
+  }
+  m_confParam.setLoadBalancingStrategy(loadBalancingStrategyName);
+
+  // Parse the preference for the instances of the local site
+  bool isSitePreferenceEnabled = section.get<bool>("site-preference", false);
+  double siteHeadroomThreshold = section.get<double>("site-headroom-threshold", 0.2);
+  if (siteHeadroomThreshold < 0.0 || siteHeadroomThreshold > 1.0) {
+    std::cerr << "Invalid site-headroom-threshold in service-function section. "
+              << "Value must be in [0.0, 1.0]" << std::endl;
+    return false;
+  }
+  m_confParam.setSitePreference(isSitePreferenceEnabled, siteHeadroomThreshold);
   
-  // Parse dynamic weighting setting
-  bool dynamicWeighting = false;
-  if (section.get<bool>("dynamic-weighting", dynamicWeighting)) {
-    m_confParam.setDynamicWeightingEnabled(dynamicWeighting);
+  // Parse dynamic weighting, which learns the weights from the observed latency
+  m_confParam.setDynamicWeightingEnabled(section.get<bool>("dynamic-weighting", false));
+  double weightingForgetting = section.get<double>("dynamic-weighting-forgetting", 0.98);
+  double weightingMinWeight = section.get<double>("dynamic-weighting-min-weight", 0.0);
+  double weightingMaxWeight = section.get<double>("dynamic-weighting-max-weight", 1.0);
+  double weightingMaxStep = section.get<double>("dynamic-weighting-max-step", 0.05);
+  if (weightingForgetting <= 0.0 || weightingForgetting > 1.0) {
+    std::cerr << "Invalid dynamic-weighting-forgetting in service-function section. "
+              << "Value must be in (0.0, 1.0]" << std::endl;
+    return false;
   }
+  if (weightingMinWeight < 0.0 || weightingMaxWeight < weightingMinWeight || weightingMaxStep <= 0.0) {
+    std::cerr << "Invalid dynamic weighting bounds in service-function section. "
+              << "dynamic-weighting-min-weight must be non-negative and not above "
+              << "dynamic-weighting-max-weight, dynamic-weighting-max-step must be positive" << std::endl;
+    return false;
+  }
+  m_confParam.setDynamicWeightingOptions(weightingForgetting, weightingMinWeight,
+                                         weightingMaxWeight, weightingMaxStep);
 
   // Parse service function prefixes (optional, can be specified multiple times)
   // Clear existing prefixes first
@@ -753,6 +1018,31 @@ ConfFileProcessor::processConfSectionServiceFunction(const ConfigSection& sectio
     }
   }
   
+  // Parse the sources of the records of each hosted function, which are also function prefixes
+  for (const auto& [key, sourceSection] : section) {
+    if (key != "function-source") {
+      continue;
+    }
+    ServiceFunctionSource source;
+    source.prefix = sourceSection.get<std::string>("prefix", "");
+    source.logPath = sourceSection.get<std::string>("log-path", "");
+    source.callName = sourceSection.get<std::string>("call-name", "");
+    if (source.prefix.empty()) {
+      std::cerr << "Each function-source in service-function section needs a prefix" << std::endl;
+      return false;
+    }
+    const auto& sources = m_confParam.getServiceFunctionSources();
+    if (std::any_of(sources.begin(), sources.end(), [&] (const auto& other) {
+          return other.logPath == source.logPath && other.callName == source.callName; })) {
+      std::cerr << "function-source " << source.prefix << " in service-function section "
+                << "reads the same records as another function-source" << std::endl;
+      return false;
+    }
+    m_confParam.addServiceFunctionSource(source);
+    m_confParam.addServiceFunctionPrefix(source.prefix);
+    foundFunctionPrefix = true;
+  }
+
   // If no function-prefix was specified, service function routing will be disabled
   // (no default prefix is added to avoid hardcoding environment-specific prefixes)
   if (!foundFunctionPrefix) {
@@ -50,6 +50,7 @@ ConfParameter::ConfParameter(ndn::Face& face, ndn::KeyChain& keyChain,
   , m_hyperbolicState(HYPERBOLIC_STATE_OFF)
   , m_corR(0)
   , m_maxFacesPerPrefix(MAX_FACES_PER_PREFIX_MIN)
+  , m_lsdbSnapshotInterval(LSDB_SNAPSHOT_INTERVAL_DEFAULT)
   , m_syncInterestLifetime(ndn::time::milliseconds(SYNC_INTEREST_LIFETIME_DEFAULT))
   , m_adjl()
   , m_npl()
@@ -85,6 +86,11 @@ ConfParameter::writeLog()
     }
   }
   NLSR_LOG_INFO("State Directory: " << m_stateFileDir);
+  NLSR_LOG_INFO("LSDB snapshot interval: " << m_lsdbSnapshotInterval);
+  NLSR_LOG_INFO("LSDB bootstrap from neighbor: " << (m_isLsdbBootstrapEnabled ? "on" : "off"));
+  NLSR_LOG_INFO("Multipath LSA fetching: " << (m_isLsaMultipathFetchEnabled ? "on" : "off"));
+  NLSR_LOG_INFO("LSA storage: " << (m_isLsaWireStorageEnabled ? "wire" : "decoded"));
+  NLSR_LOG_INFO("Sidecar minimum update interval: " << m_sidecarMinUpdateInterval);
 
   // Event Intervals
   NLSR_LOG_INFO("Adjacency LSA build interval:  " << m_adjLsaBuildInterval);
@@ -26,13 +26,16 @@
 #include "test-access-control.hpp"
 #include "adjacency-list.hpp"
 #include "name-prefix-list.hpp"
+#include "publisher/sidecar-record.hpp"
 
 #include <ndn-cxx/face.hpp>
 #include <ndn-cxx/security/validator-config.hpp>
 #include <ndn-cxx/security/certificate-fetcher-direct-fetch.hpp>
 
+#include <map>
 #include <optional>
 #include <set>
+#include <vector>
 
 namespace nlsr {
 
@@ -42,6 +45,22 @@ enum class SyncProtocol {
   SVS,
 };
 
+enum class FunctionCostModelType {
+  LINEAR,
+  QUEUEING,
+};
+
+/*! \brief Where the sidecar records of one Service Function hosted on this router come from.
+ */
+struct ServiceFunctionSource
+{
+  ndn::Name prefix;
+  /// log written by the sidecar of the function; empty for sidecar-log-path
+  std::string logPath;
+  /// call_name of the records of the function in that log; empty for all its records
+  std::string callName;
+};
+
 enum {
   LSA_REFRESH_TIME_MIN = 240,
   LSA_REFRESH_TIME_DEFAULT = 1800,
@@ -110,6 +129,18 @@ enum HyperbolicState {
   HYPERBOLIC_STATE_DEFAULT = 0
 };
 
+enum {
+  LSDB_SNAPSHOT_INTERVAL_MIN = 0,
+  LSDB_SNAPSHOT_INTERVAL_DEFAULT = 60,
+  LSDB_SNAPSHOT_INTERVAL_MAX = 3600
+};
+
+enum {
+  SIDECAR_MIN_UPDATE_INTERVAL_MIN = 0,
+  SIDECAR_MIN_UPDATE_INTERVAL_DEFAULT = 500,
+  SIDECAR_MIN_UPDATE_INTERVAL_MAX = 60000
+};
+
 enum {
   SYNC_INTEREST_LIFETIME_MIN = 1000,
   SYNC_INTEREST_LIFETIME_DEFAULT = 60000,
@@ -404,6 +435,65 @@ public:
     return m_stateFileDir;
   }
 
+  /*! \brief Set how often (in seconds) the LSDB snapshot is rewritten; 0 disables it.
+   */
+  void
+  setLsdbSnapshotInterval(uint32_t interval)
+  {
+    m_lsdbSnapshotInterval = interval;
+  }
+
+  uint32_t
+  getLsdbSnapshotInterval() const
+  {
+    return m_lsdbSnapshotInterval;
+  }
+
+  /*! \brief Set whether a joining router fetches the whole LSDB from its first neighbor.
+   */
+  void
+  setLsdbBootstrapEnabled(bool enabled)
+  {
+    m_isLsdbBootstrapEnabled = enabled;
+  }
+
+  bool
+  isLsdbBootstrapEnabled() const
+  {
+    return m_isLsdbBootstrapEnabled;
+  }
+
+  /*! \brief Set whether large LSAs are fetched over all neighbors that announced them.
+   */
+  void
+  setLsaMultipathFetchEnabled(bool enabled)
+  {
+    m_isLsaMultipathFetchEnabled = enabled;
+  }
+
+  bool
+  isLsaMultipathFetchEnabled() const
+  {
+    return m_isLsaMultipathFetchEnabled;
+  }
+
+  /*! \brief Set whether remote LSAs are kept as their received wire between uses.
+
+    The decoded fields of such LSAs are dropped after they are installed and decoded
+    again on the next access.
+   */
+  void
+  setLsaWireStorageEnabled(bool enabled)
+  {
+    m_isLsaWireStorageEnabled = enabled;
+  }
+
+  bool
+  isLsaWireStorageEnabled() const
+  {
+    return m_isLsaWireStorageEnabled;
+  }
+
   void
   setConfFileNameDynamic(const std::string& confFileDynamic)
   {
@@ -514,6 +604,66 @@ public:
     return m_usageWeight;
   }
 
+  /*! \brief Set the cost added per second of p99 service latency.
+
+    0 leaves tail latency out of the function cost.
+   */
+  void
+  setLatencyWeight(double weight)
+  {
+    m_latencyWeight = weight;
+  }
+
+  double
+  getLatencyWeight() const
+  {
+    return m_latencyWeight;
+  }
+
+  /*! \brief Set how the own Service Function info is smoothed and gated before advertising.
+    \sa AdvertisementController
+   */
+  void
+  setAdvertisementOptions(double smoothing, double absoluteThreshold, double relativeThreshold,
+                          ndn::time::seconds minInterval, ndn::time::seconds maxInterval)
+  {
+    m_advertisementSmoothing = smoothing;
+    m_advertisementAbsoluteThreshold = absoluteThreshold;
+    m_advertisementRelativeThreshold = relativeThreshold;
+    m_advertisementMinInterval = minInterval;
+    m_advertisementMaxInterval = maxInterval;
+  }
+
+  double
+  getAdvertisementSmoothing() const
+  {
+    return m_advertisementSmoothing;
+  }
+
+  double
+  getAdvertisementAbsoluteThreshold() const
+  {
+    return m_advertisementAbsoluteThreshold;
+  }
+
+  double
+  getAdvertisementRelativeThreshold() const
+  {
+    return m_advertisementRelativeThreshold;
+  }
+
+  const ndn::time::seconds&
+  getAdvertisementMinInterval() const
+  {
+    return m_advertisementMinInterval;
+  }
+
+  const ndn::time::seconds&
+  getAdvertisementMaxInterval() const
+  {
+    return m_advertisementMaxInterval;
+  }
+
   // Utilization window for time-based utilization calculation
   void
   setUtilizationWindowSeconds(uint32_t windowSeconds)
@@ -527,6 +677,234 @@ public:
     return m_utilizationWindowSeconds;
   }
 
+  /*! \brief Set the number of requests a service function can serve in parallel.
+
+    0 means the value advertised by the sidecar is used, or 1 if it advertises none.
+   */
+  void
+  setWorkerCapacity(uint32_t capacity)
+  {
+    m_workerCapacity = capacity;
+  }
+
+  uint32_t
+  getWorkerCapacity() const
+  {
+    return m_workerCapacity;
+  }
+
+  /*! \brief Set the number of requests a service function may have in flight before it
+    advertises itself as overloaded.
+
+    0 means the worker capacity is used.
+   */
+  void
+  setMaxConcurrency(uint32_t maxConcurrency)
+  {
+    m_maxConcurrency = maxConcurrency;
+  }
+
+  uint32_t
+  getMaxConcurrency() const
+  {
+    return m_maxConcurrency;
+  }
+
+  /*! \brief Set the share of max-concurrency in flight at or below which an overload ends.
+   */
+  void
+  setOverloadClearRatio(double ratio)
+  {
+    m_overloadClearRatio = ratio;
+  }
+
+  double
+  getOverloadClearRatio() const
+  {
+    return m_overloadClearRatio;
+  }
+
+  /*! \brief Set how long the next hops towards an instance stay removed after it stopped
+    advertising itself as overloaded.
+   */
+  void
+  setOverloadHoldTime(ndn::time::seconds holdTime)
+  {
+    m_overloadHoldTime = holdTime;
+  }
+
+  ndn::time::seconds
+  getOverloadHoldTime() const
+  {
+    return m_overloadHoldTime;
+  }
+
+  /*! \brief Set the cost model used for function prefixes without their own model.
+    \sa FunctionCostModel
+   */
+  void
+  setDefaultFunctionCostModel(FunctionCostModelType type)
+  {
+    m_defaultFunctionCostModel = type;
+  }
+
+  /*! \brief Set the cost model used for \p prefix.
+   */
+  void
+  setFunctionCostModel(const ndn::Name& prefix, FunctionCostModelType type)
+  {
+    m_functionCostModels[prefix] = type;
+  }
+
+  FunctionCostModelType
+  getFunctionCostModel(const ndn::Name& prefix) const
+  {
+    auto it = m_functionCostModels.find(prefix);
+    return it != m_functionCostModels.end() ? it->second : m_defaultFunctionCostModel;
+  }
+
+  /*! \brief Set the cost added per second of expected sojourn time in the queueing cost model.
+   */
+  void
+  setQueueingCostPerSecond(double cost)
+  {
+    m_queueingCostPerSecond = cost;
+  }
+
+  double
+  getQueueingCostPerSecond() const
+  {
+    return m_queueingCostPerSecond;
+  }
+
+  /*! \brief Set how far ahead the advertised utilization of remote Service Function
+    instances may be extrapolated along its trend. 0 disables the extrapolation.
+   */
+  void
+  setForecastHorizon(ndn::time::seconds horizon)
+  {
+    m_forecastHorizon = horizon;
+  }
+
+  ndn::time::seconds
+  getForecastHorizon() const
+  {
+    return m_forecastHorizon;
+  }
+
+  /*! \brief Set how Service Function prefixes are probed through their next hops.
+    \param interval time between two probe rounds of a prefix; 0 disables probing
+    \param maxFaces number of next hops a round probes at most
+    \param costPerSecond cost added per second of smoothed probe RTT
+    \param failureCost cost added when every probe fails
+    \sa ServiceFunctionProber
+   */
+  void
+  setProbeOptions(ndn::time::seconds interval, size_t maxFaces, double costPerSecond, double failureCost)
+  {
+    m_probeInterval = interval;
+    m_probeMaxFaces = maxFaces;
+    m_probeCostPerSecond = costPerSecond;
+    m_probeFailureCost = failureCost;
+  }
+
+  ndn::time::seconds
+  getProbeInterval() const
+  {
+    return m_probeInterval;
+  }
+
+  size_t
+  getProbeMaxFaces() const
+  {
+    return m_probeMaxFaces;
+  }
+
+  double
+  getProbeCostPerSecond() const
+  {
+    return m_probeCostPerSecond;
+  }
+
+  double
+  getProbeFailureCost() const
+  {
+    return m_probeFailureCost;
+  }
+
+  /*! \brief Add a Service Function chain whose instances are selected together.
+    \param name name of the chain in the sfc-chains dataset
+    \param stages function prefixes in the order a request visits them
+    \sa optimizeChain
+   */
+  void
+  addServiceFunctionChain(const std::string& name, const std::vector<ndn::Name>& stages)
+  {
+    m_serviceFunctionChains[name] = stages;
+  }
+
+  const std::map<std::string, std::vector<ndn::Name>>&
+  getServiceFunctionChains() const
+  {
+    return m_serviceFunctionChains;
+  }
+
+  /*! \brief Set whether traffic to Service Function prefixes is split over next hops
+    in proportion to the headroom of the instances behind them.
+    \sa Fib::setTrafficSplit
+   */
+  void
+  setLoadBalancingEnabled(bool isEnabled)
+  {
+    m_isLoadBalancingEnabled = isEnabled;
+  }
+
+  bool
+  isLoadBalancingEnabled() const
+  {
+    return m_isLoadBalancingEnabled;
+  }
+
+  /*! \brief Set the NFD strategy that applies the traffic split, without parameters.
+   */
+  void
+  setLoadBalancingStrategy(const ndn::Name& strategy)
+  {
+    m_loadBalancingStrategy = strategy;
+  }
+
+  const ndn::Name&
+  getLoadBalancingStrategy() const
+  {
+    return m_loadBalancingStrategy;
+  }
+
+  /*! \brief Set whether requests for a Service Function stay in the local site while
+    the instances there have headroom.
+
+    \param headroomThreshold Spare share of the local workers below which requests spill
+                             over to the instances of other sites, 0.0 ~ 1.0
+    \sa selectSite
+   */
+  void
+  setSitePreference(bool isEnabled, double headroomThreshold)
+  {
+    m_isSitePreferenceEnabled = isEnabled;
+    m_siteHeadroomThreshold = headroomThreshold;
+  }
+
+  bool
+  isSitePreferenceEnabled() const
+  {
+    return m_isSitePreferenceEnabled;
+  }
+
+  double
+  getSiteHeadroomThreshold() const
+  {
+    return m_siteHeadroomThreshold;
+  }
+
   // Dynamic weight adjustment methods
   void
   updateWeightsFromSidecar(double processingWeight, double loadWeight, double usageWeight)
@@ -548,6 +926,39 @@ public:
     m_dynamicWeightingEnabled = enabled;
   }
 
+  void
+  setDynamicWeightingOptions(double forgetting, double minWeight, double maxWeight, double maxStep)
+  {
+    m_dynamicWeightingForgetting = forgetting;
+    m_dynamicWeightingMinWeight = minWeight;
+    m_dynamicWeightingMaxWeight = maxWeight;
+    m_dynamicWeightingMaxStep = maxStep;
+  }
+
+  double
+  getDynamicWeightingForgetting() const
+  {
+    return m_dynamicWeightingForgetting;
+  }
+
+  double
+  getDynamicWeightingMinWeight() const
+  {
+    return m_dynamicWeightingMinWeight;
+  }
+
+  double
+  getDynamicWeightingMaxWeight() const
+  {
+    return m_dynamicWeightingMaxWeight;
+  }
+
+  double
+  getDynamicWeightingMaxStep() const
+  {
+    return m_dynamicWeightingMaxStep;
+  }
+
   // Sidecar log path methods
   void
   setSidecarLogPath(const std::string& logPath)
@@ -561,6 +972,66 @@ public:
     return m_sidecarLogPath;
   }
 
+  /*! \brief Set the minimum time between two updates triggered by sidecar log changes.
+   */
+  void
+  setSidecarMinUpdateInterval(ndn::time::milliseconds interval)
+  {
+    m_sidecarMinUpdateInterval = interval;
+  }
+
+  ndn::time::milliseconds
+  getSidecarMinUpdateInterval() const
+  {
+    return m_sidecarMinUpdateInterval;
+  }
+
+  /*! \brief Set the name of the shared-memory ring the sidecar writes call records to.
+
+    Empty disables shared-memory ingestion.
+   */
+  void
+  setSidecarShmName(const std::string& name)
+  {
+    m_sidecarShmName = name;
+  }
+
+  const std::string&
+  getSidecarShmName() const
+  {
+    return m_sidecarShmName;
+  }
+
+  /*! \brief Set the time zone of the timestamps of the sidecar logs.
+   */
+  void
+  setSidecarLogTimeZone(SidecarTimeZone timeZone)
+  {
+    m_sidecarLogTimeZone = timeZone;
+  }
+
+  SidecarTimeZone
+  getSidecarLogTimeZone() const
+  {
+    return m_sidecarLogTimeZone;
+  }
+
+  /*! \brief Set whether sidecar records are read and aggregated on a dedicated thread.
+
+    Otherwise they are read from the main io_context, between the routing protocol events.
+   */
+  void
+  setSidecarIngestionThreadEnabled(bool isEnabled)
+  {
+    m_isSidecarIngestionThreadEnabled = isEnabled;
+  }
+
+  bool
+  isSidecarIngestionThreadEnabled() const
+  {
+    return m_isSidecarIngestionThreadEnabled;
+  }
+
   // Service Function prefix methods
   void
   addServiceFunctionPrefix(const ndn::Name& prefix)
@@ -597,6 +1068,24 @@ public:
     return ndn::Name();  // Empty Name if not configured (requires explicit configuration)
   }
 
+  /*! \brief Add the source of the records of a hosted Service Function.
+
+    Without any source, the records of sidecar-log-path are advertised for
+    getServiceFunctionPrefix().
+    \sa SidecarStatsHandler
+   */
+  void
+  addServiceFunctionSource(const ServiceFunctionSource& source)
+  {
+    m_serviceFunctionSources.push_back(source);
+  }
+
+  const std::vector<ServiceFunctionSource>&
+  getServiceFunctionSources() const
+  {
+    return m_serviceFunctionSources;
+  }
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   std::string m_confFileName;
   std::string m_confFileNameDynamic;
@@ -635,6 +1124,10 @@ private:
   uint32_t m_maxFacesPerPrefix;
 
   std::string m_stateFileDir;
+  uint32_t m_lsdbSnapshotInterval;
+  bool m_isLsdbBootstrapEnabled = false;
+  bool m_isLsaMultipathFetchEnabled = false;
+  bool m_isLsaWireStorageEnabled = false;
 
   ndn::time::milliseconds m_syncInterestLifetime;
 
@@ -656,12 +1149,44 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   double m_processingWeight = 0.4;  // デフォルト値
   double m_loadWeight = 0.4;        // デフォルト値
   double m_usageWeight = 0.2;       // デフォルト値
+  double m_latencyWeight = 0.0;
+  double m_advertisementSmoothing = 0.5;
+  double m_advertisementAbsoluteThreshold = 0.05;
+  double m_advertisementRelativeThreshold = 0.2;
+  ndn::time::seconds m_advertisementMinInterval = 5_s;
+  ndn::time::seconds m_advertisementMaxInterval = 60_s;
   bool m_dynamicWeightingEnabled = false;  // 動的重み付けの有効/無効
+  double m_dynamicWeightingForgetting = 0.98;
+  double m_dynamicWeightingMinWeight = 0.0;
+  double m_dynamicWeightingMaxWeight = 1.0;
+  double m_dynamicWeightingMaxStep = 0.05;
   std::set<ndn::Name> m_serviceFunctionPrefixes;  // 複数のファンクションプレフィックスに対応
+  std::vector<ServiceFunctionSource> m_serviceFunctionSources;
   uint32_t m_utilizationWindowSeconds = 1;  // 利用率計算の時間窓（秒）、デフォルト: 1秒
+  uint32_t m_workerCapacity = 0;
+  uint32_t m_maxConcurrency = 0;
+  double m_overloadClearRatio = 0.8;
+  ndn::time::seconds m_overloadHoldTime = 5_s;
+  FunctionCostModelType m_defaultFunctionCostModel = FunctionCostModelType::LINEAR;
+  std::map<ndn::Name, FunctionCostModelType> m_functionCostModels;
+  double m_queueingCostPerSecond = 1000.0;
+  ndn::time::seconds m_forecastHorizon = 10_s;
+  ndn::time::seconds m_probeInterval = 0_s;
+  size_t m_probeMaxFaces = 4;
+  double m_probeCostPerSecond = 1000.0;
+  double m_probeFailureCost = 100.0;
+  std::map<std::string, std::vector<ndn::Name>> m_serviceFunctionChains;
+  bool m_isLoadBalancingEnabled = false;
+  bool m_isSitePreferenceEnabled = false;
+  double m_siteHeadroomThreshold = 0.2;
+  ndn::Name m_loadBalancingStrategy{"/localhost/nfd/strategy/weighted-load-balancer/v=1"};
   
   // Sidecar log path
   std::string m_sidecarLogPath = "/var/log/sidecar/service.log";  // デフォルト値
+  ndn::time::milliseconds m_sidecarMinUpdateInterval{SIDECAR_MIN_UPDATE_INTERVAL_DEFAULT};
+  std::string m_sidecarShmName;
+  SidecarTimeZone m_sidecarLogTimeZone = SidecarTimeZone::LOCAL;
+  bool m_isSidecarIngestionThreadEnabled = false;
 };
 
 } // namespace nlsr
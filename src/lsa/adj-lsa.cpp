@@ -20,10 +20,13 @@
  */
 
 #include "adj-lsa.hpp"
+#include "logger.hpp"
 #include "tlv-nlsr.hpp"
 
 namespace nlsr {
 
+INIT_LOGGER(lsa.AdjLsa);
+
 AdjLsa::AdjLsa(const ndn::Name& originRouter, uint64_t seqNo,
                const ndn::time::system_clock::time_point& timepoint, AdjacencyList& adl)
   : Lsa(originRouter, seqNo, timepoint)
@@ -44,6 +47,7 @@ template<ndn::encoding::Tag TAG>
 size_t
 AdjLsa::wireEncode(ndn::EncodingImpl<TAG>& block) const
 {
+  ensureDecoded();
   size_t totalLength = 0;
 
   auto list = m_adl.getAdjList();
@@ -100,21 +104,64 @@ AdjLsa::wireDecode(const ndn::Block& wire)
     NDN_THROW(Error("Missing required Lsa field"));
   }
 
-  AdjacencyList adl;
+  // the adjacencies are decoded on first access; only their types are checked here
   for (; val != m_wire.elements_end(); ++val) {
-    if (val->type() == nlsr::tlv::Adjacency) {
-      adl.insert(Adjacent(*val));
-    }
-    else {
+    if (val->type() != nlsr::tlv::Adjacency) {
       NDN_THROW(Error("Adjacency", val->type()));
     }
   }
-  m_adl = adl;
+
+  m_contentWire = m_wire;
+  m_adl.reset();
+  m_isContentDecoded = false;
+}
+
+void
+AdjLsa::decodeContent() const
+{
+  if (m_isContentDecoded) {
+    return;
+  }
+
+  // skip the Lsa element, which wireDecode has already decoded
+  AdjacencyList adl;
+  for (auto val = std::next(m_contentWire.elements_begin());
+       val != m_contentWire.elements_end(); ++val) {
+    adl.insert(Adjacent(*val));
+  }
+  m_adl = std::move(adl);
+  m_isContentDecoded = true;
+}
+
+void
+AdjLsa::decodeContentOrClear() const
+{
+  try {
+    decodeContent();
+  }
+  catch (const ndn::tlv::Error& e) {
+    NLSR_LOG_WARN("Ignoring malformed content of AdjLsa from " << m_originRouter
+                  << ": " << e.what());
+    m_adl.reset();
+    m_isContentDecoded = true;
+  }
+}
+
+void
+AdjLsa::releaseContent()
+{
+  if (!m_isContentDecoded || !m_contentWire.hasWire()) {
+    return;
+  }
+
+  m_adl.reset();
+  m_isContentDecoded = false;
 }
 
 void
 AdjLsa::print(std::ostream& os) const
 {
+  ensureDecoded();
   os << "      Adjacent(s):\n";
 
   int adjacencyIndex = 0;
@@ -135,6 +182,8 @@ AdjLsa::update(const std::shared_ptr<Lsa>& lsa)
     for (const auto& adjacent : alsa->getAdl()) {
       addAdjacent(adjacent);
     }
+    // the adjacencies are now those of the received LSA, so its wire can back them
+    m_contentWire = alsa->m_contentWire;
     return {true, std::list<PrefixInfo>{}, std::list<PrefixInfo>{}};
   }
   return {false, std::list<PrefixInfo>{}, std::list<PrefixInfo>{}};
@@ -68,6 +68,7 @@ public:
   const AdjacencyList&
   getAdl() const
   {
+    ensureDecoded();
     return m_adl;
   }
 
@@ -75,25 +76,31 @@ public:
   resetAdl()
   {
     m_wire.reset();
+    m_contentWire.reset();
     m_adl.reset();
+    m_isContentDecoded = true;
   }
 
   void
   addAdjacent(const Adjacent& adj)
   {
+    ensureDecoded();
     m_wire.reset();
+    m_contentWire.reset();
     m_adl.insert(adj);
   }
 
   const_iterator
   begin() const
   {
+    ensureDecoded();
     return m_adl.begin();
   }
 
   const_iterator
   end() const
   {
+    ensureDecoded();
     return m_adl.end();
   }
 
@@ -104,13 +111,34 @@ public:
   const ndn::Block&
   wireEncode() const override;
 
+  /*! \brief Decodes the common Lsa fields of \p wire.
+
+    The adjacencies are decoded from the same buffer on first access.
+   */
   void
   wireDecode(const ndn::Block& wire);
 
+  void
+  decodeContent() const override;
+
+  void
+  releaseContent() override;
+
   std::tuple<bool, std::list<PrefixInfo>, std::list<PrefixInfo>>
   update(const std::shared_ptr<Lsa>& lsa) override;
 
 private:
+  void
+  ensureDecoded() const
+  {
+    if (!m_isContentDecoded) {
+      decodeContentOrClear();
+    }
+  }
+
+  void
+  decodeContentOrClear() const;
+
   void
   print(std::ostream& os) const override;
 
@@ -122,11 +150,16 @@ private: // non-member operators
   friend bool
   operator==(const AdjLsa& lhs, const AdjLsa& rhs)
   {
+    lhs.ensureDecoded();
+    rhs.ensureDecoded();
     return lhs.m_adl == rhs.m_adl;
   }
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
-  AdjacencyList m_adl;
+  mutable AdjacencyList m_adl;
+  mutable bool m_isContentDecoded = true;
+  /// received wire that m_adl is decoded from, while unmodified
+  ndn::Block m_contentWire;
 };
 
 NDN_CXX_DECLARE_WIRE_ENCODE_INSTANTIATIONS(AdjLsa);
@@ -65,6 +65,7 @@ void
 Lsa::wireDecode(const ndn::Block& wire)
 {
   m_originRouter.clear();
+  m_originRouterId.reset();
   m_seqNo = 0;
 
   ndn::Block baseWire = wire;
@@ -24,6 +24,7 @@
 
 #include "common.hpp"
 #include "name-prefix-list.hpp"
+#include "router-name-interner.hpp"
 #include "test-access-control.hpp"
 
 #include <ndn-cxx/util/scheduler.hpp>
@@ -95,6 +96,17 @@ public:
     return m_originRouter;
   }
 
+  /*! \brief Returns the id of the origin router in the global RouterNameInterner.
+   */
+  RouterId
+  getOriginRouterId() const
+  {
+    if (!m_originRouterId) {
+      m_originRouterId = RouterNameInterner::getGlobal().intern(m_originRouter);
+    }
+    return *m_originRouterId;
+  }
+
   const ndn::time::system_clock::time_point&
   getExpirationTimePoint() const
   {
@@ -120,6 +132,26 @@ public:
   virtual const ndn::Block&
   wireEncode() const = 0;
 
+  /*! \brief Decodes the fields that wireDecode left in the received wire.
+
+    Only the common Lsa fields are decoded on receipt; the rest is decoded on first
+    access. Calling this surfaces a malformed LSA immediately instead.
+    \throw ndn::tlv::Error the wire is malformed
+   */
+  virtual void
+  decodeContent() const
+  {
+  }
+
+  /*! \brief Drops decoded fields that can be decoded again from the received wire.
+
+    Has no effect on an LSA built locally or modified since it was decoded.
+   */
+  virtual void
+  releaseContent()
+  {
+  }
+
 protected:
   template<ndn::encoding::Tag TAG>
   size_t
@@ -142,6 +174,7 @@ PUBLIC_WITH_TESTS_ELSE_PROTECTED:
   ndn::scheduler::ScopedEventId m_expiringEventId;
 
   mutable ndn::Block m_wire;
+  mutable std::optional<RouterId> m_originRouterId;
 };
 
 NDN_CXX_DECLARE_WIRE_ENCODE_INSTANTIATIONS(Lsa);
@@ -28,6 +28,7 @@
 #include <ndn-cxx/util/span.hpp>
 #include <vector>
 #include <algorithm>
+#include <limits>
 
 namespace nlsr {
 
@@ -73,13 +74,16 @@ NameLsa::NameLsa(const ndn::Block& block)
 void
 NameLsa::setServiceFunctionInfo(const ndn::Name& name, const ServiceFunctionInfo& info)
 {
+  ensureDecoded();
   m_wire.reset();  // 既存のワイヤーエンコーディングを無効化
+  m_contentWire.reset();
   m_serviceFunctionInfo[name] = info;
 }
 
 ServiceFunctionInfo
 NameLsa::getServiceFunctionInfo(const ndn::Name& name) const
 {
+  ensureDecoded();
   NLSR_LOG_DEBUG("getServiceFunctionInfo called: name=" << name);
   NLSR_LOG_DEBUG("m_serviceFunctionInfo map size: " << m_serviceFunctionInfo.size());
   
@@ -110,6 +114,7 @@ template<ndn::encoding::Tag TAG>
 size_t
 NameLsa::wireEncode(ndn::EncodingImpl<TAG>& block) const
 {
+  ensureDecoded();
   size_t totalLength = 0;
 
   // エンコードService Function情報
@@ -125,13 +130,44 @@ NameLsa::wireEncode(ndn::EncodingImpl<TAG>& block) const
     size_t sfInfoLength = 0;
     
     // Service Function情報をエンコード（weight情報を含む）
+    // The latency quantiles, the queueing model inputs, the forecast and the overload state
+    // are optional and only encoded when known
+    if (info.isOverloaded) {
+      sfInfoLength += ndn::encoding::prependNonNegativeIntegerBlock(block, nlsr::tlv::Overloaded, 1);
+    }
+    if (info.maxConcurrency > 0) {
+      sfInfoLength += ndn::encoding::prependNonNegativeIntegerBlock(block, nlsr::tlv::MaxConcurrency,
+                                                                    info.maxConcurrency);
+    }
+    if (info.utilizationTrend != 0.0) {
+      sfInfoLength += nlsrPrependDoubleBlock(block, nlsr::tlv::UtilizationTrend, info.utilizationTrend);
+    }
+    if (info.lastUpdateTime > ndn::time::system_clock::time_point{}) {
+      sfInfoLength += ndn::encoding::prependNonNegativeIntegerBlock(block, nlsr::tlv::LastUpdateTime,
+        ndn::time::toUnixTimestamp(info.lastUpdateTime).count());
+    }
+    if (info.meanServiceTime > 0) {
+      sfInfoLength += ndn::encoding::prependNonNegativeIntegerBlock(block, nlsr::tlv::MeanServiceTime,
+                                                                    info.meanServiceTime);
+      sfInfoLength += ndn::encoding::prependNonNegativeIntegerBlock(block, nlsr::tlv::WorkerCapacity,
+                                                                    info.workerCapacity);
+    }
+    if (info.latencyP99 > 0) {
+      sfInfoLength += nlsrPrependDoubleBlock(block, nlsr::tlv::LatencyWeight, info.latencyWeight);
+      sfInfoLength += ndn::encoding::prependNonNegativeIntegerBlock(block, nlsr::tlv::ServiceLatencyP99,
+                                                                    info.latencyP99);
+      sfInfoLength += ndn::encoding::prependNonNegativeIntegerBlock(block, nlsr::tlv::ServiceLatencyP95,
+                                                                    info.latencyP95);
+      sfInfoLength += ndn::encoding::prependNonNegativeIntegerBlock(block, nlsr::tlv::ServiceLatencyP50,
+                                                                    info.latencyP50);
+    }
     sfInfoLength += nlsrPrependDoubleBlock(block, nlsr::tlv::UsageWeight, info.usageWeight);
     sfInfoLength += nlsrPrependDoubleBlock(block, nlsr::tlv::LoadWeight, info.loadWeight);
     sfInfoLength += nlsrPrependDoubleBlock(block, nlsr::tlv::ProcessingWeight, info.processingWeight);
     sfInfoLength += nlsrPrependDoubleBlock(block, nlsr::tlv::Utilization, info.utilization);
     sfInfoLength += nlsrPrependDoubleBlock(block, nlsr::tlv::Load, info.load);
-    sfInfoLength += block.prependVarNumber(info.usageCount);
-    sfInfoLength += block.prependVarNumber(nlsr::tlv::UsageCount);
+    sfInfoLength += ndn::encoding::prependNonNegativeIntegerBlock(block, nlsr::tlv::UsageCount,
+                                                                  info.usageCount);
     
     // 名前をエンコード
     sfInfoLength += name.wireEncode(block);
@@ -193,25 +229,42 @@ NameLsa::wireDecode(const ndn::Block& wire)
 
   if (val != m_wire.elements_end() && val->type() == nlsr::tlv::Lsa) {
     Lsa::wireDecode(*val);
-    ++val;
   }
   else {
     NDN_THROW(Error("Missing required Lsa field"));
   }
 
+  // the remaining elements are decoded on first access, sharing the buffer of the wire
+  m_contentWire = m_wire;
+  m_receiveTime = ndn::time::system_clock::now();
+  m_npl.clear();
+  m_serviceFunctionInfo.clear();
+  m_isContentDecoded = false;
+}
+
+void
+NameLsa::decodeContent() const
+{
+  if (m_isContentDecoded) {
+    return;
+  }
+
+  // skip the Lsa element, which wireDecode has already decoded
+  auto val = std::next(m_contentWire.elements_begin());
+
   NamePrefixList npl;
-  m_serviceFunctionInfo.clear();  // Clear existing Service Function info
+  std::map<ndn::Name, ServiceFunctionInfo> serviceFunctionInfo;
   
-  NLSR_LOG_DEBUG("wireDecode: Starting decode, will look for Service Function TLV elements");
+  NLSR_LOG_DEBUG("decodeContent: Starting decode, will look for Service Function TLV elements");
   int serviceFunctionCount = 0;
   
-  for (; val != m_wire.elements_end(); ++val) {
+  for (; val != m_contentWire.elements_end(); ++val) {
     if (val->type() == nlsr::tlv::PrefixInfo) {
       npl.insert(PrefixInfo(*val));
     }
     else if (val->type() == nlsr::tlv::ServiceFunction) {
       // Decode Service Function information
-      NLSR_LOG_DEBUG("wireDecode: Found ServiceFunction TLV element #" << (serviceFunctionCount + 1));
+      NLSR_LOG_DEBUG("decodeContent: Found ServiceFunction TLV element #" << (serviceFunctionCount + 1));
       val->parse();
       
       ndn::Name serviceName;
@@ -221,7 +274,7 @@ NameLsa::wireDecode(const ndn::Block& wire)
       sfInfo.utilization = 0.0;
       sfInfo.load = 0.0;
       sfInfo.usageCount = 0;
-      sfInfo.lastUpdateTime = ndn::time::system_clock::now();
+      sfInfo.lastUpdateTime = m_receiveTime;
       sfInfo.processingWeight = 0.4;  // Default weight
       sfInfo.loadWeight = 0.4;         // Default weight
       sfInfo.usageWeight = 0.2;        // Default weight
@@ -234,23 +287,23 @@ NameLsa::wireDecode(const ndn::Block& wire)
         elements.push_back(*sfVal);
       }
       
-      NLSR_LOG_DEBUG("wireDecode: ServiceFunction TLV has " << elements.size() << " sub-elements");
+      NLSR_LOG_DEBUG("decodeContent: ServiceFunction TLV has " << elements.size() << " sub-elements");
       
       // Process elements in reverse order (to match encoding order)
       for (auto it = elements.rbegin(); it != elements.rend(); ++it) {
         if (it->type() == ndn::tlv::Name) {
           // Service function name
           serviceName.wireDecode(*it);
-          NLSR_LOG_DEBUG("wireDecode: Decoded Service Function name: " << serviceName);
+          NLSR_LOG_DEBUG("decodeContent: Decoded Service Function name: " << serviceName);
         }
         else if (it->type() == nlsr::tlv::Utilization) {
           // Utilization (double) - 8 bytes (旧ProcessingTime、後方互換性のため番号は変更なし)
           if (it->value_size() == sizeof(double)) {
             std::memcpy(&sfInfo.utilization, it->value(), sizeof(double));
-            NLSR_LOG_DEBUG("wireDecode: Decoded Utilization: " << sfInfo.utilization 
+            NLSR_LOG_DEBUG("decodeContent: Decoded Utilization: " << sfInfo.utilization 
                           << " (value_size=" << it->value_size() << ")");
           } else {
-            NLSR_LOG_WARN("wireDecode: Utilization value_size mismatch: expected " 
+            NLSR_LOG_WARN("decodeContent: Utilization value_size mismatch: expected " 
                          << sizeof(double) << ", got " << it->value_size());
           }
         }
@@ -258,7 +311,7 @@ NameLsa::wireDecode(const ndn::Block& wire)
           // 後方互換性: 旧ProcessingTime TLVタイプ（番号148、現在はUtilization）もサポート
           if (it->value_size() == sizeof(double)) {
             std::memcpy(&sfInfo.utilization, it->value(), sizeof(double));
-            NLSR_LOG_DEBUG("wireDecode: Decoded Utilization (from old ProcessingTime TLV type 148): " << sfInfo.utilization 
+            NLSR_LOG_DEBUG("decodeContent: Decoded Utilization (from old ProcessingTime TLV type 148): " << sfInfo.utilization 
                           << " (value_size=" << it->value_size() << ")");
           }
         }
@@ -266,39 +319,32 @@ NameLsa::wireDecode(const ndn::Block& wire)
           // Load (double) - 8 bytes
           if (it->value_size() == sizeof(double)) {
             std::memcpy(&sfInfo.load, it->value(), sizeof(double));
-            NLSR_LOG_DEBUG("wireDecode: Decoded Load: " << sfInfo.load 
+            NLSR_LOG_DEBUG("decodeContent: Decoded Load: " << sfInfo.load 
                           << " (value_size=" << it->value_size() << ")");
           } else {
-            NLSR_LOG_WARN("wireDecode: Load value_size mismatch: expected " 
+            NLSR_LOG_WARN("decodeContent: Load value_size mismatch: expected " 
                          << sizeof(double) << ", got " << it->value_size());
           }
         }
         else if (it->type() == nlsr::tlv::UsageCount) {
-          // Usage count - encoded as var number
-          // The value is stored directly in the block's value
-          try {
-            // Read the var number from the block's value
-            auto begin = it->value_begin();
-            auto end = it->value_end();
-            sfInfo.usageCount = static_cast<uint32_t>(ndn::tlv::readVarNumber(begin, end));
-            NLSR_LOG_DEBUG("wireDecode: Decoded UsageCount: " << sfInfo.usageCount);
-          } catch (...) {
-            // If parsing fails, try reading as direct value (fallback)
-            if (it->value_size() <= 4) {
-              uint32_t count = 0;
-              std::memcpy(&count, it->value(), std::min(it->value_size(), sizeof(uint32_t)));
-              sfInfo.usageCount = count;
-              NLSR_LOG_DEBUG("wireDecode: Decoded UsageCount (fallback): " << sfInfo.usageCount);
-            }
+          // Usage count - NonNegativeInteger. Earlier versions wrote the count in place
+          // of the TLV-LENGTH and could only advertise 0, which arrives as an empty value.
+          if (it->value_size() == 0) {
+            sfInfo.usageCount = 0;
           }
+          else {
+            uint64_t count = ndn::encoding::readNonNegativeInteger(*it);
+            sfInfo.usageCount = static_cast<uint32_t>(std::min<uint64_t>(count, std::numeric_limits<uint32_t>::max()));
+          }
+          NLSR_LOG_DEBUG("decodeContent: Decoded UsageCount: " << sfInfo.usageCount);
         }
         else if (it->type() == nlsr::tlv::ProcessingWeight) {
           // Processing weight (double) - 8 bytes
           if (it->value_size() == sizeof(double)) {
             std::memcpy(&sfInfo.processingWeight, it->value(), sizeof(double));
-            NLSR_LOG_DEBUG("wireDecode: Decoded ProcessingWeight: " << sfInfo.processingWeight);
+            NLSR_LOG_DEBUG("decodeContent: Decoded ProcessingWeight: " << sfInfo.processingWeight);
           } else {
-            NLSR_LOG_WARN("wireDecode: ProcessingWeight value_size mismatch: expected " 
+            NLSR_LOG_WARN("decodeContent: ProcessingWeight value_size mismatch: expected " 
                          << sizeof(double) << ", got " << it->value_size());
           }
         }
@@ -306,9 +352,9 @@ NameLsa::wireDecode(const ndn::Block& wire)
           // Load weight (double) - 8 bytes
           if (it->value_size() == sizeof(double)) {
             std::memcpy(&sfInfo.loadWeight, it->value(), sizeof(double));
-            NLSR_LOG_DEBUG("wireDecode: Decoded LoadWeight: " << sfInfo.loadWeight);
+            NLSR_LOG_DEBUG("decodeContent: Decoded LoadWeight: " << sfInfo.loadWeight);
           } else {
-            NLSR_LOG_WARN("wireDecode: LoadWeight value_size mismatch: expected " 
+            NLSR_LOG_WARN("decodeContent: LoadWeight value_size mismatch: expected " 
                          << sizeof(double) << ", got " << it->value_size());
           }
         }
@@ -316,28 +362,83 @@ NameLsa::wireDecode(const ndn::Block& wire)
           // Usage weight (double) - 8 bytes
           if (it->value_size() == sizeof(double)) {
             std::memcpy(&sfInfo.usageWeight, it->value(), sizeof(double));
-            NLSR_LOG_DEBUG("wireDecode: Decoded UsageWeight: " << sfInfo.usageWeight);
+            NLSR_LOG_DEBUG("decodeContent: Decoded UsageWeight: " << sfInfo.usageWeight);
           } else {
-            NLSR_LOG_WARN("wireDecode: UsageWeight value_size mismatch: expected " 
+            NLSR_LOG_WARN("decodeContent: UsageWeight value_size mismatch: expected " 
+                         << sizeof(double) << ", got " << it->value_size());
+          }
+        }
+        else if (it->type() == nlsr::tlv::ServiceLatencyP50 ||
+                 it->type() == nlsr::tlv::ServiceLatencyP95 ||
+                 it->type() == nlsr::tlv::ServiceLatencyP99) {
+          uint64_t value = ndn::encoding::readNonNegativeInteger(*it);
+          auto latency = static_cast<uint32_t>(std::min<uint64_t>(value, std::numeric_limits<uint32_t>::max()));
+          if (it->type() == nlsr::tlv::ServiceLatencyP50) {
+            sfInfo.latencyP50 = latency;
+          }
+          else if (it->type() == nlsr::tlv::ServiceLatencyP95) {
+            sfInfo.latencyP95 = latency;
+          }
+          else {
+            sfInfo.latencyP99 = latency;
+          }
+        }
+        else if (it->type() == nlsr::tlv::WorkerCapacity ||
+                 it->type() == nlsr::tlv::MeanServiceTime) {
+          uint64_t value = ndn::encoding::readNonNegativeInteger(*it);
+          auto clamped = static_cast<uint32_t>(std::min<uint64_t>(value, std::numeric_limits<uint32_t>::max()));
+          if (it->type() == nlsr::tlv::WorkerCapacity) {
+            sfInfo.workerCapacity = clamped;
+          }
+          else {
+            sfInfo.meanServiceTime = clamped;
+          }
+        }
+        else if (it->type() == nlsr::tlv::LastUpdateTime) {
+          // measured by the origin; a clock ahead of ours is capped at the receive time
+          auto lastUpdateTime = ndn::time::fromUnixTimestamp(
+            ndn::time::milliseconds(ndn::encoding::readNonNegativeInteger(*it)));
+          sfInfo.lastUpdateTime = std::min(lastUpdateTime, m_receiveTime);
+        }
+        else if (it->type() == nlsr::tlv::MaxConcurrency) {
+          uint64_t value = ndn::encoding::readNonNegativeInteger(*it);
+          sfInfo.maxConcurrency = static_cast<uint32_t>(std::min<uint64_t>(value, std::numeric_limits<uint32_t>::max()));
+        }
+        else if (it->type() == nlsr::tlv::Overloaded) {
+          sfInfo.isOverloaded = ndn::encoding::readNonNegativeInteger(*it) != 0;
+        }
+        else if (it->type() == nlsr::tlv::UtilizationTrend) {
+          if (it->value_size() == sizeof(double)) {
+            std::memcpy(&sfInfo.utilizationTrend, it->value(), sizeof(double));
+          } else {
+            NLSR_LOG_WARN("decodeContent: UtilizationTrend value_size mismatch: expected "
+                         << sizeof(double) << ", got " << it->value_size());
+          }
+        }
+        else if (it->type() == nlsr::tlv::LatencyWeight) {
+          if (it->value_size() == sizeof(double)) {
+            std::memcpy(&sfInfo.latencyWeight, it->value(), sizeof(double));
+          } else {
+            NLSR_LOG_WARN("decodeContent: LatencyWeight value_size mismatch: expected "
                          << sizeof(double) << ", got " << it->value_size());
           }
         } else {
-          NLSR_LOG_DEBUG("wireDecode: Unknown Service Function sub-element type: " << it->type());
+          NLSR_LOG_DEBUG("decodeContent: Unknown Service Function sub-element type: " << it->type());
         }
       }
       
       // Store Service Function information if we have a valid name
       if (!serviceName.empty()) {
-        m_serviceFunctionInfo[serviceName] = sfInfo;
+        serviceFunctionInfo[serviceName] = sfInfo;
         serviceFunctionCount++;
-        NLSR_LOG_DEBUG("wireDecode: Stored Service Function info: " << serviceName 
+        NLSR_LOG_DEBUG("decodeContent: Stored Service Function info: " << serviceName 
                       << " -> utilization=" << sfInfo.utilization
                       << ", load=" << sfInfo.load << ", usageCount=" << sfInfo.usageCount
                       << ", processingWeight=" << sfInfo.processingWeight
                       << ", loadWeight=" << sfInfo.loadWeight
                       << ", usageWeight=" << sfInfo.usageWeight);
       } else {
-        NLSR_LOG_WARN("wireDecode: Service Function name is empty, skipping");
+        NLSR_LOG_WARN("decodeContent: Service Function name is empty, skipping");
       }
     }
     else {
@@ -345,11 +446,13 @@ NameLsa::wireDecode(const ndn::Block& wire)
       // NDN_THROW(Error("Name", val->type()));
     }
   }
-  m_npl = npl;
+  m_npl = std::move(npl);
+  m_serviceFunctionInfo = std::move(serviceFunctionInfo);
+  m_isContentDecoded = true;
   
-  NLSR_LOG_DEBUG("wireDecode: Completed decode. Service Function info entries: " << m_serviceFunctionInfo.size());
+  NLSR_LOG_DEBUG("decodeContent: Completed decode. Service Function info entries: " << m_serviceFunctionInfo.size());
   for (const auto& [name, info] : m_serviceFunctionInfo) {
-    NLSR_LOG_DEBUG("wireDecode: Final Service Function info: " << name 
+    NLSR_LOG_DEBUG("decodeContent: Final Service Function info: " << name 
                   << " -> utilization=" << info.utilization
                   << ", load=" << info.load << ", usageCount=" << info.usageCount
                   << ", processingWeight=" << info.processingWeight
@@ -358,9 +461,37 @@ NameLsa::wireDecode(const ndn::Block& wire)
   }
 }
 
+void
+NameLsa::decodeContentOrClear() const
+{
+  try {
+    decodeContent();
+  }
+  catch (const ndn::tlv::Error& e) {
+    NLSR_LOG_WARN("Ignoring malformed content of NameLsa from " << m_originRouter
+                  << ": " << e.what());
+    m_npl.clear();
+    m_serviceFunctionInfo.clear();
+    m_isContentDecoded = true;
+  }
+}
+
+void
+NameLsa::releaseContent()
+{
+  if (!m_isContentDecoded || !m_contentWire.hasWire()) {
+    return;
+  }
+
+  m_npl.clear();
+  m_serviceFunctionInfo.clear();
+  m_isContentDecoded = false;
+}
+
 void
 NameLsa::print(std::ostream& os) const
 {
+  ensureDecoded();
   os << "      Names:\n";
   int i = 0;
   for (const auto& name : m_npl.getPrefixInfo()) {
@@ -373,10 +504,13 @@ NameLsa::print(std::ostream& os) const
 std::tuple<bool, std::list<PrefixInfo>, std::list<PrefixInfo>>
 NameLsa::update(const std::shared_ptr<Lsa>& lsa)
 {
-  auto nlsa = std::static_pointer_cast<NameLsa>(lsa);
+  // read the received LSA only through const access: the non-const getNpl() drops its wire
+  const NameLsa& received = static_cast<const NameLsa&>(*lsa);
+  ensureDecoded();
+  received.ensureDecoded();
   bool updated = false;
 
-  std::list<ndn::Name> newNames = nlsa->getNpl().getNames();
+  std::list<ndn::Name> newNames = received.getNpl().getNames();
   std::list<ndn::Name> oldNames = m_npl.getNames();
   std::list<ndn::Name> nameRefToAdd;
   std::list<PrefixInfo> namesToAdd;
@@ -384,8 +518,8 @@ NameLsa::update(const std::shared_ptr<Lsa>& lsa)
   std::set_difference(newNames.begin(), newNames.end(), oldNames.begin(), oldNames.end(),
                       std::inserter(nameRefToAdd, nameRefToAdd.begin()));
   for (const auto& name : nameRefToAdd) {
-    namesToAdd.push_back(nlsa->getNpl().getPrefixInfoForName(name));
-    addName(nlsa->getNpl().getPrefixInfoForName(name));
+    namesToAdd.push_back(received.getNpl().getPrefixInfoForName(name));
+    addName(received.getNpl().getPrefixInfoForName(name));
     updated = true;
   }
 
@@ -401,9 +535,9 @@ NameLsa::update(const std::shared_ptr<Lsa>& lsa)
 
   // Check for Service Function information changes
   NLSR_LOG_DEBUG("NameLsa::update: Existing m_serviceFunctionInfo size: " << m_serviceFunctionInfo.size()
-                << ", New nlsa->m_serviceFunctionInfo size: " << nlsa->m_serviceFunctionInfo.size());
+                << ", New received.m_serviceFunctionInfo size: " << received.m_serviceFunctionInfo.size());
   
-  for (const auto& [serviceName, newSfInfo] : nlsa->m_serviceFunctionInfo) {
+  for (const auto& [serviceName, newSfInfo] : received.m_serviceFunctionInfo) {
     NLSR_LOG_DEBUG("NameLsa::update: Processing Service Function info for " << serviceName.toUri()
                   << ": utilization=" << newSfInfo.utilization
                   << ", processingWeight=" << newSfInfo.processingWeight);
@@ -421,7 +555,17 @@ NameLsa::update(const std::shared_ptr<Lsa>& lsa)
           oldSfInfo.usageCount != newSfInfo.usageCount ||
           oldSfInfo.processingWeight != newSfInfo.processingWeight ||
           oldSfInfo.loadWeight != newSfInfo.loadWeight ||
-          oldSfInfo.usageWeight != newSfInfo.usageWeight) {
+          oldSfInfo.usageWeight != newSfInfo.usageWeight ||
+          oldSfInfo.latencyP50 != newSfInfo.latencyP50 ||
+          oldSfInfo.latencyP95 != newSfInfo.latencyP95 ||
+          oldSfInfo.latencyP99 != newSfInfo.latencyP99 ||
+          oldSfInfo.latencyWeight != newSfInfo.latencyWeight ||
+          oldSfInfo.workerCapacity != newSfInfo.workerCapacity ||
+          oldSfInfo.meanServiceTime != newSfInfo.meanServiceTime ||
+          oldSfInfo.utilizationTrend != newSfInfo.utilizationTrend ||
+          oldSfInfo.maxConcurrency != newSfInfo.maxConcurrency ||
+          oldSfInfo.isOverloaded != newSfInfo.isOverloaded ||
+          oldSfInfo.lastUpdateTime != newSfInfo.lastUpdateTime) {
         m_serviceFunctionInfo[serviceName] = newSfInfo;
         updated = true;
         NLSR_LOG_DEBUG("Service Function info updated for " << serviceName.toUri()
@@ -437,9 +581,9 @@ NameLsa::update(const std::shared_ptr<Lsa>& lsa)
   // Only remove if the new NameLSA explicitly does not contain the Service Function info
   // If the new NameLSA's m_serviceFunctionInfo is empty, we should preserve existing info
   // (This can happen if wireDecode failed to decode Service Function info, but we don't want to lose existing info)
-  if (!nlsa->m_serviceFunctionInfo.empty()) {
+  if (!received.m_serviceFunctionInfo.empty()) {
     for (auto it = m_serviceFunctionInfo.begin(); it != m_serviceFunctionInfo.end();) {
-      if (nlsa->m_serviceFunctionInfo.find(it->first) == nlsa->m_serviceFunctionInfo.end()) {
+      if (received.m_serviceFunctionInfo.find(it->first) == received.m_serviceFunctionInfo.end()) {
         NLSR_LOG_DEBUG("Service Function info removed for " << it->first.toUri());
         it = m_serviceFunctionInfo.erase(it);
         updated = true;
@@ -451,6 +595,20 @@ NameLsa::update(const std::shared_ptr<Lsa>& lsa)
     NLSR_LOG_DEBUG("NameLsa::update: New NameLSA has empty m_serviceFunctionInfo, preserving existing info");
   }
 
+  if (updated) {
+    m_wire.reset();
+    if (received.m_serviceFunctionInfo.empty() && !m_serviceFunctionInfo.empty()) {
+      // the preserved Service Function info is not in the received content
+      m_contentWire.reset();
+    }
+    else {
+      // the content is now that of the received LSA, so its wire can back it
+      m_npl = received.m_npl;
+      m_contentWire = received.m_contentWire;
+      m_receiveTime = received.m_receiveTime;
+    }
+  }
+
   NLSR_LOG_DEBUG("NameLsa::update: Final m_serviceFunctionInfo size: " << m_serviceFunctionInfo.size());
   return {updated, namesToAdd, namesToRemove};
 }
@@ -458,12 +616,14 @@ NameLsa::update(const std::shared_ptr<Lsa>& lsa)
 size_t
 NameLsa::getServiceFunctionInfoMapSize() const
 {
+  ensureDecoded();
   return m_serviceFunctionInfo.size();
 }
 
 const std::map<ndn::Name, ServiceFunctionInfo>&
 NameLsa::getAllServiceFunctionInfo() const
 {
+  ensureDecoded();
   return m_serviceFunctionInfo;
 }
 
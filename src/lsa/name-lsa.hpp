@@ -40,6 +40,20 @@ struct ServiceFunctionInfo {
   double processingWeight;  // utilizationの重み（設定ファイルから取得）
   double loadWeight;        // loadの重み（設定ファイルから取得）
   double usageWeight;       // usageCountの重み（設定ファイルから取得）
+  // quantiles of the service time in microseconds; 0 if not advertised
+  uint32_t latencyP50 = 0;
+  uint32_t latencyP95 = 0;
+  uint32_t latencyP99 = 0;
+  double latencyWeight = 0.0;  // cost per second of latencyP99（設定ファイルから取得）
+  // inputs of the queueing cost model; 0 if not advertised
+  uint32_t workerCapacity = 0;   // requests served in parallel
+  uint32_t meanServiceTime = 0;  // microseconds
+  // change of utilization per second at lastUpdateTime, to extrapolate it by the receivers
+  double utilizationTrend = 0.0;
+  // requests the instance may have in flight; 0 if not advertised
+  uint32_t maxConcurrency = 0;
+  // set by the origin as soon as more than maxConcurrency requests are in flight
+  bool isOverloaded = false;
 };
 
 /**
@@ -79,26 +93,34 @@ public:
   NamePrefixList&
   getNpl()
   {
+    ensureDecoded();
+    // the caller may modify the list
+    m_contentWire.reset();
     return m_npl;
   }
 
   const NamePrefixList&
   getNpl() const
   {
+    ensureDecoded();
     return m_npl;
   }
 
   void
   addName(const PrefixInfo& name)
   {
+    ensureDecoded();
     m_wire.reset();
+    m_contentWire.reset();
     m_npl.insert(name);
   }
 
   void
   removeName(const PrefixInfo& name)
   {
+    ensureDecoded();
     m_wire.reset();
+    m_contentWire.reset();
     m_npl.erase(name.getName());
   }
 
@@ -109,9 +131,20 @@ public:
   const ndn::Block&
   wireEncode() const override;
 
+  /*! \brief Decodes the common Lsa fields of \p wire.
+
+    The name prefixes and Service Function records are decoded from the same buffer on
+    first access.
+   */
   void
   wireDecode(const ndn::Block& wire);
 
+  void
+  decodeContent() const override;
+
+  void
+  releaseContent() override;
+
   std::tuple<bool, std::list<PrefixInfo>, std::list<PrefixInfo>>
   update(const std::shared_ptr<Lsa>& lsa) override;
 
@@ -123,6 +156,17 @@ public:
   const std::map<ndn::Name, ServiceFunctionInfo>& getAllServiceFunctionInfo() const;
 
 private:
+  void
+  ensureDecoded() const
+  {
+    if (!m_isContentDecoded) {
+      decodeContentOrClear();
+    }
+  }
+
+  void
+  decodeContentOrClear() const;
+
   void
   print(std::ostream& os) const override;
 
@@ -134,12 +178,19 @@ private: // non-member operators
   friend bool
   operator==(const NameLsa& lhs, const NameLsa& rhs)
   {
+    lhs.ensureDecoded();
+    rhs.ensureDecoded();
     return lhs.m_npl == rhs.m_npl;
   }
 
-private:
-  NamePrefixList m_npl;
-  std::map<ndn::Name, ServiceFunctionInfo> m_serviceFunctionInfo;
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  mutable NamePrefixList m_npl;
+  mutable std::map<ndn::Name, ServiceFunctionInfo> m_serviceFunctionInfo;
+  mutable bool m_isContentDecoded = true;
+  /// received wire that m_npl and m_serviceFunctionInfo are decoded from, while unmodified
+  ndn::Block m_contentWire;
+  /// lastUpdateTime of decoded Service Function records
+  ndn::time::system_clock::time_point m_receiveTime;
 };
 
 NDN_CXX_DECLARE_WIRE_ENCODE_INSTANTIATIONS(NameLsa);
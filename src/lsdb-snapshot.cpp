@@ -0,0 +1,257 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "lsdb-snapshot.hpp"
+#include "logger.hpp"
+
+#include <boost/noncopyable.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace nlsr {
+
+INIT_LOGGER(LsdbSnapshot);
+
+namespace {
+
+constexpr size_t RECORD_ALIGNMENT = 8;
+
+size_t
+alignUp(size_t size)
+{
+  return (size + RECORD_ALIGNMENT - 1) & ~(RECORD_ALIGNMENT - 1);
+}
+
+template<typename T>
+void
+appendPod(std::vector<uint8_t>& buffer, const T& value)
+{
+  auto bytes = reinterpret_cast<const uint8_t*>(&value);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+/*! \brief Writes \p buffer to a new file at \p path and flushes it to stable storage.
+ */
+void
+writeFileSynced(const std::string& path, const std::vector<uint8_t>& buffer)
+{
+  int fd = ::open(path.data(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    NDN_THROW(LsdbSnapshot::Error("Cannot open " + path + ": " + std::strerror(errno)));
+  }
+
+  size_t offset = 0;
+  while (offset < buffer.size()) {
+    ssize_t nWritten = ::write(fd, buffer.data() + offset, buffer.size() - offset);
+    if (nWritten < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      int error = errno;
+      ::close(fd);
+      NDN_THROW(LsdbSnapshot::Error("Cannot write LSDB snapshot to " + path + ": " +
+                                    std::strerror(error)));
+    }
+    offset += static_cast<size_t>(nWritten);
+  }
+
+  // without this, a crash after the rename may leave a truncated snapshot behind
+  if (::fsync(fd) != 0) {
+    int error = errno;
+    ::close(fd);
+    NDN_THROW(LsdbSnapshot::Error("Cannot sync LSDB snapshot " + path + ": " + std::strerror(error)));
+  }
+  if (::close(fd) != 0) {
+    NDN_THROW(LsdbSnapshot::Error("Cannot write LSDB snapshot to " + path + ": " +
+                                  std::strerror(errno)));
+  }
+}
+
+/*! \brief Read-only memory mapping of a whole file, released on destruction.
+ */
+class MappedFile : boost::noncopyable
+{
+public:
+  explicit
+  MappedFile(int fd, size_t size)
+    : m_size(size)
+  {
+    m_data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (m_data == MAP_FAILED) {
+      NDN_THROW(LsdbSnapshot::Error("mmap failed: " + std::string(std::strerror(errno))));
+    }
+  }
+
+  ~MappedFile()
+  {
+    ::munmap(m_data, m_size);
+  }
+
+  const uint8_t*
+  data() const
+  {
+    return static_cast<const uint8_t*>(m_data);
+  }
+
+private:
+  void* m_data;
+  size_t m_size;
+};
+
+} // namespace
+
+LsdbSnapshot::LsdbSnapshot(const std::string& stateDir)
+{
+  if (!stateDir.empty()) {
+    m_filePath = stateDir + "/nlsrLsdb.snapshot";
+  }
+}
+
+void
+LsdbSnapshot::write(const std::vector<std::shared_ptr<Lsa>>& lsas) const
+{
+  if (!isEnabled()) {
+    return;
+  }
+
+  std::vector<uint8_t> buffer;
+  FileHeader header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = FORMAT_VERSION;
+  header.nRecords = static_cast<uint32_t>(lsas.size());
+  appendPod(buffer, header);
+
+  for (const auto& lsa : lsas) {
+    const auto& wire = lsa->wireEncode();
+    RecordHeader record{};
+    record.expirationMs = ndn::time::toUnixTimestamp(lsa->getExpirationTimePoint()).count();
+    record.wireSize = static_cast<uint32_t>(wire.size());
+    appendPod(buffer, record);
+    buffer.insert(buffer.end(), wire.begin(), wire.end());
+    buffer.resize(alignUp(buffer.size()), 0);
+  }
+
+  std::string tempPath = m_filePath + ".tmp";
+  writeFileSynced(tempPath, buffer);
+  std::filesystem::rename(tempPath, m_filePath);
+
+  // persist the rename as well
+  auto stateDir = std::filesystem::path(m_filePath).parent_path();
+  int dirFd = ::open(stateDir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (dirFd < 0 || ::fsync(dirFd) != 0) {
+    NLSR_LOG_WARN("Cannot sync state directory " << stateDir << ": " << std::strerror(errno));
+  }
+  if (dirFd >= 0) {
+    ::close(dirFd);
+  }
+
+  NLSR_LOG_DEBUG("Wrote " << lsas.size() << " LSAs (" << buffer.size() << " bytes) to "
+                 << m_filePath);
+}
+
+std::vector<LsdbSnapshot::Record>
+LsdbSnapshot::load(const ndn::time::system_clock::time_point& now) const
+{
+  std::vector<Record> records;
+  if (!isEnabled()) {
+    return records;
+  }
+
+  int fd = ::open(m_filePath.data(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    if (errno != ENOENT) {
+      NLSR_LOG_WARN("Cannot open LSDB snapshot " << m_filePath << ": " << std::strerror(errno));
+    }
+    return records;
+  }
+
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(FileHeader)) {
+    ::close(fd);
+    NDN_THROW(Error("LSDB snapshot " + m_filePath + " is truncated"));
+  }
+
+  size_t fileSize = static_cast<size_t>(st.st_size);
+  std::unique_ptr<MappedFile> mapped;
+  try {
+    mapped = std::make_unique<MappedFile>(fd, fileSize);
+  }
+  catch (const Error&) {
+    ::close(fd);
+    throw;
+  }
+  // the mapping stays valid after the descriptor is closed
+  ::close(fd);
+
+  const uint8_t* base = mapped->data();
+  FileHeader header;
+  std::memcpy(&header, base, sizeof(header));
+  if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != FORMAT_VERSION) {
+    NDN_THROW(Error("LSDB snapshot " + m_filePath + " has an unsupported format"));
+  }
+
+  size_t offset = sizeof(FileHeader);
+  uint32_t nExpired = 0;
+  for (uint32_t i = 0; i < header.nRecords; ++i) {
+    if (offset + sizeof(RecordHeader) > fileSize) {
+      NDN_THROW(Error("LSDB snapshot " + m_filePath + " is truncated"));
+    }
+    RecordHeader record;
+    std::memcpy(&record, base + offset, sizeof(record));
+    offset += sizeof(RecordHeader);
+
+    if (offset + record.wireSize > fileSize) {
+      NDN_THROW(Error("LSDB snapshot " + m_filePath + " is truncated"));
+    }
+
+    auto expirationTimePoint = ndn::time::fromUnixTimestamp(ndn::time::milliseconds(record.expirationMs));
+    if (expirationTimePoint > now) {
+      try {
+        // copies the wire out of the mapping, so records outlive the mapping
+        ndn::Block wire(ndn::make_span(base + offset, record.wireSize));
+        if (wire.size() != record.wireSize) {
+          NDN_THROW(Error("LSDB snapshot record " + std::to_string(i) + " has trailing bytes"));
+        }
+        records.push_back({expirationTimePoint, std::move(wire)});
+      }
+      catch (const ndn::tlv::Error&) {
+        NDN_THROW_NESTED(Error("LSDB snapshot record " + std::to_string(i) + " is malformed"));
+      }
+    }
+    else {
+      ++nExpired;
+    }
+    offset = alignUp(offset + record.wireSize);
+  }
+
+  NLSR_LOG_DEBUG("Loaded " << records.size() << " LSAs from " << m_filePath
+                 << " (" << nExpired << " expired)");
+  return records;
+}
+
+} // namespace nlsr
@@ -0,0 +1,127 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_LSDB_SNAPSHOT_HPP
+#define NLSR_LSDB_SNAPSHOT_HPP
+
+#include "lsa/lsa.hpp"
+#include "test-access-control.hpp"
+
+#include <ndn-cxx/encoding/block.hpp>
+#include <ndn-cxx/util/time.hpp>
+
+#include <string>
+#include <vector>
+
+namespace nlsr {
+
+/*! \brief Persists installed LSAs so that a restarted router can warm up its LSDB.
+
+  The snapshot is a flat binary file stored in the state directory, next to
+  nlsrSeqNo.txt. It consists of a fixed-size header followed by 8-byte aligned
+  records, each one carrying the expiration time point of an LSA and its TLV wire
+  encoding, so that the file can be memory-mapped and walked without parsing.
+  Integers are stored in host byte order: the file is local state and is not meant
+  to be moved between machines.
+
+  A snapshot is only a hint. Loaded LSAs keep their original sequence numbers
+  and expiration time points, and sync replaces them as soon as fresher
+  versions are announced.
+ */
+class LsdbSnapshot
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  struct Record
+  {
+    ndn::time::system_clock::time_point expirationTimePoint;
+    ndn::Block wire;
+  };
+
+  /*! \param stateDir The directory holding NLSR state files. If empty,
+             snapshots are disabled and all operations are no-ops.
+   */
+  explicit
+  LsdbSnapshot(const std::string& stateDir);
+
+  bool
+  isEnabled() const
+  {
+    return !m_filePath.empty();
+  }
+
+  const std::string&
+  getFilePath() const
+  {
+    return m_filePath;
+  }
+
+  /*! \brief Atomically replace the snapshot file with the given LSAs.
+
+    The new file is synced to disk before it replaces the old one, so a crash leaves
+    either snapshot complete.
+    \throw Error the snapshot file cannot be written
+   */
+  void
+  write(const std::vector<std::shared_ptr<Lsa>>& lsas) const;
+
+  /*! \brief Map the snapshot file and return the records that are still valid at \p now.
+
+    A missing file yields an empty result. A truncated or otherwise malformed
+    file is rejected as a whole.
+    \throw Error the snapshot file exists but is malformed
+   */
+  std::vector<Record>
+  load(const ndn::time::system_clock::time_point& now = ndn::time::system_clock::now()) const;
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  static constexpr char MAGIC[8] = {'N', 'L', 'S', 'R', 'L', 'S', 'D', 'B'};
+  static constexpr uint32_t FORMAT_VERSION = 1;
+
+  struct FileHeader
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t nRecords;
+  };
+
+  struct RecordHeader
+  {
+    int64_t expirationMs;
+    uint32_t wireSize;
+    uint32_t reserved;
+  };
+
+  static_assert(sizeof(FileHeader) == 16, "unexpected padding in FileHeader");
+  static_assert(sizeof(RecordHeader) == 16, "unexpected padding in RecordHeader");
+
+private:
+  std::string m_filePath;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_LSDB_SNAPSHOT_HPP
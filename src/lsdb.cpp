@@ -23,9 +23,11 @@
 
 #include "logger.hpp"
 #include "nlsr.hpp"
+#include "tlv-nlsr.hpp"
 #include "utility/name-helper.hpp"
 
 #include <ndn-cxx/lp/tags.hpp>
+#include <ndn-cxx/security/validator-null.hpp>
 
 namespace nlsr {
 
@@ -51,6 +53,7 @@ Lsdb::Lsdb(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
   , m_adjLsaBuildInterval(m_confParam.getAdjLsaBuildInterval())
   , m_thisRouterPrefix(m_confParam.getRouterPrefix())
   , m_sequencingManager(m_confParam.getStateFileDir(), m_confParam.getHyperbolicState())
+  , m_snapshot(m_confParam.getStateFileDir())
   , m_onNewLsaConnection(m_sync.onNewLsa.connect(
       [this] (const ndn::Name& updateName, uint64_t sequenceNumber,
               const ndn::Name& originRouter, uint64_t incomingFaceId) {
@@ -75,11 +78,25 @@ Lsdb::Lsdb(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
     },
     m_confParam.getSigningInfo(), ndn::nfd::ROUTE_FLAG_CAPTURE);
 
+  m_lsdbDatasetPrefix = m_confParam.getLsaPrefix().getPrefix(-1).append("LSDB");
+  NLSR_LOG_DEBUG("Setting interest filter for LSDB dataset: " << m_lsdbDatasetPrefix);
+
+  m_face.setInterestFilter(ndn::InterestFilter(m_lsdbDatasetPrefix).allowLoopback(false),
+    [this] (const auto&, const auto& interest) { processLsdbInterest(interest); },
+    [] (const auto& name) { NLSR_LOG_DEBUG("Successfully registered prefix: " << name); },
+    [] (const auto& name, const auto& reason) {
+      // neighbors fall back to per-LSA fetching, so this is not fatal
+      NLSR_LOG_ERROR("Failed to register prefix " << name << ": " << reason);
+    },
+    m_confParam.getSigningInfo(), ndn::nfd::ROUTE_FLAG_CAPTURE);
+
   buildAndInstallOwnNameLsa();
   // Install coordinate LSAs if using HR or dry-run HR.
   if (m_confParam.getHyperbolicState() != HYPERBOLIC_STATE_OFF) {
     buildAndInstallOwnCoordinateLsa();
   }
+
+  scheduleSnapshotWrite();
 }
 
 Lsdb::~Lsdb()
@@ -87,6 +104,16 @@ Lsdb::~Lsdb()
   for (const auto& fetcher : m_fetchers) {
     fetcher->stop();
   }
+  for (const auto& [name, fetcher] : m_multipathFetchers) {
+    fetcher->stop();
+  }
+  if (m_lsdbFetcher) {
+    m_lsdbFetcher->stop();
+  }
+
+  if (m_confParam.getLsdbSnapshotInterval() > 0) {
+    writeSnapshot();
+  }
 }
 
 void
@@ -193,6 +220,92 @@ Lsdb::writeLog() const
   }
 }
 
+void
+Lsdb::loadSnapshot()
+{
+  std::vector<LsdbSnapshot::Record> records;
+  try {
+    records = m_snapshot.load();
+  }
+  catch (const std::exception& e) {
+    NLSR_LOG_WARN("Ignoring LSDB snapshot: " << e.what());
+    return;
+  }
+
+  size_t nInstalled = 0;
+  for (const auto& record : records) {
+    try {
+      std::shared_ptr<Lsa> lsa;
+      switch (record.wire.type()) {
+        case nlsr::tlv::NameLsa:
+          lsa = std::make_shared<NameLsa>(record.wire);
+          break;
+        case nlsr::tlv::AdjacencyLsa:
+          lsa = std::make_shared<AdjLsa>(record.wire);
+          break;
+        case nlsr::tlv::CoordinateLsa:
+          lsa = std::make_shared<CoordinateLsa>(record.wire);
+          break;
+        default:
+          NLSR_LOG_WARN("Skipping snapshot record of unknown type " << record.wire.type());
+          continue;
+      }
+
+      if (lsa->getOriginRouter() == m_thisRouterPrefix ||
+          !isLsaNew(lsa->getOriginRouter(), lsa->getType(), lsa->getSeqNo())) {
+        continue;
+      }
+      installLsa(lsa);
+      ++nInstalled;
+    }
+    catch (const std::exception& e) {
+      NLSR_LOG_WARN("Skipping undecodable snapshot record: " << e.what());
+    }
+  }
+
+  NLSR_LOG_INFO("Restored " << nInstalled << " LSAs from " << m_snapshot.getFilePath());
+  // the LSDB now matches the snapshot
+  m_snapshotModificationCount = m_modificationCount;
+}
+
+void
+Lsdb::scheduleSnapshotWrite()
+{
+  if (!m_snapshot.isEnabled() || m_confParam.getLsdbSnapshotInterval() == 0) {
+    return;
+  }
+
+  m_snapshotEvent = m_scheduler.schedule(ndn::time::seconds(m_confParam.getLsdbSnapshotInterval()),
+                                         [this] {
+                                           writeSnapshot();
+                                           scheduleSnapshotWrite();
+                                         });
+}
+
+void
+Lsdb::writeSnapshot()
+{
+  if (m_snapshotModificationCount == m_modificationCount) {
+    return;
+  }
+
+  std::vector<std::shared_ptr<Lsa>> lsas;
+  lsas.reserve(m_lsdb.size());
+  for (const auto& lsa : m_lsdb) {
+    if (lsa->getOriginRouter() != m_thisRouterPrefix) {
+      lsas.push_back(lsa);
+    }
+  }
+
+  try {
+    m_snapshot.write(lsas);
+    m_snapshotModificationCount = m_modificationCount;
+  }
+  catch (const std::exception& e) {
+    NLSR_LOG_WARN("Failed to write LSDB snapshot: " << e.what());
+  }
+}
+
 void
 Lsdb::processInterest(const ndn::Name& name, const ndn::Interest& interest)
 {
@@ -249,6 +362,249 @@ Lsdb::processInterest(const ndn::Name& name, const ndn::Interest& interest)
   }
 }
 
+ndn::Name
+Lsdb::makeLsaDataName(const ndn::Name& originRouter, Lsa::Type lsaType, uint64_t seqNo) const
+{
+  ndn::Name userPrefix(m_confParam.getLsaPrefix());
+  userPrefix.append(originRouter.getSubName(m_confParam.getNetwork().size()));
+  return makeLsaUserPrefix(userPrefix, lsaType).appendNumber(seqNo);
+}
+
+void
+Lsdb::processLsdbInterest(const ndn::Interest& interest)
+{
+  const ndn::Name& interestName = interest.getName();
+  NLSR_LOG_DEBUG("Interest received for LSDB dataset: " << interestName);
+
+  if (interestName.size() == m_lsdbDatasetPrefix.size() + 2 &&
+      interestName[-2].isVersion() && interestName[-1].isSegment()) {
+    // Interest for a segment of an already announced version
+    if (!m_lsdbDatasetSegments.empty() &&
+        m_lsdbDatasetSegments.front()->getName()[-2] == interestName[-2]) {
+      auto segNum = interestName[-1].toSegment();
+      if (segNum < m_lsdbDatasetSegments.size()) {
+        m_face.put(*m_lsdbDatasetSegments[segNum]);
+      }
+    }
+    else if (auto segment = m_lsdbDatasetStorage.find(interestName); segment) {
+      NLSR_LOG_TRACE("Serving superseded LSDB dataset segment " << interestName);
+      m_face.put(*segment);
+    }
+    return;
+  }
+
+  if (m_lsdbDatasetSegments.empty() || m_lsdbDatasetModificationCount != m_modificationCount) {
+    // Neighbors part-way through the current version can still finish it
+    for (const auto& segment : m_lsdbDatasetSegments) {
+      m_lsdbDatasetStorage.insert(*segment);
+      m_scheduler.schedule(LSDB_DATASET_RETENTION,
+                           [this, name = segment->getName()] { m_lsdbDatasetStorage.erase(name); });
+    }
+
+    auto content = makeLsdbDatasetContent();
+    m_lsdbDatasetSegments = m_segmenter.segment(*content,
+                                                ndn::Name(m_lsdbDatasetPrefix).appendVersion(),
+                                                ndn::MAX_NDN_PACKET_SIZE / 2, 1_s);
+    m_lsdbDatasetModificationCount = m_modificationCount;
+    NLSR_LOG_DEBUG("Built LSDB dataset of " << content->size() << " bytes in "
+                   << m_lsdbDatasetSegments.size() << " segments");
+  }
+  m_face.put(*m_lsdbDatasetSegments.front());
+}
+
+ndn::ConstBufferPtr
+Lsdb::makeLsdbDatasetContent()
+{
+  auto content = std::make_shared<ndn::Buffer>();
+  auto appendData = [&content] (const ndn::Data& data) {
+    const auto& wire = data.wireEncode();
+    content->insert(content->end(), wire.begin(), wire.end());
+  };
+
+  for (const auto& lsa : m_lsdb) {
+    auto dataName = makeLsaDataName(lsa->getOriginRouter(), lsa->getType(), lsa->getSeqNo());
+
+    if (lsa->getOriginRouter() == m_thisRouterPrefix) {
+      auto segments = m_segmenter.segment(lsa->wireEncode(), ndn::Name(dataName).appendVersion(),
+                                          ndn::MAX_NDN_PACKET_SIZE / 2, m_lsaRefreshTime);
+      for (const auto& data : segments) {
+        appendData(*data);
+      }
+      continue;
+    }
+
+    // The segments of a remote LSA must be shipped exactly as signed by its origin
+    auto first = m_lsaStorage.find(ndn::Interest(dataName).setCanBePrefix(true));
+    if (first == nullptr || !first->getFinalBlock() || !first->getName()[-1].isSegment()) {
+      NLSR_LOG_TRACE("No stored segments for " << dataName << ", not included in LSDB dataset");
+      continue;
+    }
+
+    ndn::Name versionName = first->getName().getPrefix(-1);
+    uint64_t nSegments = first->getFinalBlock()->toSegment() + 1;
+    std::vector<std::shared_ptr<const ndn::Data>> segments;
+    for (uint64_t segNum = 0; segNum < nSegments; ++segNum) {
+      auto segment = m_lsaStorage.find(ndn::Name(versionName).appendSegment(segNum));
+      if (segment == nullptr) {
+        break;
+      }
+      segments.push_back(std::move(segment));
+    }
+
+    if (segments.size() != nSegments) {
+      NLSR_LOG_TRACE("Incomplete stored segments for " << dataName << ", not included in LSDB dataset");
+      continue;
+    }
+    for (const auto& data : segments) {
+      appendData(*data);
+    }
+  }
+
+  return content;
+}
+
+void
+Lsdb::fetchLsdbFromNeighbor(uint64_t faceId)
+{
+  if (m_isLsdbBootstrapped || m_lsdbFetcher != nullptr || faceId == 0) {
+    return;
+  }
+
+  ndn::Interest interest(m_lsdbDatasetPrefix);
+  interest.setTag(std::make_shared<ndn::lp::NextHopFaceIdTag>(faceId));
+
+  ndn::SegmentFetcher::Options options;
+  options.interestLifetime = m_confParam.getLsaInterestLifetime();
+  options.maxTimeout = m_confParam.getLsaInterestLifetime();
+
+  NLSR_LOG_INFO("Fetching LSDB dataset via face " << faceId);
+  // The dataset itself is only a container: every LSA segment inside it
+  // carries its origin signature and is validated individually
+  m_lsdbFetcher = ndn::SegmentFetcher::start(m_face, interest,
+                                             ndn::security::getAcceptAllValidator(), options);
+
+  m_lsdbFetcher->onComplete.connect([this] (const ndn::ConstBufferPtr& bufferPtr) {
+    m_lsdbFetcher.reset();
+    afterFetchLsdb(bufferPtr);
+  });
+
+  m_lsdbFetcher->onError.connect([this, faceId] (uint32_t errorCode, const std::string& msg) {
+    // the next neighbor that comes up gets another chance
+    NLSR_LOG_DEBUG("Failed to fetch LSDB dataset via face " << faceId << ", Error code: "
+                   << errorCode << ", Message: " << msg);
+    m_lsdbFetcher.reset();
+  });
+}
+
+void
+Lsdb::afterFetchLsdb(const ndn::ConstBufferPtr& bufferPtr)
+{
+  struct PendingLsa
+  {
+    ndn::Name versionName;
+    ndn::Name originRouter;
+    Lsa::Type lsaType = Lsa::Type::BASE;
+    uint64_t seqNo = 0;
+    std::vector<std::optional<ndn::Block>> contents;
+    size_t nValidated = 0;
+  };
+  std::map<ndn::Name, std::shared_ptr<PendingLsa>> pendingLsas;
+
+  const ndn::Name& ownUserPrefix = m_confParam.getSyncUserPrefix();
+  const ndn::Name& lsaPrefix = m_confParam.getLsaPrefix();
+
+  size_t offset = 0;
+  std::vector<std::pair<std::shared_ptr<PendingLsa>, std::shared_ptr<ndn::Data>>> toValidate;
+  while (offset < bufferPtr->size()) {
+    auto [isOk, block] = ndn::Block::fromBuffer(bufferPtr, offset);
+    if (!isOk) {
+      NLSR_LOG_WARN("Malformed LSDB dataset at offset " << offset);
+      break;
+    }
+    offset += block.size();
+
+    std::shared_ptr<ndn::Data> data;
+    try {
+      data = std::make_shared<ndn::Data>(block);
+    }
+    catch (const std::exception& e) {
+      NLSR_LOG_WARN("Skipping undecodable LSDB dataset entry: " << e.what());
+      continue;
+    }
+
+    // <lsaPrefix>/<site>/<router>/<lsaType>/<seqNo>/<version>/<segment>
+    const ndn::Name& dataName = data->getName();
+    if (!lsaPrefix.isPrefixOf(dataName) || dataName.size() < lsaPrefix.size() + 5 ||
+        !dataName[-1].isSegment() || !dataName[-2].isVersion() || !data->getFinalBlock() ||
+        ownUserPrefix.isPrefixOf(dataName)) {
+      continue;
+    }
+
+    ndn::Name versionName = dataName.getPrefix(-1);
+    auto& pending = pendingLsas[versionName];
+    if (pending == nullptr) {
+      ndn::Name originRouter = m_confParam.getNetwork();
+      originRouter.append(dataName.getSubName(lsaPrefix.size(),
+                                              dataName.size() - lsaPrefix.size() - 4));
+      Lsa::Type lsaType;
+      std::istringstream(dataName[-4].toUri()) >> lsaType;
+      uint64_t seqNo = dataName[-3].toNumber();
+
+      // an LSA we already have (or a newer one) is left with an empty versionName and skipped
+      pending = std::make_shared<PendingLsa>();
+      if (lsaType != Lsa::Type::BASE && isLsaNew(originRouter, lsaType, seqNo)) {
+        pending->versionName = versionName;
+        pending->originRouter = originRouter;
+        pending->lsaType = lsaType;
+        pending->seqNo = seqNo;
+        pending->contents.resize(data->getFinalBlock()->toSegment() + 1);
+      }
+    }
+
+    auto segNum = dataName[-1].toSegment();
+    if (pending->versionName.empty() || segNum >= pending->contents.size()) {
+      continue;
+    }
+    toValidate.emplace_back(pending, std::move(data));
+  }
+
+  NLSR_LOG_INFO("LSDB dataset contains " << pendingLsas.size() << " LSAs, "
+                << toValidate.size() << " segments to validate");
+
+  for (const auto& [pending, data] : toValidate) {
+    m_confParam.getValidator().validate(*data,
+      [this, pending = pending] (const ndn::Data& segment) {
+        storeLsaSegment(segment);
+
+        auto& content = pending->contents[segment.getName()[-1].toSegment()];
+        if (content) {
+          return;
+        }
+        content = segment.getContent();
+        if (++pending->nValidated < pending->contents.size()) {
+          return;
+        }
+
+        auto buffer = std::make_shared<ndn::Buffer>();
+        for (const auto& block : pending->contents) {
+          buffer->insert(buffer->end(), block->value_begin(), block->value_end());
+        }
+        afterFetchLsa(buffer, pending->versionName.getPrefix(-1));
+
+        // a dataset none of whose LSAs could be installed leaves the next neighbor to try
+        auto lsa = findLsa(pending->originRouter, pending->lsaType);
+        if (!m_isLsdbBootstrapped && lsa != nullptr && lsa->getSeqNo() == pending->seqNo) {
+          NLSR_LOG_INFO("LSDB bootstrapped from neighbor dataset");
+          m_isLsdbBootstrapped = true;
+        }
+      },
+      [] (const ndn::Data& segment, const ndn::security::ValidationError& error) {
+        NLSR_LOG_DEBUG("LSA segment " << segment.getName() << " from LSDB dataset is invalid: "
+                       << error);
+      });
+  }
+}
+
 bool
 Lsdb::processInterestForLsa(const ndn::Interest& interest, const ndn::Name& originRouter,
                             Lsa::Type lsaType, uint64_t seqNo)
@@ -287,6 +643,11 @@ Lsdb::processInterestForLsa(const ndn::Interest& interest, const ndn::Name& orig
 void
 Lsdb::installLsa(std::shared_ptr<Lsa> lsa)
 {
+  if (!m_confParam.isLsaWireStorageEnabled()) {
+    // reject a malformed LSA before any of it is installed
+    lsa->decodeContent();
+  }
+
   auto timeToExpire = m_lsaRefreshTime;
   if (lsa->getOriginRouter() != m_thisRouterPrefix) {
     auto duration = lsa->getExpirationTimePoint() - ndn::time::system_clock::now();
@@ -300,15 +661,20 @@ Lsdb::installLsa(std::shared_ptr<Lsa> lsa)
     NLSR_LOG_DEBUG("Adding LSA:\n" << *lsa);
 
     m_lsdb.emplace(lsa);
+    ++m_modificationCount;
     onLsdbModified(lsa, LsdbUpdate::INSTALLED, {}, {});
 
     lsa->setExpiringEventId(scheduleLsaExpiration(lsa, timeToExpire));
+    if (m_confParam.isLsaWireStorageEnabled()) {
+      lsa->releaseContent();
+    }
   }
   // Else this is a known name LSA, so we are updating it.
   else if (chkLsa->getSeqNo() < lsa->getSeqNo()) {
     NLSR_LOG_DEBUG("Updating LSA:\n" << *chkLsa);
     chkLsa->setSeqNo(lsa->getSeqNo());
     chkLsa->setExpirationTimePoint(lsa->getExpirationTimePoint());
+    ++m_modificationCount;
 
     // Log Service Function info before update
     if (lsa->getType() == Lsa::Type::NAME) {
@@ -343,6 +709,9 @@ Lsdb::installLsa(std::shared_ptr<Lsa> lsa)
 
     chkLsa->setExpiringEventId(scheduleLsaExpiration(chkLsa, timeToExpire));
     NLSR_LOG_DEBUG("Updated LSA:\n" << *chkLsa);
+    if (m_confParam.isLsaWireStorageEnabled()) {
+      chkLsa->releaseContent();
+    }
   }
 }
 
@@ -353,6 +722,7 @@ Lsdb::removeLsa(const LsaContainer::index<Lsdb::byName>::type::iterator& lsaIt)
     auto lsaPtr = *lsaIt;
     NLSR_LOG_DEBUG("Removing LSA:\n" << *lsaPtr);
     m_lsdb.erase(lsaIt);
+    ++m_modificationCount;
     onLsdbModified(lsaPtr, LsdbUpdate::REMOVED, {}, {});
   }
 }
@@ -360,7 +730,10 @@ Lsdb::removeLsa(const LsaContainer::index<Lsdb::byName>::type::iterator& lsaIt)
 void
 Lsdb::removeLsa(const ndn::Name& router, Lsa::Type lsaType)
 {
-  removeLsa(m_lsdb.get<byName>().find(std::make_tuple(router, lsaType)));
+  auto routerId = RouterNameInterner::getGlobal().find(router);
+  if (routerId) {
+    removeLsa(m_lsdb.get<byName>().find(std::make_tuple(*routerId, lsaType)));
+  }
 }
 
 void
@@ -435,7 +808,7 @@ Lsdb::expireOrRefreshLsa(std::shared_ptr<Lsa> lsa)
   NLSR_LOG_DEBUG("ExpireOrRefreshLsa called for " << lsa->getType());
   NLSR_LOG_DEBUG("OriginRouter: " << lsa->getOriginRouter() << " Seq No: " << lsa->getSeqNo());
 
-  auto lsaIt = m_lsdb.get<byName>().find(std::make_tuple(lsa->getOriginRouter(), lsa->getType()));
+  auto lsaIt = m_lsdb.get<byName>().find(std::make_tuple(lsa->getOriginRouterId(), lsa->getType()));
 
   // If this name LSA exists in the LSDB
   if (lsaIt != m_lsdb.end()) {
@@ -449,6 +822,7 @@ Lsdb::expireOrRefreshLsa(std::shared_ptr<Lsa> lsa)
         NLSR_LOG_DEBUG("Current LSA:\n" << *lsaPtr);
         lsaPtr->setSeqNo(lsaPtr->getSeqNo() + 1);
         m_sequencingManager.setLsaSeq(lsaPtr->getSeqNo(), lsaPtr->getType());
+        ++m_modificationCount;
         lsaPtr->setExpirationTimePoint(getLsaExpirationTimePoint());
         NLSR_LOG_DEBUG("Updated LSA:\n" << *lsaPtr);
         // schedule refreshing event again
@@ -469,6 +843,16 @@ void
 Lsdb::expressInterest(const ndn::Name& interestName, uint32_t timeoutCount, uint64_t incomingFaceId,
                       ndn::time::steady_clock::time_point deadline)
 {
+  if (m_confParam.isLsaMultipathFetchEnabled()) {
+    auto it = m_multipathFetchers.find(interestName);
+    if (it != m_multipathFetchers.end()) {
+      // another neighbor announced the same LSA, so it can serve segments too;
+      // the Interest was counted when the fetch started
+      it->second->addFace(incomingFaceId);
+      return;
+    }
+  }
+
   // increment SENT_LSA_INTEREST
   lsaIncrementSignal(Statistics::PacketType::SENT_LSA_INTEREST);
 
@@ -493,6 +877,15 @@ Lsdb::expressInterest(const ndn::Name& interestName, uint32_t timeoutCount, uint
     return;
   }
 
+  Lsa::Type lsaType;
+  std::istringstream(interestName[-2].toUri()) >> lsaType;
+  incrementInterestSentStats(lsaType);
+
+  if (m_confParam.isLsaMultipathFetchEnabled()) {
+    fetchLsaMultipath(interestName, timeoutCount, incomingFaceId, deadline);
+    return;
+  }
+
   ndn::Interest interest(interestName);
   if (incomingFaceId != 0) {
     interest.setTag(std::make_shared<ndn::lp::NextHopFaceIdTag>(incomingFaceId));
@@ -506,17 +899,7 @@ Lsdb::expressInterest(const ndn::Name& interestName, uint32_t timeoutCount, uint
 
   auto it = m_fetchers.insert(fetcher).first;
 
-  fetcher->afterSegmentValidated.connect([this] (const ndn::Data& data) {
-    // Nlsr class subscribes to this to fetch certificates
-    afterSegmentValidatedSignal(data);
-
-    // If we don't do this IMS throws: std::bad_weak_ptr: bad_weak_ptr
-    auto lsaSegment = std::make_shared<const ndn::Data>(data);
-    m_lsaStorage.insert(*lsaSegment);
-    // Schedule deletion of the segment
-    m_scheduler.schedule(ndn::time::seconds(LSA_REFRESH_TIME_DEFAULT),
-                         [this, name = lsaSegment->getName()] { m_lsaStorage.erase(name); });
-  });
+  fetcher->afterSegmentValidated.connect([this] (const ndn::Data& data) { storeLsaSegment(data); });
 
   fetcher->onComplete.connect([=] (const ndn::ConstBufferPtr& bufferPtr) {
     m_lsaStorage.erase(ndn::Name(lsaName).appendNumber(seqNo - 1));
@@ -528,10 +911,50 @@ Lsdb::expressInterest(const ndn::Name& interestName, uint32_t timeoutCount, uint
     onFetchLsaError(errorCode, msg, interestName, timeoutCount, deadline, lsaName, seqNo);
     m_fetchers.erase(it);
   });
+}
 
-  Lsa::Type lsaType;
-  std::istringstream(interestName[-2].toUri()) >> lsaType;
-  incrementInterestSentStats(lsaType);
+void
+Lsdb::fetchLsaMultipath(const ndn::Name& interestName, uint32_t timeoutCount,
+                        uint64_t incomingFaceId, ndn::time::steady_clock::time_point deadline)
+{
+  ndn::Name lsaName = interestName.getSubName(0, interestName.size()-1);
+  uint64_t seqNo = interestName[-1].toNumber();
+
+  MultipathSegmentFetcher::Options options;
+  options.interestLifetime = m_confParam.getLsaInterestLifetime();
+
+  NLSR_LOG_DEBUG("Fetching Data for LSA: " << interestName << " Seq number: " << seqNo
+                 << " over multiple paths");
+  auto fetcher = MultipathSegmentFetcher::start(m_face, interestName, incomingFaceId,
+                                                m_confParam.getValidator(), options);
+  m_multipathFetchers.emplace(interestName, fetcher);
+
+  fetcher->afterSegmentValidated.connect([this] (const ndn::Data& data) { storeLsaSegment(data); });
+
+  fetcher->onComplete.connect([=] (const ndn::ConstBufferPtr& bufferPtr) {
+    m_multipathFetchers.erase(interestName);
+    m_lsaStorage.erase(ndn::Name(lsaName).appendNumber(seqNo - 1));
+    afterFetchLsa(bufferPtr, interestName);
+  });
+
+  fetcher->onError.connect([=] (uint32_t errorCode, const std::string& msg) {
+    m_multipathFetchers.erase(interestName);
+    onFetchLsaError(errorCode, msg, interestName, timeoutCount, deadline, lsaName, seqNo);
+  });
+}
+
+void
+Lsdb::storeLsaSegment(const ndn::Data& data)
+{
+  // Nlsr class subscribes to this to fetch certificates
+  afterSegmentValidatedSignal(data);
+
+  // If we don't do this IMS throws: std::bad_weak_ptr: bad_weak_ptr
+  auto lsaSegment = std::make_shared<const ndn::Data>(data);
+  m_lsaStorage.insert(*lsaSegment);
+  // Schedule deletion of the segment
+  m_scheduler.schedule(ndn::time::seconds(LSA_REFRESH_TIME_DEFAULT),
+                       [this, name = lsaSegment->getName()] { m_lsaStorage.erase(name); });
 }
 
 void
@@ -22,12 +22,14 @@
 #ifndef NLSR_LSDB_HPP
 #define NLSR_LSDB_HPP
 
+#include "communication/multipath-segment-fetcher.hpp"
 #include "communication/sync-logic-handler.hpp"
 #include "conf-parameter.hpp"
 #include "lsa/lsa.hpp"
 #include "lsa/name-lsa.hpp"
 #include "lsa/coordinate-lsa.hpp"
 #include "lsa/adj-lsa.hpp"
+#include "lsdb-snapshot.hpp"
 #include "sequencing-manager.hpp"
 #include "statistics.hpp"
 #include "test-access-control.hpp"
@@ -49,6 +51,8 @@ namespace nlsr {
 namespace bmi = boost::multi_index;
 
 inline constexpr ndn::time::seconds GRACE_PERIOD = 10_s;
+/// how long the segments of a superseded LSDB dataset version are still served
+inline constexpr ndn::time::seconds LSDB_DATASET_RETENTION = 30_s;
 
 enum class LsdbUpdate {
   INSTALLED,
@@ -68,7 +72,7 @@ public:
   bool
   doesLsaExist(const ndn::Name& router, Lsa::Type lsaType)
   {
-    return m_lsdb.get<byName>().find(std::make_tuple(router, lsaType)) != m_lsdb.end();
+    return findLsa(router, lsaType) != nullptr;
   }
 
   /*! \brief Builds a name LSA for this router and then installs it
@@ -90,6 +94,29 @@ public:
   void
   writeLog() const;
 
+  /*! \brief Reinstalls the remote LSAs saved by a previous run.
+
+    Only LSAs that have not yet expired are loaded, and this router's own LSAs
+    are skipped because they are rebuilt with fresh sequence numbers. The loaded
+    LSAs go through installLsa(), so this must be called after the routing table
+    and the name prefix table are connected to onLsdbModified. Sync later replaces
+    any LSA for which a newer sequence number is announced.
+   */
+  void
+  loadSnapshot();
+
+  /*! \brief Fetches the whole LSDB of an adjacent router in one segmented transfer.
+
+    The dataset carries every LSA segment with its origin signature, so each
+    LSA is validated exactly as if it had been fetched on its own. At most one
+    transfer runs at a time, and none is started once an LSA of a transfer has
+    been installed; afterwards sync only delivers deltas.
+
+    \param faceId The face towards the adjacent router.
+   */
+  void
+  fetchLsdbFromNeighbor(uint64_t faceId);
+
   /* \brief Process interest which can be either:
    * 1) Discovery interest from segment fetcher:
    *    /localhop/<network>/nlsr/LSA/<site>/<router>/<lsaType>/<seqNo>
@@ -118,24 +145,6 @@ public:
     return std::static_pointer_cast<T>(findLsa(router, T::type()));
   }
 
-  struct ExtractOriginRouter
-  {
-    using result_type = ndn::Name;
-
-    ndn::Name
-    operator()(const Lsa& lsa) const
-    {
-      return lsa.getOriginRouter();
-    }
-  };
-
-  struct name_hash {
-    int
-    operator()(const ndn::Name& name) const {
-      return std::hash<ndn::Name>{}(name);
-    }
-  };
-
   struct enum_class_hash {
     template<typename T>
     int
@@ -154,10 +163,10 @@ public:
         bmi::tag<byName>,
         bmi::composite_key<
           Lsa,
-          ExtractOriginRouter,
+          bmi::const_mem_fun<Lsa, RouterId, &Lsa::getOriginRouterId>,
           bmi::const_mem_fun<Lsa, Lsa::Type, &Lsa::getType>
         >,
-        bmi::composite_key_hash<name_hash, enum_class_hash>
+        bmi::composite_key_hash<std::hash<RouterId>, enum_class_hash>
       >,
       bmi::hashed_non_unique<
         bmi::tag<byType>,
@@ -179,7 +188,12 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   std::shared_ptr<Lsa>
   findLsa(const ndn::Name& router, Lsa::Type lsaType) const
   {
-    auto it = m_lsdb.get<byName>().find(std::make_tuple(router, lsaType));
+    // a router that was never interned has no LSA
+    auto routerId = RouterNameInterner::getGlobal().find(router);
+    if (!routerId) {
+      return nullptr;
+    }
+    auto it = m_lsdb.get<byName>().find(std::make_tuple(*routerId, lsaType));
     return it != m_lsdb.end() ? *it : nullptr;
   }
 
@@ -238,6 +252,12 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
     return lsaPtr ? lsaPtr->getSeqNo() < seqNo : true;
   }
 
+  /*! \brief Installs \p lsa, or updates the LSA of the same origin and type with it.
+
+    With wire LSA storage, the decoded content of a remote LSA is released once the
+    LSDB has been updated. Otherwise the content is decoded first.
+    \throw ndn::tlv::Error The content of \p lsa is malformed.
+  */
   void
   installLsa(std::shared_ptr<Lsa> lsa);
 
@@ -269,6 +289,15 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   buildAndInstallOwnAdjLsa();
 
+  /*! \brief Schedules the next periodic write of the LSDB snapshot. */
+  void
+  scheduleSnapshotWrite();
+
+  /*! \brief Writes the remote LSAs to the snapshot file if the LSDB changed since the last write.
+   */
+  void
+  writeSnapshot();
+
   /*! \brief Schedules a refresh/expire event in the scheduler.
     \param lsa The LSA.
     \param expTime How many seconds to wait before triggering the event.
@@ -286,10 +315,53 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   processInterestForLsa(const ndn::Interest& interest, const ndn::Name& originRouter,
                         Lsa::Type lsaType, uint64_t seqNo);
 
+  /*! \brief Returns the name under which an LSA is published, without version and segment:
+      /localhop/<network>/nlsr/LSA/<site>/<router>/<lsaType>/<seqNo>
+   */
+  ndn::Name
+  makeLsaDataName(const ndn::Name& originRouter, Lsa::Type lsaType, uint64_t seqNo) const;
+
+  /*! \brief Serves the bulk LSDB dataset under /localhop/<network>/nlsr/LSDB.
+
+    A discovery Interest (without version) rebuilds the dataset if the LSDB changed
+    since it was last built; segment Interests are answered from the cached version.
+    The segments of the version a rebuild supersedes are kept for LSDB_DATASET_RETENTION,
+    so that neighbors already fetching it can finish.
+   */
+  void
+  processLsdbInterest(const ndn::Interest& interest);
+
+  /*! \brief Returns the concatenated LSA segments, each one a complete signed Data packet.
+
+    Own LSAs are segmented and signed on the fly. Remote LSAs are only included when
+    all of their validated segments are still held in the LSA segment storage.
+   */
+  ndn::ConstBufferPtr
+  makeLsdbDatasetContent();
+
+  /*! \brief Validates and installs the LSAs contained in a bulk LSDB dataset.
+   */
+  void
+  afterFetchLsdb(const ndn::ConstBufferPtr& bufferPtr);
+
   void
   expressInterest(const ndn::Name& interestName, uint32_t timeoutCount, uint64_t incomingFaceId,
                   ndn::time::steady_clock::time_point deadline = DEFAULT_LSA_RETRIEVAL_DEADLINE);
 
+  /*! \brief Fetches an LSA by spreading its segments over the neighbors that announced it.
+
+    Only called when no fetch for the same LSA and sequence number is in progress;
+    expressInterest() gives such a fetch \p incomingFaceId as an additional path instead.
+   */
+  void
+  fetchLsaMultipath(const ndn::Name& interestName, uint32_t timeoutCount, uint64_t incomingFaceId,
+                    ndn::time::steady_clock::time_point deadline);
+
+  /*! \brief Keeps a validated LSA segment so it can be served to other routers.
+   */
+  void
+  storeLsaSegment(const ndn::Data& data);
+
   /*!
      \brief Error callback when SegmentFetcher fails to return an LSA
 
@@ -356,10 +428,16 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   std::map<ndn::Name, uint64_t> m_highestSeqNo;
 
   SequencingManager m_sequencingManager;
+  LsdbSnapshot m_snapshot;
+  // bumped on every install, update and removal; lets derived state detect staleness
+  uint64_t m_modificationCount = 0;
+  uint64_t m_snapshotModificationCount = 0;
+  ndn::scheduler::ScopedEventId m_snapshotEvent;
 
   ndn::signal::ScopedConnection m_onNewLsaConnection;
 
   std::set<std::shared_ptr<ndn::SegmentFetcher>> m_fetchers;
+  std::map<ndn::Name, std::shared_ptr<MultipathSegmentFetcher>> m_multipathFetchers;
   ndn::Segmenter m_segmenter;
   ndn::InMemoryStorageFifo m_segmentFifo;
 
@@ -369,6 +447,14 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
   ndn::InMemoryStoragePersistent m_lsaStorage;
 
+  ndn::Name m_lsdbDatasetPrefix;
+  std::vector<std::shared_ptr<ndn::Data>> m_lsdbDatasetSegments;
+  /// segments of superseded versions
+  ndn::InMemoryStoragePersistent m_lsdbDatasetStorage;
+  uint64_t m_lsdbDatasetModificationCount = 0;
+  std::shared_ptr<ndn::SegmentFetcher> m_lsdbFetcher;
+  bool m_isLsdbBootstrapped = false;
+
   static inline const ndn::time::steady_clock::time_point DEFAULT_LSA_RETRIEVAL_DEADLINE =
     ndn::time::steady_clock::time_point::min();
 };
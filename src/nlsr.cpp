@@ -23,6 +23,7 @@
 #include "adjacent.hpp"
 #include "logger.hpp"
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstdio>
 #include <unistd.h>
@@ -46,7 +47,7 @@ Nlsr::Nlsr(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
   , m_routingTable(m_scheduler, m_lsdb, m_confParam)
   , m_namePrefixTable(confParam.getRouterPrefix(), m_fib, m_routingTable,
                       m_routingTable.afterRoutingChange, m_lsdb.onLsdbModified,
-                      m_lsdb, m_confParam)
+                      m_lsdb, m_confParam, m_scheduler)
   , m_helloProtocol(m_face, keyChain, confParam, m_routingTable, m_lsdb)
   , m_onNewLsaConnection(m_lsdb.getSync().onNewLsa.connect(
       [this] (const ndn::Name& updateName, uint64_t sequenceNumber,
@@ -63,6 +64,9 @@ Nlsr::Nlsr(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
         if (it != m_adjacencyList.end()) {
           m_fib.registerPrefix(m_confParam.getSyncPrefix(), it->getFaceUri(), it->getLinkCost(),
                                ndn::time::milliseconds::max(), ndn::nfd::ROUTE_FLAG_CAPTURE, 0);
+          if (m_confParam.isLsdbBootstrapEnabled()) {
+            m_lsdb.fetchLsdbFromNeighbor(it->getFaceId());
+          }
         }
       }))
   , m_dispatcher(m_face, keyChain)
@@ -81,6 +85,10 @@ Nlsr::Nlsr(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
   m_fib.setStrategy(m_confParam.getLsaPrefix(), Fib::MULTICAST_STRATEGY, 0);
   m_fib.setStrategy(m_confParam.getSyncPrefix(), Fib::MULTICAST_STRATEGY, 0);
 
+  // The routing table and the name prefix table are now listening to the LSDB,
+  // so LSAs restored from the previous run immediately feed route calculation
+  m_lsdb.loadSnapshot();
+
   NLSR_LOG_DEBUG("Default NLSR identity: " << m_confParam.getSigningInfo().getSignerName());
 
   // Register control commands BEFORE adding top prefix
@@ -94,8 +102,10 @@ Nlsr::Nlsr(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
       m_dispatcher, m_namePrefixList, m_lsdb);
 
   // Initialize handlers BEFORE adding top prefix
-  m_datasetHandler = std::make_unique<DatasetInterestHandler>(m_dispatcher, m_lsdb, m_routingTable);
+  m_datasetHandler = std::make_unique<DatasetInterestHandler>(m_dispatcher, m_lsdb, m_routingTable,
+                                                              m_namePrefixTable);
   m_sidecarStatsHandler = std::make_unique<SidecarStatsHandler>(m_dispatcher, m_lsdb, m_confParam, m_confParam.getSidecarLogPath());
+  m_sidecarStatsHandler->setNamePrefixTable(&m_namePrefixTable);
 
   // Finally add top-level prefix ONCE after all registrations
   // Dispatcher はトップレベルプレフィックスを 1 つのみ受け付ける
@@ -105,13 +115,29 @@ Nlsr::Nlsr(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
   NLSR_LOG_INFO("DatasetInterestHandler initialized successfully");
   NLSR_LOG_INFO("SidecarStatsHandler initialized with log path: " << m_confParam.getSidecarLogPath());
   
-  // Start log file monitoring for sidecar statistics (only if log path is configured)
-  if (!m_confParam.getSidecarLogPath().empty()) {
-    m_sidecarStatsHandler->startLogMonitoring(m_scheduler, 5000);  // 5 second interval
-    NLSR_LOG_INFO("Started log file monitoring with interval: 5000ms, logPath: " << m_confParam.getSidecarLogPath());
+  // Start log file monitoring for sidecar statistics (only if a log path is configured)
+  const auto& functionSources = m_confParam.getServiceFunctionSources();
+  if (!m_confParam.getSidecarLogPath().empty() ||
+      std::any_of(functionSources.begin(), functionSources.end(),
+                  [] (const auto& source) { return !source.logPath.empty(); })) {
+    m_sidecarStatsHandler->startLogMonitoring(m_face.getIoContext(), m_scheduler, 5000);  // 5 second poll fallback
+    NLSR_LOG_INFO("Started log file monitoring, logPath: " << m_confParam.getSidecarLogPath());
   } else {
     NLSR_LOG_INFO("Sidecar log monitoring is disabled (no log path configured)");
   }
+  if (!m_confParam.getSidecarShmName().empty()) {
+    m_sidecarStatsHandler->startShmIngestion(m_face.getIoContext(), m_scheduler,
+                                             m_confParam.getSidecarShmName());
+  }
+
+  if (m_confParam.getProbeInterval() > 0_s) {
+    ServiceFunctionProber::Options options;
+    options.interval = m_confParam.getProbeInterval();
+    options.maxFacesPerRound = m_confParam.getProbeMaxFaces();
+    m_serviceFunctionProber = std::make_unique<ServiceFunctionProber>(m_face, m_scheduler,
+                                                                      m_adjacencyList, options);
+    m_namePrefixTable.setServiceFunctionProber(m_serviceFunctionProber.get());
+  }
 
   enableIncomingFaceIdIndication();
 
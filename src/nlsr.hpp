@@ -33,6 +33,7 @@
 #include "route/fib.hpp"
 #include "route/name-prefix-table.hpp"
 #include "route/routing-table.hpp"
+#include "route/service-function-prober.hpp"
 #include "update/prefix-update-processor.hpp"
 #include "update/nfd-rib-command-processor.hpp"
 #include "utility/name-helper.hpp"
@@ -180,6 +181,7 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   Fib m_fib;
   Lsdb m_lsdb;
   RoutingTable m_routingTable;
+  std::unique_ptr<ServiceFunctionProber> m_serviceFunctionProber;
   NamePrefixTable m_namePrefixTable;
   HelloProtocol m_helloProtocol;
 
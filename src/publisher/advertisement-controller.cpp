@@ -0,0 +1,145 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "advertisement-controller.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace nlsr {
+
+namespace {
+
+double
+smooth(double previous, double sample, double alpha)
+{
+  return previous + alpha * (sample - previous);
+}
+
+bool
+isChanged(double advertised, double current, double absoluteThreshold, double relativeThreshold)
+{
+  if ((advertised == 0.0) != (current == 0.0)) {
+    return true;
+  }
+  double change = std::abs(current - advertised);
+  return change > absoluteThreshold || change > relativeThreshold * std::abs(advertised);
+}
+
+} // anonymous namespace
+
+AdvertisementController::AdvertisementController(const Options& options)
+  : m_options(options)
+{
+  m_options.smoothing = std::clamp(m_options.smoothing, 1e-3, 1.0);
+}
+
+AdvertisementController::Decision
+AdvertisementController::evaluate(ServiceFunctionInfo& info, ndn::time::steady_clock::time_point now)
+{
+  m_lastEvaluation = now;
+
+  if (!m_smoothed) {
+    m_smoothed = info;
+  }
+  else {
+    double alpha = m_options.smoothing;
+    // a metric that dropped to zero is reported as such rather than decayed
+    auto update = [alpha] (double previous, double sample) {
+      return sample == 0.0 ? 0.0 : smooth(previous, sample, alpha);
+    };
+    ServiceFunctionInfo smoothed = info;
+    smoothed.utilization = update(m_smoothed->utilization, info.utilization);
+    smoothed.load = update(m_smoothed->load, info.load);
+    smoothed.usageCount = static_cast<uint32_t>(std::lround(update(m_smoothed->usageCount, info.usageCount)));
+    smoothed.latencyP50 = static_cast<uint32_t>(std::lround(update(m_smoothed->latencyP50, info.latencyP50)));
+    smoothed.latencyP95 = static_cast<uint32_t>(std::lround(update(m_smoothed->latencyP95, info.latencyP95)));
+    smoothed.latencyP99 = static_cast<uint32_t>(std::lround(update(m_smoothed->latencyP99, info.latencyP99)));
+    smoothed.meanServiceTime = static_cast<uint32_t>(std::lround(update(m_smoothed->meanServiceTime,
+                                                                        info.meanServiceTime)));
+    m_smoothed = smoothed;
+  }
+  info = *m_smoothed;
+
+  // receivers shed an overloaded instance at once, so the overload state never waits
+  bool isDue = !m_advertised || now - m_lastAdvertisement >= m_options.maxInterval ||
+               m_advertised->isOverloaded != info.isOverloaded;
+  if (!isDue && isSignificant(info)) {
+    isDue = now - m_lastAdvertisement >= m_options.minInterval;
+    if (!isDue) {
+      m_isDeferred = true;
+      ++m_nSuppressed;
+      return Decision::DEFER;
+    }
+  }
+
+  if (!isDue) {
+    m_isDeferred = false;
+    ++m_nSuppressed;
+    return Decision::SUPPRESS;
+  }
+
+  m_advertised = info;
+  m_lastAdvertisement = now;
+  m_isDeferred = false;
+  ++m_nAdvertised;
+  return Decision::ADVERTISE;
+}
+
+ndn::time::steady_clock::time_point
+AdvertisementController::getNextCheckTime() const
+{
+  if (m_isDeferred) {
+    return m_lastAdvertisement + m_options.minInterval;
+  }
+
+  auto nextCheck = m_lastAdvertisement + m_options.maxInterval;
+  if (m_smoothed && (m_smoothed->utilization > 0.0 || m_smoothed->load > 0.0 ||
+                     m_smoothed->usageCount > 0 || m_smoothed->latencyP99 > 0)) {
+    nextCheck = std::min(nextCheck, m_lastEvaluation + m_options.minInterval);
+  }
+  return nextCheck;
+}
+
+bool
+AdvertisementController::isSignificant(const ServiceFunctionInfo& info) const
+{
+  const auto& advertised = *m_advertised;
+  double absolute = m_options.absoluteThreshold;
+  double relative = m_options.relativeThreshold;
+  // usage count and latency have no fixed scale; only the relative threshold applies
+  double unbounded = std::numeric_limits<double>::infinity();
+  return isChanged(advertised.utilization, info.utilization, absolute, relative) ||
+         isChanged(advertised.load, info.load, absolute, relative) ||
+         isChanged(advertised.usageCount, info.usageCount, unbounded, relative) ||
+         isChanged(advertised.latencyP99, info.latencyP99, unbounded, relative) ||
+         isChanged(advertised.meanServiceTime, info.meanServiceTime, unbounded, relative) ||
+         advertised.workerCapacity != info.workerCapacity ||
+         advertised.maxConcurrency != info.maxConcurrency ||
+         // learned weights drift a little with every sample
+         isChanged(advertised.processingWeight, info.processingWeight, absolute, relative) ||
+         isChanged(advertised.loadWeight, info.loadWeight, absolute, relative) ||
+         isChanged(advertised.usageWeight, info.usageWeight, absolute, relative) ||
+         isChanged(advertised.latencyWeight, info.latencyWeight, absolute, relative);
+}
+
+} // namespace nlsr
@@ -0,0 +1,121 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_PUBLISHER_ADVERTISEMENT_CONTROLLER_HPP
+#define NLSR_PUBLISHER_ADVERTISEMENT_CONTROLLER_HPP
+
+#include "common.hpp"
+#include "lsa/name-lsa.hpp"
+
+#include <optional>
+
+namespace nlsr {
+
+/*! \brief Decides when the Service Function info of this router is worth re-advertising.
+
+  Every advertisement rebuilds the own Name LSA, which takes a new sequence number, a
+  sequence file write, a sync publication and a fetch by every router in the network.
+  The controller smooths the metrics with an EWMA and lets an update through only if
+  - nothing was advertised yet,
+  - a smoothed metric moved significantly from its advertised value and at least
+    Options::minInterval passed since the previous advertisement, or
+  - Options::maxInterval passed since the previous advertisement, or
+  - the instance became overloaded or stopped being overloaded.
+
+  A change is significant if it exceeds Options::relativeThreshold of the advertised
+  value, or, for utilization, load and the cost weights, which lie in 0.0 ~ 1.0,
+  Options::absoluteThreshold.
+  A metric that becomes nonzero, or drops to zero, is always significant.
+ */
+class AdvertisementController
+{
+public:
+  struct Options
+  {
+    /// weight of a new sample in the smoothed metrics, 0.0 (exclusive) ~ 1.0
+    double smoothing = 0.5;
+    double absoluteThreshold = 0.05;
+    double relativeThreshold = 0.2;
+    ndn::time::milliseconds minInterval = 5_s;
+    ndn::time::milliseconds maxInterval = 60_s;
+  };
+
+  enum class Decision {
+    /// advertise now
+    ADVERTISE,
+    /// nothing worth advertising
+    SUPPRESS,
+    /// a significant change is held back until the minimum interval has passed
+    DEFER,
+  };
+
+  explicit
+  AdvertisementController(const Options& options);
+
+  /*! \brief Feeds a new sample and decides whether to advertise it.
+
+    \p info is replaced by the smoothed metrics, which is what should be advertised.
+   */
+  Decision
+  evaluate(ServiceFunctionInfo& info, ndn::time::steady_clock::time_point now);
+
+  /*! \brief Returns when evaluate() should be called again if no new sample arrives.
+
+    While a change is deferred, this is the end of the minimum interval. While the smoothed
+    metrics are nonzero, they may still decay, so it is one minimum interval after the last
+    evaluation. Otherwise it is the end of the maximum interval.
+   */
+  ndn::time::steady_clock::time_point
+  getNextCheckTime() const;
+
+  uint64_t
+  getNAdvertised() const
+  {
+    return m_nAdvertised;
+  }
+
+  /*! \brief Returns the number of samples that were not advertised, including deferred ones.
+   */
+  uint64_t
+  getNSuppressed() const
+  {
+    return m_nSuppressed;
+  }
+
+private:
+  bool
+  isSignificant(const ServiceFunctionInfo& info) const;
+
+private:
+  Options m_options;
+  std::optional<ServiceFunctionInfo> m_smoothed;
+  std::optional<ServiceFunctionInfo> m_advertised;
+  ndn::time::steady_clock::time_point m_lastAdvertisement;
+  ndn::time::steady_clock::time_point m_lastEvaluation;
+  bool m_isDeferred = false;
+
+  uint64_t m_nAdvertised = 0;
+  uint64_t m_nSuppressed = 0;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_PUBLISHER_ADVERTISEMENT_CONTROLLER_HPP
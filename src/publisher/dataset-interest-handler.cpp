@@ -26,6 +26,8 @@
 #include <ndn-cxx/mgmt/nfd/control-response.hpp>
 #include <ndn-cxx/util/regex.hpp>
 
+#include <sstream>
+
 namespace nlsr {
 
 INIT_LOGGER(DatasetInterestHandler);
@@ -34,12 +36,15 @@ const ndn::PartialName ADJACENCIES_DATASET{"lsdb/adjacencies"};
 const ndn::PartialName COORDINATES_DATASET{"lsdb/coordinates"};
 const ndn::PartialName NAMES_DATASET{"lsdb/names"};
 const ndn::PartialName RT_DATASET{"routing-table"};
+const ndn::PartialName SFC_CHAINS_DATASET{"sfc-chains"};
 
 DatasetInterestHandler::DatasetInterestHandler(ndn::mgmt::Dispatcher& dispatcher,
                                                const Lsdb& lsdb,
-                                               const RoutingTable& rt)
+                                               const RoutingTable& rt,
+                                               const NamePrefixTable& npt)
   : m_lsdb(lsdb)
   , m_routingTable(rt)
+  , m_namePrefixTable(npt)
 {
   dispatcher.addStatusDataset(ADJACENCIES_DATASET,
     ndn::mgmt::makeAcceptAllAuthorization(),
@@ -53,6 +58,9 @@ DatasetInterestHandler::DatasetInterestHandler(ndn::mgmt::Dispatcher& dispatcher
   dispatcher.addStatusDataset(RT_DATASET,
     ndn::mgmt::makeAcceptAllAuthorization(),
     std::bind(&DatasetInterestHandler::publishRtStatus, this, _1, _2, _3));
+  dispatcher.addStatusDataset(SFC_CHAINS_DATASET,
+    ndn::mgmt::makeAcceptAllAuthorization(),
+    std::bind(&DatasetInterestHandler::publishSfcChains, this, _1, _2, _3));
 }
 
 template <typename T>
@@ -77,4 +85,31 @@ DatasetInterestHandler::publishRtStatus(const ndn::Name& topPrefix, const ndn::I
   context.end();
 }
 
+void
+DatasetInterestHandler::publishSfcChains(const ndn::Name& topPrefix, const ndn::Interest& interest,
+                                         ndn::mgmt::StatusDatasetContext& context)
+{
+  NLSR_LOG_TRACE("Received interest: " << interest);
+  std::ostringstream os;
+  os << "Service Function Chains\n";
+  os << "=======================\n";
+  const auto& selections = m_namePrefixTable.getChainSelections();
+  if (selections.empty()) {
+    os << "No chain selected\n";
+  }
+  for (const auto& [chainName, selection] : selections) {
+    os << "Chain: " << chainName << " (total cost " << selection.totalCost << ")\n";
+    for (size_t k = 0; k < selection.routers.size(); ++k) {
+      os << "  Stage " << k << ": " << selection.routers[k] << "\n";
+      for (const auto& [router, detourCost] : selection.detourCosts[k]) {
+        if (router != selection.routers[k]) {
+          os << "    Alternative: " << router << " (+" << detourCost << ")\n";
+        }
+      }
+    }
+  }
+  context.append(ndn::encoding::makeStringBlock(ndn::tlv::Content, os.str()));
+  context.end();
+}
+
 } // namespace nlsr
@@ -34,6 +34,7 @@
 #include "route/routing-table-entry.hpp"
 #include "route/routing-table.hpp"
 #include "route/nexthop-list.hpp"
+#include "route/name-prefix-table.hpp"
 #include "lsdb.hpp"
 
 #include <ndn-cxx/face.hpp>
@@ -52,6 +53,9 @@ inline const ndn::Name::Component COORDINATE_COMPONENT{"coordinates"};
    \brief Class to publish all dataset
    \sa https://redmine.named-data.net/projects/nlsr/wiki/LSDB_DataSet
    \sa https://redmine.named-data.net/projects/nlsr/wiki/Routing_Table_DataSet
+
+   The sfc-chains dataset lists, as text, the instances selected for each configured
+   Service Function chain (see NamePrefixTable::getChainSelections).
  */
 class DatasetInterestHandler : boost::noncopyable
 {
@@ -64,7 +68,8 @@ public:
 
   DatasetInterestHandler(ndn::mgmt::Dispatcher& dispatcher,
                          const Lsdb& lsdb,
-                         const RoutingTable& rt);
+                         const RoutingTable& rt,
+                         const NamePrefixTable& npt);
 
 private:
   /*! \brief provide routing-table dataset
@@ -73,6 +78,12 @@ private:
   publishRtStatus(const ndn::Name& topPrefix, const ndn::Interest& interest,
                   ndn::mgmt::StatusDatasetContext& context);
 
+  /*! \brief provide Service Function chain selection dataset
+   */
+  void
+  publishSfcChains(const ndn::Name& topPrefix, const ndn::Interest& interest,
+                   ndn::mgmt::StatusDatasetContext& context);
+
   /*! \brief provide LSA status dataset
    */
   template<typename T>
@@ -83,6 +94,7 @@ private:
 private:
   const Lsdb& m_lsdb;
   const RoutingTable& m_routingTable;
+  const NamePrefixTable& m_namePrefixTable;
 };
 
 } // namespace nlsr
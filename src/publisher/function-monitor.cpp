@@ -0,0 +1,245 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "function-monitor.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace nlsr {
+
+INIT_LOGGER(FunctionMonitor);
+
+namespace {
+
+ndn::time::system_clock::time_point
+toTimePoint(int64_t timestamp)
+{
+  return ndn::time::system_clock::time_point(ndn::time::microseconds(timestamp));
+}
+
+uint32_t
+toLatency(int64_t microseconds)
+{
+  return static_cast<uint32_t>(std::clamp<int64_t>(microseconds, 0, std::numeric_limits<uint32_t>::max()));
+}
+
+} // anonymous namespace
+
+FunctionMonitor::FunctionMonitor(const ndn::Name& prefix, const std::string& callName,
+                                 const Options& options)
+  : m_prefix(prefix)
+  , m_callName(callName)
+  , m_options(options)
+  , m_window(options.windowLength)
+  , m_overloadDetector(options.overload)
+{
+  if (m_options.weightLearning) {
+    WeightLearner::Weights initial;
+    initial.processing = m_options.processingWeight;
+    initial.load = m_options.loadWeight;
+    initial.usage = m_options.usageWeight;
+    m_weightLearner.emplace(initial, *m_options.weightLearning);
+  }
+}
+
+bool
+FunctionMonitor::add(const SidecarRecord& record)
+{
+  m_latestRecord = record;
+  m_window.add(record);
+  ++m_nUnlearnedRecords;
+  return m_overloadDetector.add(record, getMaxConcurrency());
+}
+
+bool
+FunctionMonitor::expire(int64_t now)
+{
+  return m_overloadDetector.expire(now);
+}
+
+ServiceFunctionInfo
+FunctionMonitor::makeServiceFunctionInfo(ndn::time::system_clock::time_point now) const
+{
+  ServiceFunctionInfo info;
+  info.utilization = 0.0;
+  info.load = 0.0;
+  info.usageCount = 0;
+  info.lastUpdateTime = now;
+  info.processingWeight = m_options.processingWeight;
+  info.loadWeight = m_options.loadWeight;
+  info.usageWeight = m_options.usageWeight;
+  info.latencyWeight = m_options.latencyWeight;
+
+  // The overload state does not depend on the window, so it is set even without entries
+  info.maxConcurrency = getMaxConcurrency();
+  info.isOverloaded = m_overloadDetector.isOverloaded();
+
+  if (m_window.getNRequests() == 0) {
+    NLSR_LOG_DEBUG(m_prefix << ": no log entries found within time window, returning default values");
+    return info;
+  }
+
+  // Set lastUpdateTime to the latest entry timestamp
+  auto latestTimestamp = toTimePoint(m_window.getLatestTimestamp());
+  info.lastUpdateTime = latestTimestamp;
+
+  // If the latest entry is older than twice the window, the function has no traffic
+  auto staleThreshold = ndn::time::microseconds(2 * m_window.getWindowLength());
+  if (now - latestTimestamp > staleThreshold) {
+    NLSR_LOG_DEBUG(m_prefix << ": latest entry is too old, setting utilization to 0");
+    return info;
+  }
+
+  // Share of the worker capacity in use over the window ending at the latest entry
+  uint32_t capacity = getWorkerCapacity();
+  auto occupancy = m_window.getOccupancy(capacity);
+  info.utilization = occupancy.utilization;
+
+  // Share of the response time spent waiting in the sidecar, 0.0 ~ 1.0
+  double queueingDelay = m_window.getMeanQueueingDelay();
+  double responseTime = queueingDelay + m_window.getMeanProcessingTime();
+  info.load = responseTime > 0.0 ? queueingDelay / responseTime : 0.0;
+
+  // Requests per second over the window
+  double requestRate = m_window.getRequestRate();
+  info.usageCount = static_cast<uint32_t>(std::min(std::round(requestRate),
+                                                   double(std::numeric_limits<uint32_t>::max())));
+
+  // Tail of the service time distribution
+  const auto& serviceTime = m_window.getServiceTimeSketch();
+  info.latencyP50 = toLatency(serviceTime.getQuantile(0.5));
+  info.latencyP95 = toLatency(serviceTime.getQuantile(0.95));
+  info.latencyP99 = toLatency(serviceTime.getQuantile(0.99));
+
+  // Inputs of the queueing cost model
+  info.workerCapacity = capacity;
+  info.meanServiceTime = toLatency(std::llround(m_window.getMeanProcessingTime()));
+
+  NLSR_LOG_DEBUG(m_prefix << ": utilization=" << info.utilization
+                 << ", load=" << info.load << ", usageCount=" << info.usageCount
+                 << ", latency p50/p95/p99=" << info.latencyP50 << "/" << info.latencyP95
+                 << "/" << info.latencyP99 << " us"
+                 << " (mean concurrency " << occupancy.meanConcurrency << " of " << capacity << " workers, "
+                 << m_window.getNRequests() << " requests, " << requestRate << " req/s, "
+                 << m_window.getThroughput() << " B/s, queueing delay " << queueingDelay << " us)");
+  return info;
+}
+
+ServiceFunctionInfo
+FunctionMonitor::update(ndn::time::system_clock::time_point now)
+{
+  ServiceFunctionInfo info = makeServiceFunctionInfo(now);
+
+  // Receivers extrapolate the utilization along this trend to make up for the propagation delay
+  m_utilizationForecaster.update(info.utilization, info.lastUpdateTime);
+  info.utilizationTrend = m_utilizationForecaster.getTrend();
+
+  // Learn the weights from the latency observed over the same window. Only a fresh
+  // window with records that arrived since the last sample yields a new sample, so that
+  // the timers re-advertising an unchanged window do not weight the regression.
+  if (m_weightLearner) {
+    if (info.workerCapacity > 0 && m_nUnlearnedRecords > 0) {
+      double responseTime = m_window.getMeanQueueingDelay() + m_window.getMeanProcessingTime();
+      m_weightLearner->update(info, responseTime / 1e6);
+      m_nUnlearnedRecords = 0;
+    }
+    const auto& weights = m_weightLearner->getWeights();
+    info.processingWeight = weights.processing;
+    info.loadWeight = weights.load;
+    info.usageWeight = weights.usage;
+    NLSR_LOG_DEBUG(m_prefix << ": learned weights processing=" << weights.processing
+                   << ", load=" << weights.load << ", usage=" << weights.usage
+                   << " (" << m_weightLearner->getNSamples() << " samples)");
+  }
+  return info;
+}
+
+std::map<std::string, std::string>
+FunctionMonitor::getStats() const
+{
+  if (!m_latestRecord) {
+    return {{"error", "No log entries found"}};
+  }
+
+  // Return the latest entry
+  std::map<std::string, std::string> stats;
+  auto addTime = [&stats] (const std::string& key, int64_t timestamp) {
+    if (timestamp != 0) {
+      stats[key] = formatSidecarTimestamp(timestamp);
+    }
+  };
+  addTime("service_call_in_time", m_latestRecord->serviceCallInTime);
+  addTime("service_call_out_time", m_latestRecord->serviceCallOutTime);
+  addTime("sidecar_in_time", m_latestRecord->sidecarInTime);
+  addTime("sidecar_out_time", m_latestRecord->sidecarOutTime);
+  addTime("sfc_time", m_latestRecord->sfcTime);
+
+  // Occupancy of the service function over the utilization window
+  uint32_t capacity = getWorkerCapacity();
+  auto occupancy = m_window.getOccupancy(capacity);
+  stats["worker_capacity"] = std::to_string(capacity);
+  stats["mean_concurrency"] = std::to_string(occupancy.meanConcurrency);
+  stats["utilization"] = std::to_string(occupancy.utilization);
+
+  // Traffic over the utilization window
+  stats["request_rate"] = std::to_string(m_window.getRequestRate());
+  stats["throughput"] = std::to_string(m_window.getThroughput());
+  stats["mean_processing_time"] = std::to_string(m_window.getMeanProcessingTime());
+  stats["mean_queueing_delay"] = std::to_string(m_window.getMeanQueueingDelay());
+  stats["utilization_trend"] = std::to_string(m_utilizationForecaster.getTrend());
+  stats["in_flight"] = std::to_string(m_overloadDetector.getInFlight());
+  stats["max_concurrency"] = std::to_string(getMaxConcurrency());
+  stats["overloaded"] = m_overloadDetector.isOverloaded() ? "true" : "false";
+  if (m_weightLearner) {
+    const auto& weights = m_weightLearner->getWeights();
+    stats["learned_processing_weight"] = std::to_string(weights.processing);
+    stats["learned_load_weight"] = std::to_string(weights.load);
+    stats["learned_usage_weight"] = std::to_string(weights.usage);
+    stats["weight_samples"] = std::to_string(m_weightLearner->getNSamples());
+  }
+  return stats;
+}
+
+uint32_t
+FunctionMonitor::getWorkerCapacity() const
+{
+  if (m_options.workerCapacity > 0) {
+    return m_options.workerCapacity;
+  }
+  if (m_latestRecord && m_latestRecord->workers > 0) {
+    return m_latestRecord->workers;
+  }
+  return 1;
+}
+
+uint32_t
+FunctionMonitor::getMaxConcurrency() const
+{
+  if (m_options.maxConcurrency > 0) {
+    return m_options.maxConcurrency;
+  }
+  return getWorkerCapacity();
+}
+
+} // namespace nlsr
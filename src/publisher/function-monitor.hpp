@@ -0,0 +1,171 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_PUBLISHER_FUNCTION_MONITOR_HPP
+#define NLSR_PUBLISHER_FUNCTION_MONITOR_HPP
+
+#include "lsa/name-lsa.hpp"
+#include "overload-detector.hpp"
+#include "sidecar-record.hpp"
+#include "sidecar-stats-window.hpp"
+#include "trend-forecaster.hpp"
+#include "weight-learner.hpp"
+
+#include <boost/noncopyable.hpp>
+
+#include <map>
+#include <optional>
+#include <string>
+
+namespace nlsr {
+
+/*! \brief Aggregates the sidecar records of one Service Function hosted on this router.
+
+  Each function has its own utilization window, utilization trend, overload state and, if
+  enabled, weight learner, so functions sharing a router do not mix their statistics. The records are parsed once by the log source they come from and
+  handed to the FunctionMonitor of their function (see SidecarStatsHandler).
+ */
+class FunctionMonitor : boost::noncopyable
+{
+public:
+  struct Options
+  {
+    /// length of the utilization window, in microseconds
+    int64_t windowLength = 1000000;
+    /// requests served in parallel; 0 takes the value advertised by the sidecar
+    uint32_t workerCapacity = 0;
+    /// requests that may be in flight; 0 takes the worker capacity
+    uint32_t maxConcurrency = 0;
+    double processingWeight = 0.4;
+    double loadWeight = 0.4;
+    double usageWeight = 0.2;
+    double latencyWeight = 0.0;
+    OverloadDetector::Options overload;
+    /// set to learn the processing, load and usage weights
+    std::optional<WeightLearner::Options> weightLearning;
+  };
+
+  /*! \param prefix The function prefix the Service Function info is advertised for
+      \param callName The call_name of the records of this function; empty for all records
+                      of its log source
+   */
+  FunctionMonitor(const ndn::Name& prefix, const std::string& callName, const Options& options);
+
+  const ndn::Name&
+  getPrefix() const
+  {
+    return m_prefix;
+  }
+
+  const std::string&
+  getCallName() const
+  {
+    return m_callName;
+  }
+
+  /*! \brief Adds a record of this function.
+    \return whether the overload state changed
+   */
+  bool
+  add(const SidecarRecord& record);
+
+  /*! \brief Ends an overload if no request completed recently, see OverloadDetector::expire().
+    \param now Current time, in microseconds since the Unix epoch
+    \return whether the overload state changed
+   */
+  bool
+  expire(int64_t now);
+
+  /*! \brief Computes the Service Function info over the window ending at the latest record.
+
+    utilization is the share of the worker capacity in use over the window, load the share
+    of the mean response time spent queueing in the sidecar, and usageCount the number of
+    requests per second. If the latest record is older than twice the window, the info
+    has no traffic.
+   */
+  ServiceFunctionInfo
+  makeServiceFunctionInfo(ndn::time::system_clock::time_point now) const;
+
+  /*! \brief Computes the Service Function info to advertise, and feeds it to the
+             utilization trend and the weight learner.
+   */
+  ServiceFunctionInfo
+  update(ndn::time::system_clock::time_point now);
+
+  /*! \brief Returns the statistics listed in the sidecar-stats dataset.
+   */
+  std::map<std::string, std::string>
+  getStats() const;
+
+  /*! \brief Returns the number of requests the function serves in parallel.
+
+    The configured worker capacity takes precedence over the value advertised in the log.
+   */
+  uint32_t
+  getWorkerCapacity() const;
+
+  /*! \brief Returns the number of requests the function may have in flight.
+
+    The configured max-concurrency takes precedence over the worker capacity.
+   */
+  uint32_t
+  getMaxConcurrency() const;
+
+  const std::optional<SidecarRecord>&
+  getLatestRecord() const
+  {
+    return m_latestRecord;
+  }
+
+  const SidecarStatsWindow&
+  getWindow() const
+  {
+    return m_window;
+  }
+
+  const OverloadDetector&
+  getOverloadDetector() const
+  {
+    return m_overloadDetector;
+  }
+
+  const std::optional<WeightLearner>&
+  getWeightLearner() const
+  {
+    return m_weightLearner;
+  }
+
+private:
+  ndn::Name m_prefix;
+  std::string m_callName;
+  Options m_options;
+  std::optional<SidecarRecord> m_latestRecord;
+  SidecarStatsWindow m_window;
+  TrendForecaster m_utilizationForecaster{TrendForecaster::Options{}};
+  OverloadDetector m_overloadDetector;
+  std::optional<WeightLearner> m_weightLearner;
+  /// records added since the weight learner took its last sample
+  size_t m_nUnlearnedRecords = 0;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_PUBLISHER_FUNCTION_MONITOR_HPP
@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "latency-sketch.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace nlsr {
+
+constexpr int64_t SUB_BUCKET_COUNT = int64_t(1) << LatencySketch::SUB_BUCKET_BITS;
+
+uint32_t
+LatencySketch::getBinIndex(int64_t value)
+{
+  if (value < SUB_BUCKET_COUNT) {
+    return static_cast<uint32_t>(value);
+  }
+
+  // the bins of [2^(SUB_BUCKET_BITS + shift), 2^(SUB_BUCKET_BITS + shift + 1)) are
+  // 2^shift wide and follow those of the previous power of two
+  int msb = 63 - __builtin_clzll(static_cast<uint64_t>(value));
+  int shift = msb - SUB_BUCKET_BITS;
+  return static_cast<uint32_t>(shift * SUB_BUCKET_COUNT + (value >> shift));
+}
+
+int64_t
+LatencySketch::getBinValue(uint32_t index)
+{
+  if (index < 2 * SUB_BUCKET_COUNT) {
+    return index;
+  }
+
+  int shift = static_cast<int>(index / SUB_BUCKET_COUNT) - 1;
+  int64_t lower = (static_cast<int64_t>(index) - shift * SUB_BUCKET_COUNT) << shift;
+  return lower + ((int64_t(1) << shift) - 1) / 2;
+}
+
+void
+LatencySketch::record(int64_t value, uint64_t count)
+{
+  if (value < 0 || count == 0) {
+    return;
+  }
+  m_bins[getBinIndex(value)] += count;
+  m_count += count;
+}
+
+void
+LatencySketch::merge(const LatencySketch& other)
+{
+  for (const auto& [index, count] : other.m_bins) {
+    m_bins[index] += count;
+  }
+  m_count += other.m_count;
+}
+
+void
+LatencySketch::subtract(const LatencySketch& other)
+{
+  for (const auto& [index, count] : other.m_bins) {
+    auto it = m_bins.find(index);
+    if (it == m_bins.end()) {
+      continue;
+    }
+    if (it->second <= count) {
+      m_bins.erase(it);
+    }
+    else {
+      it->second -= count;
+    }
+  }
+  m_count -= std::min(m_count, other.m_count);
+}
+
+void
+LatencySketch::clear()
+{
+  m_bins.clear();
+  m_count = 0;
+}
+
+int64_t
+LatencySketch::getQuantile(double q) const
+{
+  if (m_count == 0) {
+    return 0;
+  }
+
+  q = std::clamp(q, 0.0, 1.0);
+  auto rank = std::max<uint64_t>(static_cast<uint64_t>(std::ceil(q * m_count)), 1);
+  uint64_t seen = 0;
+  for (const auto& [index, count] : m_bins) {
+    seen += count;
+    if (seen >= rank) {
+      return getBinValue(index);
+    }
+  }
+  return getBinValue(m_bins.rbegin()->first);
+}
+
+} // namespace nlsr
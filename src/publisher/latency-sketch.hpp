@@ -0,0 +1,96 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_PUBLISHER_LATENCY_SKETCH_HPP
+#define NLSR_PUBLISHER_LATENCY_SKETCH_HPP
+
+#include <cstdint>
+#include <map>
+
+namespace nlsr {
+
+/*! \brief Log-linear histogram of latencies, in the manner of an HDR histogram.
+
+  Values below <tt>2^SUB_BUCKET_BITS</tt> are counted exactly. Larger values share a bin
+  with the values that have the same <tt>SUB_BUCKET_BITS + 1</tt> leading bits, so a
+  quantile is off by at most <tt>2^-SUB_BUCKET_BITS</tt> (about 3%) of its value. Bins
+  are kept sparsely; a sketch of one window typically holds a few dozen of them.
+
+  Sketches are mergeable: the sketch of a union of samples is the sum of the sketches of
+  its parts. A part that was merged in can be subtracted again, which lets a sliding
+  window keep one sketch per time bucket and one for the whole window.
+ */
+class LatencySketch
+{
+public:
+  static constexpr int SUB_BUCKET_BITS = 5;
+
+  /*! \brief Adds \p count samples of \p value. Negative values are ignored.
+   */
+  void
+  record(int64_t value, uint64_t count = 1);
+
+  void
+  merge(const LatencySketch& other);
+
+  /*! \brief Removes the samples of \p other, which must have been merged into this sketch.
+   */
+  void
+  subtract(const LatencySketch& other);
+
+  void
+  clear();
+
+  uint64_t
+  getCount() const
+  {
+    return m_count;
+  }
+
+  bool
+  empty() const
+  {
+    return m_count == 0;
+  }
+
+  /*! \brief Returns the value below or at which a fraction \p q of the samples lie.
+
+    \p q is clamped to [0.0, 1.0]. The midpoint of the bin holding the quantile is returned.
+    \return the quantile, or 0 if the sketch is empty
+   */
+  int64_t
+  getQuantile(double q) const;
+
+private:
+  static uint32_t
+  getBinIndex(int64_t value);
+
+  static int64_t
+  getBinValue(uint32_t index);
+
+private:
+  std::map<uint32_t, uint64_t> m_bins;
+  uint64_t m_count = 0;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_PUBLISHER_LATENCY_SKETCH_HPP
@@ -0,0 +1,78 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_PUBLISHER_LATEST_VALUE_SLOT_HPP
+#define NLSR_PUBLISHER_LATEST_VALUE_SLOT_HPP
+
+#include <boost/noncopyable.hpp>
+
+#include <atomic>
+#include <memory>
+
+namespace nlsr {
+
+/*! \brief Hands the latest value from one producer thread to one consumer thread.
+
+  The slot holds at most one value: a value put before the previous one was taken
+  replaces it, so a slow consumer only sees the newest value and the producer never
+  waits. Both sides are a single atomic exchange.
+
+  put() tells the producer whether the slot was empty. Only then does the consumer need
+  to be woken up; otherwise the wakeup sent with the previous value is still pending and
+  will take the new one.
+ */
+template<typename T>
+class LatestValueSlot : boost::noncopyable
+{
+public:
+  LatestValueSlot() = default;
+
+  ~LatestValueSlot()
+  {
+    delete m_value.load(std::memory_order_acquire);
+  }
+
+  /*! \brief Puts \p value in the slot, dropping the value not taken yet if any.
+    \return whether the slot was empty
+   */
+  bool
+  put(std::unique_ptr<T> value)
+  {
+    std::unique_ptr<T> replaced(m_value.exchange(value.release(), std::memory_order_acq_rel));
+    return replaced == nullptr;
+  }
+
+  /*! \brief Takes the value out of the slot.
+    \return the latest value put, or nullptr if it was already taken
+   */
+  std::unique_ptr<T>
+  take()
+  {
+    return std::unique_ptr<T>(m_value.exchange(nullptr, std::memory_order_acq_rel));
+  }
+
+private:
+  std::atomic<T*> m_value{nullptr};
+};
+
+} // namespace nlsr
+
+#endif // NLSR_PUBLISHER_LATEST_VALUE_SLOT_HPP
@@ -0,0 +1,97 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "overload-detector.hpp"
+
+#include <algorithm>
+#include <tuple>
+
+namespace nlsr {
+
+namespace {
+
+/// how long a completed request is kept to count it as in flight at later arrivals;
+/// a request that arrived longer than this before a later one completed is not counted
+constexpr int64_t MAX_REQUEST_AGE = 60000000;
+
+} // anonymous namespace
+
+OverloadDetector::OverloadDetector(const Options& options)
+  : m_options(options)
+{
+  m_options.clearRatio = std::clamp(m_options.clearRatio, 0.0, 1.0);
+}
+
+bool
+OverloadDetector::add(const SidecarRecord& record, uint32_t maxConcurrency)
+{
+  // the sidecar span includes the time spent waiting for a worker
+  int64_t arrival = record.sidecarInTime;
+  int64_t completion = record.sidecarOutTime;
+  if (arrival == 0 || completion < arrival) {
+    auto interval = record.getProcessingInterval();
+    if (!interval) {
+      return false;
+    }
+    std::tie(arrival, completion) = *interval;
+  }
+
+  // keep the requests ordered by completion; they are mostly logged in that order
+  auto pos = std::find_if(m_requests.rbegin(), m_requests.rend(),
+                          [completion] (const auto& request) { return request.second <= completion; });
+  m_requests.insert(pos.base(), {arrival, completion});
+  m_latestEnd = std::max(m_latestEnd, completion);
+  while (m_requests.front().second < m_latestEnd - MAX_REQUEST_AGE) {
+    m_requests.pop_front();
+  }
+
+  // only requests completed after the arrival can have been in flight at that time
+  uint32_t inFlight = 0;
+  for (auto it = m_requests.rbegin(); it != m_requests.rend() && it->second > arrival; ++it) {
+    if (it->first <= arrival) {
+      ++inFlight;
+    }
+  }
+  m_inFlight = inFlight;
+
+  double limit = std::max<uint32_t>(maxConcurrency, 1);
+  bool wasOverloaded = m_isOverloaded;
+  if (!m_isOverloaded && m_inFlight > limit) {
+    m_isOverloaded = true;
+  }
+  else if (m_isOverloaded && m_inFlight <= m_options.clearRatio * limit) {
+    m_isOverloaded = false;
+  }
+  return m_isOverloaded != wasOverloaded;
+}
+
+bool
+OverloadDetector::expire(int64_t now)
+{
+  if (!m_isOverloaded || now - m_latestEnd < m_options.quietTime) {
+    return false;
+  }
+  m_isOverloaded = false;
+  m_inFlight = 0;
+  return true;
+}
+
+} // namespace nlsr
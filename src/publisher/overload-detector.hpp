@@ -0,0 +1,97 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_PUBLISHER_OVERLOAD_DETECTOR_HPP
+#define NLSR_PUBLISHER_OVERLOAD_DETECTOR_HPP
+
+#include "sidecar-record.hpp"
+
+#include <deque>
+#include <utility>
+
+namespace nlsr {
+
+/*! \brief Decides whether a Service Function instance has more requests in flight than
+           it may serve, with hysteresis.
+
+  A request counts as in flight from the time the sidecar received it until it answered,
+  so both the requests being served and those waiting for a worker count. Requests are
+  logged as they complete, so the number in flight is taken at the arrival of each logged
+  request, over the requests logged so far. The instance becomes overloaded as soon as
+  this number exceeds the limit, and stops being overloaded when it drops to
+  Options::clearRatio of the limit, or when no request completed for Options::quietTime.
+  The latter also clears an instance that receivers stopped sending requests to.
+
+  All times are in microseconds.
+ */
+class OverloadDetector
+{
+public:
+  struct Options
+  {
+    /// in-flight requests, as a fraction of the limit, at or below which an overload ends
+    double clearRatio = 0.8;
+    /// time without any completed request after which an overload ends
+    int64_t quietTime = 1000000;
+  };
+
+  explicit
+  OverloadDetector(const Options& options);
+
+  /*! \brief Adds a completed request.
+    \param maxConcurrency number of requests that may be in flight; at least 1 is used
+    \return whether the overload state changed
+   */
+  bool
+  add(const SidecarRecord& record, uint32_t maxConcurrency);
+
+  /*! \brief Ends an overload if no request completed for Options::quietTime before \p now.
+    \return whether the overload state changed
+   */
+  bool
+  expire(int64_t now);
+
+  bool
+  isOverloaded() const
+  {
+    return m_isOverloaded;
+  }
+
+  /*! \brief Returns the number of requests in flight at the arrival of the latest request.
+   */
+  uint32_t
+  getInFlight() const
+  {
+    return m_inFlight;
+  }
+
+private:
+  Options m_options;
+  /// arrival and completion of the requests that may still overlap a later one, by completion
+  std::deque<std::pair<int64_t, int64_t>> m_requests;
+  int64_t m_latestEnd = 0;
+  uint32_t m_inFlight = 0;
+  bool m_isOverloaded = false;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_PUBLISHER_OVERLOAD_DETECTOR_HPP
@@ -0,0 +1,185 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sidecar-log-reader.hpp"
+#include "logger.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace nlsr {
+
+INIT_LOGGER(SidecarLogReader);
+
+namespace {
+
+constexpr size_t READ_CHUNK_SIZE = 64 * 1024;
+
+} // anonymous namespace
+
+SidecarLogReader::SidecarLogReader(std::string path)
+  : m_path(std::move(path))
+{
+}
+
+SidecarLogReader::~SidecarLogReader()
+{
+  closeFile();
+}
+
+size_t
+SidecarLogReader::readNewLines(const std::function<void(std::string_view)>& onLine)
+{
+  size_t nLines = 0;
+
+  if (m_fd >= 0) {
+    struct stat pathStat;
+    bool isRotated = ::stat(m_path.data(), &pathStat) != 0 ||
+                     pathStat.st_dev != m_device || pathStat.st_ino != m_inode;
+    if (isRotated) {
+      // finish the old file before switching; lines written to it after the rotation
+      // would be lost otherwise
+      nLines += readToEnd(onLine);
+      NLSR_LOG_INFO("Log file " << m_path << " was rotated");
+      closeFile();
+    }
+  }
+
+  if (m_fd < 0 && !openFile()) {
+    return nLines;
+  }
+
+  struct stat st;
+  if (::fstat(m_fd, &st) != 0) {
+    NLSR_LOG_WARN("Cannot stat log file " << m_path << ": " << std::strerror(errno));
+    closeFile();
+    return nLines;
+  }
+  if (static_cast<uint64_t>(st.st_size) < m_offset) {
+    NLSR_LOG_INFO("Log file " << m_path << " was truncated, reading from the beginning");
+    m_offset = 0;
+    m_partialLine.clear();
+    m_isDroppingLine = false;
+  }
+
+  if (static_cast<uint64_t>(st.st_size) > m_offset) {
+    nLines += readToEnd(onLine);
+  }
+  return nLines;
+}
+
+bool
+SidecarLogReader::openFile()
+{
+  m_fd = ::open(m_path.data(), O_RDONLY | O_CLOEXEC);
+  if (m_fd < 0) {
+    if (errno != ENOENT) {
+      NLSR_LOG_WARN("Cannot open log file " << m_path << ": " << std::strerror(errno));
+    }
+    return false;
+  }
+
+  struct stat st;
+  if (::fstat(m_fd, &st) != 0) {
+    NLSR_LOG_WARN("Cannot stat log file " << m_path << ": " << std::strerror(errno));
+    closeFile();
+    return false;
+  }
+  m_device = st.st_dev;
+  m_inode = st.st_ino;
+  m_offset = 0;
+  m_partialLine.clear();
+  m_isDroppingLine = false;
+  return true;
+}
+
+void
+SidecarLogReader::closeFile()
+{
+  if (m_fd >= 0) {
+    ::close(m_fd);
+    m_fd = -1;
+  }
+}
+
+size_t
+SidecarLogReader::readToEnd(const std::function<void(std::string_view)>& onLine)
+{
+  size_t nLines = 0;
+  char buffer[READ_CHUNK_SIZE];
+
+  while (true) {
+    ssize_t nRead = ::pread(m_fd, buffer, sizeof(buffer), static_cast<off_t>(m_offset));
+    if (nRead < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      NLSR_LOG_WARN("Cannot read log file " << m_path << ": " << std::strerror(errno));
+      break;
+    }
+    if (nRead == 0) {
+      break;
+    }
+    m_offset += static_cast<uint64_t>(nRead);
+
+    const char* pos = buffer;
+    const char* end = buffer + nRead;
+    while (pos < end) {
+      auto newline = static_cast<const char*>(std::memchr(pos, '\n', end - pos));
+      if (m_isDroppingLine) {
+        // the rest of a dropped line must not be taken for a line of its own
+        if (newline == nullptr) {
+          break;
+        }
+        m_isDroppingLine = false;
+        pos = newline + 1;
+        continue;
+      }
+      if (newline == nullptr) {
+        m_partialLine.append(pos, end);
+        if (m_partialLine.size() > MAX_LINE_LENGTH) {
+          NLSR_LOG_WARN("Dropping a line longer than " << MAX_LINE_LENGTH << " bytes in " << m_path);
+          m_partialLine.clear();
+          m_isDroppingLine = true;
+        }
+        break;
+      }
+
+      if (m_partialLine.empty()) {
+        onLine(std::string_view(pos, newline - pos));
+      }
+      else {
+        m_partialLine.append(pos, newline);
+        onLine(m_partialLine);
+        m_partialLine.clear();
+      }
+      ++nLines;
+      pos = newline + 1;
+    }
+  }
+  return nLines;
+}
+
+} // namespace nlsr
@@ -0,0 +1,106 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_PUBLISHER_SIDECAR_LOG_READER_HPP
+#define NLSR_PUBLISHER_SIDECAR_LOG_READER_HPP
+
+#include "test-access-control.hpp"
+
+#include <boost/noncopyable.hpp>
+
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include <sys/types.h>
+
+namespace nlsr {
+
+/*! \brief Reads the lines appended to a log file since the previous read.
+
+  The reader keeps the file open and remembers its inode and how many bytes it has
+  consumed. Each readNewLines() call reads only the bytes past that offset and passes
+  on the complete lines among them; a trailing partial line is kept until its newline
+  arrives.
+
+  If the file shrinks below the offset, it was truncated in place and reading starts
+  over at its beginning. If the path refers to another inode, the log was rotated: the
+  rest of the old file is read first, then the reader switches to the new file.
+ */
+class SidecarLogReader : boost::noncopyable
+{
+public:
+  explicit
+  SidecarLogReader(std::string path);
+
+  ~SidecarLogReader();
+
+  /*! \brief Passes every complete line appended since the previous call to \p onLine.
+
+    The line is passed without its terminating newline. A missing file is not an error;
+    it is picked up once it appears.
+    \return the number of lines passed to \p onLine
+   */
+  size_t
+  readNewLines(const std::function<void(std::string_view)>& onLine);
+
+  const std::string&
+  getPath() const
+  {
+    return m_path;
+  }
+
+  /*! \brief Returns the number of bytes of the current file consumed so far.
+   */
+  uint64_t
+  getOffset() const
+  {
+    return m_offset;
+  }
+
+private:
+  bool
+  openFile();
+
+  void
+  closeFile();
+
+  size_t
+  readToEnd(const std::function<void(std::string_view)>& onLine);
+
+public:
+  /// a line longer than this is dropped up to its newline instead of being buffered further
+  static constexpr size_t MAX_LINE_LENGTH = 1024 * 1024;
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  std::string m_path;
+  int m_fd = -1;
+  dev_t m_device = 0;
+  ino_t m_inode = 0;
+  uint64_t m_offset = 0;
+  std::string m_partialLine;
+  /// whether the bytes up to the next newline belong to a dropped line
+  bool m_isDroppingLine = false;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_PUBLISHER_SIDECAR_LOG_READER_HPP
@@ -0,0 +1,196 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sidecar-log-watcher.hpp"
+#include "logger.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace nlsr {
+
+INIT_LOGGER(SidecarLogWatcher);
+
+namespace {
+
+// changes of a file are reported on its directory watch together with the file name
+constexpr uint32_t WATCH_MASK = IN_MODIFY | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE |
+                                IN_MOVED_FROM | IN_MOVED_TO;
+
+} // anonymous namespace
+
+SidecarLogWatcher::SidecarLogWatcher(boost::asio::io_context& io, ndn::Scheduler& scheduler,
+                                     const std::string& path, const Options& options,
+                                     std::function<void()> onChange)
+  : m_options(options)
+  , m_onChange(std::move(onChange))
+  , m_scheduler(scheduler)
+  , m_inotify(io)
+{
+  std::filesystem::path filePath(path);
+  m_dirPath = filePath.has_parent_path() ? filePath.parent_path().string() : ".";
+  m_fileName = filePath.filename().string();
+}
+
+SidecarLogWatcher::~SidecarLogWatcher()
+{
+  boost::system::error_code ec;
+  m_inotify.close(ec);
+}
+
+void
+SidecarLogWatcher::start()
+{
+  if (m_isStarted) {
+    return;
+  }
+  m_isStarted = true;
+
+  if (m_options.useInotify && startInotify()) {
+    NLSR_LOG_INFO("Watching " << m_dirPath << "/" << m_fileName << " with inotify, minimum update interval "
+                  << m_options.minUpdateInterval);
+    return;
+  }
+  startPolling();
+}
+
+bool
+SidecarLogWatcher::startInotify()
+{
+  int fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (fd < 0) {
+    NLSR_LOG_WARN("inotify is not available: " << std::strerror(errno));
+    return false;
+  }
+  if (::inotify_add_watch(fd, m_dirPath.data(), WATCH_MASK) < 0) {
+    NLSR_LOG_WARN("Cannot watch " << m_dirPath << ": " << std::strerror(errno));
+    ::close(fd);
+    return false;
+  }
+
+  m_inotify.assign(fd);
+  readEvents();
+  return true;
+}
+
+void
+SidecarLogWatcher::startPolling()
+{
+  NLSR_LOG_INFO("Polling " << m_dirPath << "/" << m_fileName << " every " << m_options.pollInterval);
+  schedulePoll();
+}
+
+void
+SidecarLogWatcher::schedulePoll()
+{
+  m_pollEvent = m_scheduler.schedule(m_options.pollInterval, [this] {
+    m_onChange();
+    schedulePoll();
+  });
+}
+
+void
+SidecarLogWatcher::readEvents()
+{
+  m_inotify.async_read_some(boost::asio::buffer(m_buffer),
+    [this] (const boost::system::error_code& error, size_t nBytes) {
+      if (error == boost::asio::error::operation_aborted) {
+        // the watcher may have been destroyed
+        return;
+      }
+      if (error) {
+        NLSR_LOG_WARN("Cannot read inotify events: " << error.message());
+        boost::system::error_code ec;
+        m_inotify.close(ec);
+        startPolling();
+        return;
+      }
+
+      handleEvents(nBytes);
+      if (m_inotify.is_open()) {
+        readEvents();
+      }
+    });
+}
+
+void
+SidecarLogWatcher::handleEvents(size_t nBytes)
+{
+  bool isChanged = false;
+  size_t offset = 0;
+  while (offset + sizeof(inotify_event) <= nBytes) {
+    inotify_event event;
+    std::memcpy(&event, m_buffer + offset, sizeof(event));
+    const char* name = m_buffer + offset + sizeof(inotify_event);
+    offset += sizeof(inotify_event) + event.len;
+
+    if (event.mask & IN_Q_OVERFLOW) {
+      // events were dropped, any of them could have been for the log file
+      isChanged = true;
+    }
+    else if (event.mask & IN_IGNORED) {
+      NLSR_LOG_WARN("Watch on " << m_dirPath << " was removed");
+      boost::system::error_code ec;
+      m_inotify.close(ec);
+      startPolling();
+      return;
+    }
+    else if (event.len > 0 && m_fileName == name) {
+      isChanged = true;
+    }
+  }
+
+  if (isChanged) {
+    onFileChanged();
+  }
+}
+
+void
+SidecarLogWatcher::onFileChanged()
+{
+  if (m_isNotifyPending) {
+    return;
+  }
+
+  auto earliest = m_lastNotify + m_options.minUpdateInterval;
+  auto now = ndn::time::steady_clock::now();
+  if (now >= earliest) {
+    notify();
+  }
+  else {
+    m_isNotifyPending = true;
+    m_notifyEvent = m_scheduler.schedule(earliest - now, [this] { notify(); });
+  }
+}
+
+void
+SidecarLogWatcher::notify()
+{
+  m_isNotifyPending = false;
+  m_lastNotify = ndn::time::steady_clock::now();
+  m_onChange();
+}
+
+} // namespace nlsr
@@ -0,0 +1,118 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_PUBLISHER_SIDECAR_LOG_WATCHER_HPP
+#define NLSR_PUBLISHER_SIDECAR_LOG_WATCHER_HPP
+
+#include "common.hpp"
+#include "test-access-control.hpp"
+
+#include <ndn-cxx/util/scheduler.hpp>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/posix/stream_descriptor.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <functional>
+
+namespace nlsr {
+
+/*! \brief Calls back when a log file is appended to, truncated, or rotated.
+
+  The watcher uses an inotify watch on the directory of the file, so it also notices when
+  the file is replaced or created. Callbacks are at least Options::minUpdateInterval apart;
+  events within that interval are coalesced into one callback at its end.
+
+  If inotify is not available, the watcher falls back to calling back every
+  Options::pollInterval and leaves it to the callback to find out whether the file changed.
+ */
+class SidecarLogWatcher : boost::noncopyable
+{
+public:
+  struct Options
+  {
+    ndn::time::milliseconds minUpdateInterval = 500_ms;
+    ndn::time::milliseconds pollInterval = 5_s;
+    /// set to false to always poll
+    bool useInotify = true;
+  };
+
+  SidecarLogWatcher(boost::asio::io_context& io, ndn::Scheduler& scheduler,
+                    const std::string& path, const Options& options,
+                    std::function<void()> onChange);
+
+  ~SidecarLogWatcher();
+
+  /*! \brief Starts watching; does nothing if already started.
+   */
+  void
+  start();
+
+  /*! \brief Returns whether changes are detected with inotify rather than by polling.
+   */
+  bool
+  isEventDriven() const
+  {
+    return m_inotify.is_open();
+  }
+
+private:
+  bool
+  startInotify();
+
+  void
+  startPolling();
+
+  void
+  schedulePoll();
+
+  void
+  readEvents();
+
+  void
+  handleEvents(size_t nBytes);
+
+  void
+  onFileChanged();
+
+  void
+  notify();
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  std::string m_dirPath;
+  std::string m_fileName;
+  Options m_options;
+  std::function<void()> m_onChange;
+
+  ndn::Scheduler& m_scheduler;
+  boost::asio::posix::stream_descriptor m_inotify;
+  alignas(8) char m_buffer[4096];
+  bool m_isStarted = false;
+
+  ndn::scheduler::ScopedEventId m_pollEvent;
+  ndn::scheduler::ScopedEventId m_notifyEvent;
+  bool m_isNotifyPending = false;
+  ndn::time::steady_clock::time_point m_lastNotify = ndn::time::steady_clock::time_point::min();
+};
+
+} // namespace nlsr
+
+#endif // NLSR_PUBLISHER_SIDECAR_LOG_WATCHER_HPP
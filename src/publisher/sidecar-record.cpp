@@ -0,0 +1,545 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sidecar-record.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <limits>
+
+namespace nlsr {
+
+namespace {
+
+constexpr int64_t MICROSECONDS_PER_SECOND = 1000000;
+constexpr int64_t SECONDS_PER_DAY = 86400;
+constexpr size_t MAX_DEPTH = 8;
+
+enum class Section {
+  TOP,
+  SERVICE_CALL,
+  SIDECAR,
+  OTHER
+};
+
+bool
+isLeapYear(int year)
+{
+  return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+int
+getDaysInMonth(int year, int month)
+{
+  static constexpr int DAYS_IN_MONTH[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  return month == 2 && isLeapYear(year) ? 29 : DAYS_IN_MONTH[month - 1];
+}
+
+/*! \brief Returns the number of days between 1970-01-01 and the given date of the
+           proleptic Gregorian calendar.
+ */
+int64_t
+daysFromCivil(int64_t year, int64_t month, int64_t day)
+{
+  year -= month <= 2;
+  int64_t era = (year >= 0 ? year : year - 399) / 400;
+  int64_t yearOfEra = year - era * 400;
+  int64_t dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+  int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+  return era * 146097 + dayOfEra - 719468;
+}
+
+/*! \brief Inverse of daysFromCivil().
+ */
+void
+civilFromDays(int64_t days, int& year, int& month, int& day)
+{
+  days += 719468;
+  int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+  int64_t dayOfEra = days - era * 146097;
+  int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+  int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+  int64_t monthIndex = (5 * dayOfYear + 2) / 153;
+  day = static_cast<int>(dayOfYear - (153 * monthIndex + 2) / 5 + 1);
+  month = static_cast<int>(monthIndex < 10 ? monthIndex + 3 : monthIndex - 9);
+  year = static_cast<int>(yearOfEra + era * 400 + (month <= 2));
+}
+
+/*! \brief Returns the offset of the local time zone from UTC, in seconds, at the given
+           hour of local time.
+ */
+int64_t
+getUtcOffset(int64_t days, int year, int month, int day, int hour)
+{
+  // Offsets change only at the start of a local hour, and consecutive log lines are
+  // mostly in the same hour
+  thread_local int64_t cachedHour = std::numeric_limits<int64_t>::min();
+  thread_local int64_t cachedOffset = 0;
+
+  int64_t localHour = days * 24 + hour;
+  if (localHour != cachedHour) {
+    std::tm timeinfo{};
+    timeinfo.tm_year = year - 1900;
+    timeinfo.tm_mon = month - 1;
+    timeinfo.tm_mday = day;
+    timeinfo.tm_hour = hour;
+    timeinfo.tm_isdst = -1;
+    std::time_t utc = std::mktime(&timeinfo);
+    if (utc == static_cast<std::time_t>(-1)) {
+      return 0;
+    }
+    cachedOffset = localHour * 3600 - static_cast<int64_t>(utc);
+    cachedHour = localHour;
+  }
+  return cachedOffset;
+}
+
+bool
+parseDigits(std::string_view text, size_t pos, size_t nDigits, int& value)
+{
+  value = 0;
+  for (size_t i = pos; i < pos + nDigits; ++i) {
+    unsigned digit = static_cast<unsigned char>(text[i]) - '0';
+    if (digit > 9) {
+      return false;
+    }
+    value = value * 10 + static_cast<int>(digit);
+  }
+  return true;
+}
+
+bool
+isSpace(char c)
+{
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+std::string_view
+trim(std::string_view text)
+{
+  while (!text.empty() && isSpace(text.front())) {
+    text.remove_prefix(1);
+  }
+  while (!text.empty() && isSpace(text.back())) {
+    text.remove_suffix(1);
+  }
+  return text;
+}
+
+/*! \brief Returns the position of the quote that ends the string starting at \p pos,
+           or std::string_view::npos.
+ */
+size_t
+findClosingQuote(std::string_view line, size_t pos)
+{
+  while (pos < line.size()) {
+    auto quote = static_cast<const char*>(std::memchr(line.data() + pos, '"', line.size() - pos));
+    if (quote == nullptr) {
+      return std::string_view::npos;
+    }
+    size_t quotePos = static_cast<size_t>(quote - line.data());
+    size_t nBackslashes = 0;
+    while (quotePos - nBackslashes > pos && line[quotePos - nBackslashes - 1] == '\\') {
+      ++nBackslashes;
+    }
+    if (nBackslashes % 2 == 0) {
+      return quotePos;
+    }
+    pos = quotePos + 1;
+  }
+  return std::string_view::npos;
+}
+
+/*! \brief Parses the four hexadecimal digits of a \\u escape starting at \p pos.
+ */
+std::optional<uint32_t>
+parseCodeUnit(std::string_view text, size_t pos)
+{
+  if (pos + 4 > text.size()) {
+    return std::nullopt;
+  }
+  uint32_t value = 0;
+  auto [end, ec] = std::from_chars(text.data() + pos, text.data() + pos + 4, value, 16);
+  if (ec != std::errc() || end != text.data() + pos + 4) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+void
+appendUtf8(std::string& out, uint32_t codePoint)
+{
+  if (codePoint < 0x80) {
+    out += static_cast<char>(codePoint);
+  }
+  else if (codePoint < 0x800) {
+    out += static_cast<char>(0xC0 | (codePoint >> 6));
+    out += static_cast<char>(0x80 | (codePoint & 0x3F));
+  }
+  else if (codePoint < 0x10000) {
+    out += static_cast<char>(0xE0 | (codePoint >> 12));
+    out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (codePoint & 0x3F));
+  }
+  else {
+    out += static_cast<char>(0xF0 | (codePoint >> 18));
+    out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+    out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (codePoint & 0x3F));
+  }
+}
+
+/*! \brief Decodes the escape sequences of the contents of a JSON string.
+
+  A malformed escape sequence is kept as is.
+ */
+std::string
+unescapeString(std::string_view text)
+{
+  if (text.find('\\') == std::string_view::npos) {
+    return std::string(text);
+  }
+
+  std::string out;
+  out.reserve(text.size());
+  for (size_t pos = 0; pos < text.size(); ++pos) {
+    if (text[pos] != '\\' || pos + 1 == text.size()) {
+      out += text[pos];
+      continue;
+    }
+    char escaped = text[pos + 1];
+    switch (escaped) {
+      case '"':
+      case '\\':
+      case '/':
+        out += escaped;
+        break;
+      case 'b':
+        out += '\b';
+        break;
+      case 'f':
+        out += '\f';
+        break;
+      case 'n':
+        out += '\n';
+        break;
+      case 'r':
+        out += '\r';
+        break;
+      case 't':
+        out += '\t';
+        break;
+      case 'u': {
+        auto codeUnit = parseCodeUnit(text, pos + 2);
+        if (!codeUnit) {
+          out += text[pos];
+          continue;
+        }
+        uint32_t codePoint = *codeUnit;
+        size_t length = 6;
+        // a high surrogate followed by a low surrogate encodes a code point above U+FFFF
+        if (codePoint >= 0xD800 && codePoint < 0xDC00 &&
+            text.substr(pos + 6, 2) == "\\u") {
+          auto low = parseCodeUnit(text, pos + 8);
+          if (low && *low >= 0xDC00 && *low < 0xE000) {
+            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (*low - 0xDC00);
+            length = 12;
+          }
+        }
+        appendUtf8(out, codePoint);
+        pos += length - 1;
+        continue;
+      }
+      default:
+        out += text[pos];
+        continue;
+    }
+    ++pos;
+  }
+  return out;
+}
+
+std::optional<uint64_t>
+parseUnsigned(std::string_view text)
+{
+  uint64_t value = 0;
+  auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+  if (ec != std::errc() || end != text.data() + text.size()) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+/*! \brief Stores a field of \p section in \p record.
+  \return whether the field is one of the known fields
+ */
+bool
+setField(SidecarRecord& record, Section section, std::string_view key, std::string_view value,
+         SidecarTimeZone timeZone)
+{
+  auto setTime = [value, timeZone] (int64_t& field) {
+    field = parseSidecarTimestamp(value, timeZone).value_or(0);
+    return true;
+  };
+  auto setSize = [value] (uint64_t& field) {
+    field = parseUnsigned(value).value_or(0);
+    return true;
+  };
+
+  switch (section) {
+    case Section::SERVICE_CALL:
+      if (key == "in_time") {
+        return setTime(record.serviceCallInTime);
+      }
+      if (key == "out_time") {
+        return setTime(record.serviceCallOutTime);
+      }
+      if (key == "in_datasize") {
+        return setSize(record.inDataSize);
+      }
+      if (key == "out_datasize") {
+        return setSize(record.outDataSize);
+      }
+      if (key == "call_name") {
+        record.callName = unescapeString(value);
+        return true;
+      }
+      return false;
+    case Section::SIDECAR:
+      if (key == "in_time") {
+        return setTime(record.sidecarInTime);
+      }
+      if (key == "out_time") {
+        return setTime(record.sidecarOutTime);
+      }
+      if (key == "workers") {
+        record.workers = static_cast<uint32_t>(std::min<uint64_t>(parseUnsigned(value).value_or(0), UINT32_MAX));
+        return true;
+      }
+      return false;
+    case Section::TOP:
+      if (key == "sfc_time") {
+        return setTime(record.sfcTime);
+      }
+      return false;
+    case Section::OTHER:
+      return false;
+  }
+  return false;
+}
+
+} // anonymous namespace
+
+std::optional<std::pair<int64_t, int64_t>>
+SidecarRecord::getProcessingInterval() const
+{
+  if (serviceCallInTime != 0 && serviceCallOutTime != 0) {
+    return std::pair(serviceCallInTime, std::max(serviceCallOutTime, serviceCallInTime));
+  }
+  if (sidecarInTime != 0 && sidecarOutTime != 0) {
+    return std::pair(sidecarInTime, std::max(sidecarOutTime, sidecarInTime));
+  }
+  return std::nullopt;
+}
+
+std::optional<SidecarRecord>
+parseSidecarRecord(std::string_view line, SidecarTimeZone timeZone)
+{
+  line = trim(line);
+  if (line.size() < 2 || line.front() != '{' || line.back() != '}') {
+    return std::nullopt;
+  }
+
+  SidecarRecord record;
+  bool hasField = false;
+  Section sections[MAX_DEPTH] = {Section::TOP};
+  size_t depth = 0;
+
+  auto enterObject = [&] (Section section) {
+    ++depth;
+    if (depth < MAX_DEPTH) {
+      sections[depth] = depth == 1 ? section : Section::OTHER;
+    }
+  };
+  auto currentSection = [&] {
+    return depth < MAX_DEPTH ? sections[depth] : Section::OTHER;
+  };
+
+  size_t pos = 1;
+  size_t end = line.size() - 1;
+  while (pos < end) {
+    char c = line[pos];
+    if (c == '{') {
+      enterObject(Section::OTHER);
+      ++pos;
+      continue;
+    }
+    if (c == '}') {
+      if (depth == 0) {
+        // the top-level object closed early; the rest of the line is not part of it
+        break;
+      }
+      --depth;
+      ++pos;
+      continue;
+    }
+    if (c != '"') {
+      ++pos;
+      continue;
+    }
+
+    // a string; it is a key if followed by a colon
+    size_t keyEnd = findClosingQuote(line, pos + 1);
+    if (keyEnd == std::string_view::npos || keyEnd >= end) {
+      break;
+    }
+    std::string_view key = line.substr(pos + 1, keyEnd - pos - 1);
+    pos = keyEnd + 1;
+    while (pos < end && isSpace(line[pos])) {
+      ++pos;
+    }
+    if (pos >= end || line[pos] != ':') {
+      continue;
+    }
+    ++pos;
+    while (pos < end && isSpace(line[pos])) {
+      ++pos;
+    }
+    if (pos >= end) {
+      break;
+    }
+
+    std::string_view value;
+    if (line[pos] == '{') {
+      if (key == "service_call") {
+        enterObject(Section::SERVICE_CALL);
+      }
+      else if (key == "sidecar") {
+        enterObject(Section::SIDECAR);
+      }
+      else {
+        enterObject(Section::OTHER);
+      }
+      ++pos;
+      continue;
+    }
+    else if (line[pos] == '"') {
+      size_t valueEnd = findClosingQuote(line, pos + 1);
+      if (valueEnd == std::string_view::npos || valueEnd >= end) {
+        break;
+      }
+      value = line.substr(pos + 1, valueEnd - pos - 1);
+      pos = valueEnd + 1;
+    }
+    else {
+      size_t valueEnd = pos;
+      while (valueEnd < end && line[valueEnd] != ',' && line[valueEnd] != '}' && line[valueEnd] != ']') {
+        ++valueEnd;
+      }
+      value = trim(line.substr(pos, valueEnd - pos));
+      pos = valueEnd;
+    }
+
+    if (!value.empty() && setField(record, currentSection(), key, value, timeZone)) {
+      hasField = true;
+    }
+  }
+
+  if (!hasField) {
+    return std::nullopt;
+  }
+  return record;
+}
+
+std::optional<int64_t>
+parseSidecarTimestamp(std::string_view timestamp, SidecarTimeZone timeZone)
+{
+  // YYYY-MM-DD HH:MM:SS[.ffffff]
+  if (timestamp.size() < 19 || timestamp[4] != '-' || timestamp[7] != '-' ||
+      (timestamp[10] != ' ' && timestamp[10] != 'T') || timestamp[13] != ':' || timestamp[16] != ':') {
+    return std::nullopt;
+  }
+
+  int year, month, day, hour, minute, second;
+  if (!parseDigits(timestamp, 0, 4, year) || !parseDigits(timestamp, 5, 2, month) ||
+      !parseDigits(timestamp, 8, 2, day) || !parseDigits(timestamp, 11, 2, hour) ||
+      !parseDigits(timestamp, 14, 2, minute) || !parseDigits(timestamp, 17, 2, second)) {
+    return std::nullopt;
+  }
+  if (month < 1 || month > 12 || day < 1 || day > getDaysInMonth(year, month) ||
+      hour > 23 || minute > 59 || second > 60) {
+    return std::nullopt;
+  }
+
+  int64_t microseconds = 0;
+  if (timestamp.size() > 19) {
+    if (timestamp[19] != '.' || timestamp.size() == 20) {
+      return std::nullopt;
+    }
+    int64_t scale = MICROSECONDS_PER_SECOND / 10;
+    for (size_t i = 20; i < timestamp.size(); ++i) {
+      unsigned digit = static_cast<unsigned char>(timestamp[i]) - '0';
+      if (digit > 9) {
+        return std::nullopt;
+      }
+      microseconds += digit * scale;
+      scale /= 10;
+    }
+  }
+
+  int64_t days = daysFromCivil(year, month, day);
+  int64_t seconds = days * SECONDS_PER_DAY + hour * 3600 + minute * 60 + second;
+  if (timeZone == SidecarTimeZone::LOCAL) {
+    seconds -= getUtcOffset(days, year, month, day, hour);
+  }
+  return seconds * MICROSECONDS_PER_SECOND + microseconds;
+}
+
+std::string
+formatSidecarTimestamp(int64_t timestamp)
+{
+  int64_t seconds = timestamp / MICROSECONDS_PER_SECOND;
+  int64_t microseconds = timestamp % MICROSECONDS_PER_SECOND;
+  if (microseconds < 0) {
+    microseconds += MICROSECONDS_PER_SECOND;
+    --seconds;
+  }
+  int64_t days = seconds / SECONDS_PER_DAY;
+  int64_t secondOfDay = seconds % SECONDS_PER_DAY;
+  if (secondOfDay < 0) {
+    secondOfDay += SECONDS_PER_DAY;
+    --days;
+  }
+
+  int year, month, day;
+  civilFromDays(days, year, month, day);
+
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d %02d:%02d:%02d.%06d", year, month, day,
+                static_cast<int>(secondOfDay / 3600), static_cast<int>(secondOfDay / 60 % 60),
+                static_cast<int>(secondOfDay % 60), static_cast<int>(microseconds));
+  return buffer;
+}
+
+} // namespace nlsr
@@ -0,0 +1,153 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_PUBLISHER_SIDECAR_RECORD_HPP
+#define NLSR_PUBLISHER_SIDECAR_RECORD_HPP
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace nlsr {
+
+/*! \brief The time zone the sidecar writes the timestamps of its log in.
+ */
+enum class SidecarTimeZone {
+  /// the time zone of this host, as set by TZ
+  LOCAL,
+  UTC,
+};
+
+/*! \brief One entry of the sidecar service log.
+
+  A log line is a JSON object such as
+  @code
+  {"service_call": {"call_name": "...", "in_time": "...", "out_time": "...", "port_num": 5000,
+                    "in_datasize": 1024, "out_datasize": 512},
+   "sidecar": {"in_time": "...", "out_time": "...", "workers": 8}, "sfc_time": "...",
+   "host_name": "..."}
+  @endcode
+  Timestamps are kept as microseconds since the Unix epoch; 0 means the field was absent
+  or malformed.
+ */
+struct SidecarRecord
+{
+  int64_t serviceCallInTime = 0;
+  int64_t serviceCallOutTime = 0;
+  int64_t sidecarInTime = 0;
+  int64_t sidecarOutTime = 0;
+  int64_t sfcTime = 0;
+  uint64_t inDataSize = 0;
+  uint64_t outDataSize = 0;
+  /// number of requests the function can serve in parallel, as advertised by the sidecar; 0 if unknown
+  uint32_t workers = 0;
+  /// service_call.call_name, with its escape sequences decoded; empty if absent
+  std::string callName;
+
+  /*! \brief Returns the time the request arrived: the service call in_time if present,
+             otherwise the sidecar in_time.
+   */
+  int64_t
+  getTimestamp() const
+  {
+    return serviceCallInTime != 0 ? serviceCallInTime : sidecarInTime;
+  }
+
+  /*! \brief Returns the interval during which the request was processed.
+
+    The service call times are preferred over the sidecar times.
+    \return the start and end time, or std::nullopt if they are not known
+   */
+  std::optional<std::pair<int64_t, int64_t>>
+  getProcessingInterval() const;
+
+  /*! \brief Returns the processing time in microseconds, or 0 if it is not known.
+   */
+  int64_t
+  getProcessingTime() const
+  {
+    auto interval = getProcessingInterval();
+    return interval ? interval->second - interval->first : 0;
+  }
+
+  /*! \brief Returns the time the request waited in the sidecar before the function
+             started processing it, from the sidecar in_time to the service call in_time.
+    \return the delay in microseconds, or std::nullopt if it is not known
+   */
+  std::optional<int64_t>
+  getQueueingDelay() const
+  {
+    if (sidecarInTime == 0 || serviceCallInTime < sidecarInTime) {
+      return std::nullopt;
+    }
+    return serviceCallInTime - sidecarInTime;
+  }
+
+  /*! \brief Returns the time the sidecar added to the request: the sidecar span minus the
+             service call span, including the queueing delay.
+    \return the overhead in microseconds, or std::nullopt if it is not known
+   */
+  std::optional<int64_t>
+  getSidecarOverhead() const
+  {
+    if (sidecarInTime == 0 || sidecarOutTime < sidecarInTime ||
+        serviceCallInTime == 0 || serviceCallOutTime < serviceCallInTime) {
+      return std::nullopt;
+    }
+    int64_t overhead = (sidecarOutTime - sidecarInTime) - (serviceCallOutTime - serviceCallInTime);
+    if (overhead < 0) {
+      return std::nullopt;
+    }
+    return overhead;
+  }
+};
+
+/*! \brief Parses one line of the sidecar log in a single pass without allocating.
+
+  Unknown fields are skipped, and so are malformed fields.
+  \param timeZone the time zone of the timestamps of the line
+  \return the record, or std::nullopt if the line is not a JSON object or has none of
+          the known fields
+ */
+std::optional<SidecarRecord>
+parseSidecarRecord(std::string_view line, SidecarTimeZone timeZone = SidecarTimeZone::UTC);
+
+/*! \brief Decodes a timestamp of the form "YYYY-MM-DD HH:MM:SS[.ffffff]".
+
+  Fractions with fewer than six digits are scaled; digits beyond the sixth are ignored.
+  A local time is converted with mktime() once per hour of local time, so that a log
+  written in order costs one conversion per hour; the conversion is cached per thread.
+  \param timeZone the time zone \p timestamp is written in
+  \return microseconds since the Unix epoch, or std::nullopt if \p timestamp is malformed
+ */
+std::optional<int64_t>
+parseSidecarTimestamp(std::string_view timestamp, SidecarTimeZone timeZone = SidecarTimeZone::UTC);
+
+/*! \brief Formats microseconds since the Unix epoch as "YYYY-MM-DD HH:MM:SS.ffffff" (UTC).
+ */
+std::string
+formatSidecarTimestamp(int64_t timestamp);
+
+} // namespace nlsr
+
+#endif // NLSR_PUBLISHER_SIDECAR_RECORD_HPP
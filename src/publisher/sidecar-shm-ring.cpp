@@ -0,0 +1,299 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sidecar-shm-ring.hpp"
+#include "common.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace nlsr {
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "the ring indexes are shared between processes and must not use a lock");
+
+constexpr uint32_t RING_MAGIC = 0x4e534652; // "NSFR"
+constexpr uint16_t RING_VERSION = 2;
+constexpr uint32_t MAX_CAPACITY = uint32_t(1) << 24;
+constexpr size_t CACHE_LINE_SIZE = 64;
+/// the slots start on the cache line after the header
+constexpr size_t HEADER_SIZE = CACHE_LINE_SIZE * 3;
+
+struct SidecarShmRing::Header
+{
+  uint32_t magic;
+  uint16_t version;
+  uint16_t recordSize;
+  uint32_t capacity;
+  std::atomic<uint32_t> isClosed;
+  std::atomic<uint64_t> nDropped;
+  alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> writeIndex;
+  alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> readIndex;
+};
+
+namespace {
+
+size_t
+getRingSize(uint32_t capacity)
+{
+  return HEADER_SIZE + static_cast<size_t>(capacity) * sizeof(SidecarCallRecord);
+}
+
+std::string
+errnoString()
+{
+  return std::strerror(errno);
+}
+
+/*! \brief Closes a file descriptor when leaving the scope.
+ */
+class FdCloser
+{
+public:
+  explicit
+  FdCloser(int fd)
+    : m_fd(fd)
+  {
+  }
+
+  ~FdCloser()
+  {
+    ::close(m_fd);
+  }
+
+private:
+  int m_fd;
+};
+
+} // anonymous namespace
+
+SidecarRecord
+SidecarCallRecord::toRecord() const
+{
+  SidecarRecord record;
+  record.serviceCallInTime = serviceCallInTime;
+  record.serviceCallOutTime = serviceCallOutTime;
+  record.sidecarInTime = sidecarInTime;
+  record.sidecarOutTime = sidecarOutTime;
+  record.sfcTime = sfcTime;
+  record.inDataSize = inDataSize;
+  record.outDataSize = outDataSize;
+  record.workers = workers;
+  return record;
+}
+
+SidecarCallRecord
+SidecarCallRecord::fromRecord(const SidecarRecord& record)
+{
+  SidecarCallRecord callRecord{};
+  callRecord.serviceCallInTime = record.serviceCallInTime;
+  callRecord.serviceCallOutTime = record.serviceCallOutTime;
+  callRecord.sidecarInTime = record.sidecarInTime;
+  callRecord.sidecarOutTime = record.sidecarOutTime;
+  callRecord.sfcTime = record.sfcTime;
+  callRecord.inDataSize = record.inDataSize;
+  callRecord.outDataSize = record.outDataSize;
+  callRecord.workers = record.workers;
+  callRecord.callNameHash = hashCallName(record.callName);
+  return callRecord;
+}
+
+uint32_t
+SidecarCallRecord::hashCallName(std::string_view callName)
+{
+  if (callName.empty()) {
+    return 0;
+  }
+  uint32_t hash = 2166136261;
+  for (char c : callName) {
+    hash = (hash ^ static_cast<unsigned char>(c)) * 16777619;
+  }
+  // 0 stands for no call name
+  return hash == 0 ? 1 : hash;
+}
+
+std::unique_ptr<SidecarShmRing>
+SidecarShmRing::create(const std::string& name, uint32_t capacity)
+{
+  if (capacity == 0 || capacity > MAX_CAPACITY) {
+    NDN_THROW(Error("Invalid ring capacity " + std::to_string(capacity)));
+  }
+  uint32_t roundedCapacity = 1;
+  while (roundedCapacity < capacity) {
+    roundedCapacity <<= 1;
+  }
+
+  // a consumer still mapping the previous ring keeps it until it notices the close
+  ::shm_unlink(name.data());
+  int fd = ::shm_open(name.data(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd < 0) {
+    NDN_THROW(Error("Cannot create shared memory " + name + ": " + errnoString()));
+  }
+  FdCloser closer(fd);
+
+  size_t size = getRingSize(roundedCapacity);
+  if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+    NDN_THROW(Error("Cannot size shared memory " + name + ": " + errnoString()));
+  }
+  void* address = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (address == MAP_FAILED) {
+    NDN_THROW(Error("Cannot map shared memory " + name + ": " + errnoString()));
+  }
+
+  // the object is zero-filled by ftruncate; the magic is written last
+  auto header = new (address) Header{};
+  header->version = RING_VERSION;
+  header->recordSize = sizeof(SidecarCallRecord);
+  header->capacity = roundedCapacity;
+  std::atomic_thread_fence(std::memory_order_release);
+  header->magic = RING_MAGIC;
+
+  return std::unique_ptr<SidecarShmRing>(new SidecarShmRing(address, size));
+}
+
+std::unique_ptr<SidecarShmRing>
+SidecarShmRing::open(const std::string& name)
+{
+  int fd = ::shm_open(name.data(), O_RDWR, 0);
+  if (fd < 0) {
+    NDN_THROW(Error("Cannot open shared memory " + name + ": " + errnoString()));
+  }
+  FdCloser closer(fd);
+
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    NDN_THROW(Error("Cannot stat shared memory " + name + ": " + errnoString()));
+  }
+  size_t size = static_cast<size_t>(st.st_size);
+  if (size < getRingSize(1)) {
+    NDN_THROW(Error("Shared memory " + name + " is too small for a ring"));
+  }
+  void* address = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (address == MAP_FAILED) {
+    NDN_THROW(Error("Cannot map shared memory " + name + ": " + errnoString()));
+  }
+  std::unique_ptr<SidecarShmRing> ring(new SidecarShmRing(address, size));
+
+  const Header& header = ring->getHeader();
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (header.magic != RING_MAGIC || header.version != RING_VERSION ||
+      header.recordSize != sizeof(SidecarCallRecord)) {
+    NDN_THROW(Error("Shared memory " + name + " is not a sidecar ring of version " +
+                    std::to_string(RING_VERSION)));
+  }
+  if (header.capacity == 0 || (header.capacity & (header.capacity - 1)) != 0 ||
+      header.capacity > MAX_CAPACITY || getRingSize(header.capacity) > size) {
+    NDN_THROW(Error("Shared memory " + name + " has an invalid ring capacity"));
+  }
+  ring->m_capacity = header.capacity;
+  return ring;
+}
+
+void
+SidecarShmRing::unlink(const std::string& name)
+{
+  ::shm_unlink(name.data());
+}
+
+SidecarShmRing::SidecarShmRing(void* address, size_t size)
+  : m_address(address)
+  , m_size(size)
+  , m_capacity(static_cast<Header*>(address)->capacity)
+{
+  static_assert(sizeof(Header) <= HEADER_SIZE);
+}
+
+SidecarShmRing::~SidecarShmRing()
+{
+  ::munmap(m_address, m_size);
+}
+
+SidecarCallRecord*
+SidecarShmRing::getSlots() const
+{
+  return reinterpret_cast<SidecarCallRecord*>(static_cast<uint8_t*>(m_address) + HEADER_SIZE);
+}
+
+bool
+SidecarShmRing::push(const SidecarCallRecord& record)
+{
+  Header& header = getHeader();
+  uint64_t writeIndex = header.writeIndex.load(std::memory_order_relaxed);
+  uint64_t readIndex = header.readIndex.load(std::memory_order_acquire);
+  if (writeIndex - readIndex >= m_capacity) {
+    header.nDropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  getSlots()[writeIndex & (m_capacity - 1)] = record;
+  header.writeIndex.store(writeIndex + 1, std::memory_order_release);
+  return true;
+}
+
+size_t
+SidecarShmRing::drain(const std::function<void(const SidecarCallRecord&)>& onRecord, size_t maxRecords)
+{
+  Header& header = getHeader();
+  uint64_t readIndex = header.readIndex.load(std::memory_order_relaxed);
+  uint64_t writeIndex = header.writeIndex.load(std::memory_order_acquire);
+  if (writeIndex - readIndex > m_capacity) {
+    // the producer does not follow the protocol; skip what cannot be trusted
+    header.readIndex.store(writeIndex, std::memory_order_release);
+    return 0;
+  }
+
+  size_t nRecords = static_cast<size_t>(std::min<uint64_t>(writeIndex - readIndex, maxRecords));
+  for (size_t i = 0; i < nRecords; ++i) {
+    // copied out, so that the slot can be reused while onRecord runs
+    SidecarCallRecord record = getSlots()[(readIndex + i) & (m_capacity - 1)];
+    onRecord(record);
+  }
+  header.readIndex.store(readIndex + nRecords, std::memory_order_release);
+  return nRecords;
+}
+
+void
+SidecarShmRing::close()
+{
+  getHeader().isClosed.store(1, std::memory_order_release);
+}
+
+bool
+SidecarShmRing::isClosed() const
+{
+  return getHeader().isClosed.load(std::memory_order_acquire) != 0;
+}
+
+uint64_t
+SidecarShmRing::getNDropped() const
+{
+  return getHeader().nDropped.load(std::memory_order_relaxed);
+}
+
+} // namespace nlsr
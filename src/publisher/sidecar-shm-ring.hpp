@@ -0,0 +1,177 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_PUBLISHER_SIDECAR_SHM_RING_HPP
+#define NLSR_PUBLISHER_SIDECAR_SHM_RING_HPP
+
+#include "sidecar-record.hpp"
+
+#include <boost/noncopyable.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace nlsr {
+
+/*! \brief Fixed-size binary form of a SidecarRecord, as written into a SidecarShmRing.
+
+  Times are microseconds since the Unix epoch, 0 if absent, as in SidecarRecord. The call
+  name does not fit in the record, so it is carried as its hash.
+ */
+struct SidecarCallRecord
+{
+  int64_t serviceCallInTime;
+  int64_t serviceCallOutTime;
+  int64_t sidecarInTime;
+  int64_t sidecarOutTime;
+  int64_t sfcTime;
+  uint64_t inDataSize;
+  uint64_t outDataSize;
+  uint32_t workers;
+  /// hashCallName() of service_call.call_name; 0 if the call has none
+  uint32_t callNameHash;
+
+  /*! \brief Returns the record, without its call name.
+   */
+  SidecarRecord
+  toRecord() const;
+
+  static SidecarCallRecord
+  fromRecord(const SidecarRecord& record);
+
+  /*! \brief Returns the 32-bit FNV-1a hash of \p callName, which is 0 only for an empty name.
+   */
+  static uint32_t
+  hashCallName(std::string_view callName);
+};
+
+static_assert(sizeof(SidecarCallRecord) == 64, "SidecarCallRecord is part of the ring layout");
+
+/*! \brief Single-producer, single-consumer ring of SidecarCallRecord in POSIX shared memory.
+
+  The sidecar creates the ring and pushes one record per call; NLSR opens it and drains
+  it periodically. This avoids writing, reading and parsing a log file, and bounds the
+  delay of the routing signal by the drain interval.
+
+  The shared memory object starts with a header holding a magic number, the layout
+  version, the record size and the capacity, followed by the write and read indexes on
+  their own cache lines and the record slots. The indexes only grow; the slot of index
+  \c i is <tt>i % capacity</tt>. The producer writes a slot and then publishes it with a
+  release store of the write index; the consumer reads the slots below the write index
+  and then frees them with a release store of the read index. Neither side takes a lock.
+  When the ring is full, the producer drops the new record and counts it.
+
+  The layout uses host byte order and is only meant for processes on the same machine.
+ */
+class SidecarShmRing : boost::noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  /*! \brief Creates the ring \p name for writing, replacing any existing one.
+
+    \p name follows shm_open(3), e.g. "/nlsr-sidecar".
+    \param capacity Number of slots, rounded up to a power of two.
+    \throw Error the shared memory object cannot be created
+   */
+  static std::unique_ptr<SidecarShmRing>
+  create(const std::string& name, uint32_t capacity);
+
+  /*! \brief Opens the existing ring \p name for reading.
+    \throw Error the shared memory object does not exist or is not a ring of this version
+   */
+  static std::unique_ptr<SidecarShmRing>
+  open(const std::string& name);
+
+  /*! \brief Removes the shared memory object \p name; mappings stay valid until released.
+   */
+  static void
+  unlink(const std::string& name);
+
+  ~SidecarShmRing();
+
+  /*! \brief Appends \p record. Must only be called by the producer.
+    \return false if the ring is full and the record was dropped
+   */
+  bool
+  push(const SidecarCallRecord& record);
+
+  /*! \brief Passes up to \p maxRecords pending records to \p onRecord, in order, and frees
+             their slots. Must only be called by the consumer.
+    \return the number of records passed
+   */
+  size_t
+  drain(const std::function<void(const SidecarCallRecord&)>& onRecord, size_t maxRecords = SIZE_MAX);
+
+  /*! \brief Marks the ring as abandoned by the producer, e.g. before it exits.
+
+    The consumer drains what is left and then releases its mapping, so that it can open the
+    ring that a restarted producer creates.
+   */
+  void
+  close();
+
+  bool
+  isClosed() const;
+
+  uint32_t
+  getCapacity() const
+  {
+    return m_capacity;
+  }
+
+  /*! \brief Returns the number of records dropped by the producer because the ring was full.
+   */
+  uint64_t
+  getNDropped() const;
+
+private:
+  struct Header;
+
+  SidecarShmRing(void* address, size_t size);
+
+  Header&
+  getHeader() const
+  {
+    return *static_cast<Header*>(m_address);
+  }
+
+  SidecarCallRecord*
+  getSlots() const;
+
+private:
+  void* m_address;
+  size_t m_size;
+  uint32_t m_capacity;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_PUBLISHER_SIDECAR_SHM_RING_HPP
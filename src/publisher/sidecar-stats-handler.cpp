@@ -24,23 +24,84 @@
 #include "lsdb.hpp"
 #include "conf-parameter.hpp"
 #include "lsa/name-lsa.hpp"  // For ServiceFunctionInfo definition
+#include "route/name-prefix-table.hpp"
 #include <ndn-cxx/encoding/block.hpp>
 #include <ndn-cxx/encoding/block-helpers.hpp>
 #include <ndn-cxx/encoding/encoding-buffer.hpp>
 #include <ndn-cxx/util/string-helper.hpp>
 #include <ndn-cxx/util/scheduler.hpp>
-#include <fstream>
+#include <boost/asio/post.hpp>
+#include <algorithm>
 #include <sstream>
 #include <iostream>
 #include <functional>
 #include <cstring>
-#include <ctime>
 #include <chrono>
+#include <cmath>
+#include <limits>
 
 namespace nlsr {
 
 INIT_LOGGER(SidecarStatsHandler);
 
+namespace {
+
+constexpr ndn::time::milliseconds SHM_DRAIN_INTERVAL = 100_ms;
+constexpr ndn::time::milliseconds SHM_OPEN_RETRY_INTERVAL = 1_s;
+constexpr ndn::time::milliseconds DATASET_FRESHNESS_PERIOD = 1_s;
+
+FunctionMonitor::Options
+makeFunctionMonitorOptions(const ConfParameter& confParam)
+{
+  FunctionMonitor::Options options;
+  options.windowLength = int64_t(confParam.getUtilizationWindowSeconds()) * 1000000;
+  options.workerCapacity = confParam.getWorkerCapacity();
+  options.maxConcurrency = confParam.getMaxConcurrency();
+  options.processingWeight = confParam.getProcessingWeight();
+  options.loadWeight = confParam.getLoadWeight();
+  options.usageWeight = confParam.getUsageWeight();
+  options.latencyWeight = confParam.getLatencyWeight();
+  options.overload.clearRatio = confParam.getOverloadClearRatio();
+  if (confParam.isDynamicWeightingEnabled()) {
+    WeightLearner::Options learning;
+    learning.forgetting = confParam.getDynamicWeightingForgetting();
+    learning.minWeight = confParam.getDynamicWeightingMinWeight();
+    learning.maxWeight = confParam.getDynamicWeightingMaxWeight();
+    learning.maxStep = confParam.getDynamicWeightingMaxStep();
+    options.weightLearning = learning;
+  }
+  return options;
+}
+
+AdvertisementController::Options
+makeAdvertisementOptions(const ConfParameter& confParam)
+{
+  AdvertisementController::Options options;
+  options.smoothing = confParam.getAdvertisementSmoothing();
+  options.absoluteThreshold = confParam.getAdvertisementAbsoluteThreshold();
+  options.relativeThreshold = confParam.getAdvertisementRelativeThreshold();
+  options.minInterval = confParam.getAdvertisementMinInterval();
+  options.maxInterval = confParam.getAdvertisementMaxInterval();
+  return options;
+}
+
+/*! \brief Appends the quantiles of \p sketch, in microseconds, one per line.
+ */
+void
+appendQuantiles(std::string& out, const std::string& title, const LatencySketch& sketch)
+{
+  out += title + " (" + std::to_string(sketch.getCount()) + " samples):\n";
+  if (sketch.empty()) {
+    return;
+  }
+  const std::pair<const char*, double> quantiles[] = {{"p50", 0.5}, {"p90", 0.9}, {"p95", 0.95}, {"p99", 0.99}};
+  for (const auto& [label, q] : quantiles) {
+    out += std::string("  ") + label + ": " + std::to_string(sketch.getQuantile(q)) + " us\n";
+  }
+}
+
+} // anonymous namespace
+
 SidecarStatsHandler::SidecarStatsHandler(ndn::mgmt::Dispatcher& dispatcher,
                                          const std::string& logPath)
   : m_logPath(logPath)
@@ -48,6 +109,10 @@ SidecarStatsHandler::SidecarStatsHandler(ndn::mgmt::Dispatcher& dispatcher,
   , m_lsdb(nullptr)
   , m_confParam(nullptr)
 {
+  m_logSources.push_back(std::make_unique<LogSource>(logPath));
+  addFunction(ndn::Name(), "", logPath, FunctionMonitor::Options{}, AdvertisementController::Options{});
+  m_snapshot = ingest(false);
+
   try {
     // Register dataset handlers with explicit logging
     NLSR_LOG_INFO("Registering sidecar-stats dataset handler");
@@ -80,7 +145,23 @@ SidecarStatsHandler::SidecarStatsHandler(ndn::mgmt::Dispatcher& dispatcher,
   }
 }
 
-std::map<std::string, std::string>
+SidecarStatsHandler::~SidecarStatsHandler()
+{
+  if (m_ingestion == nullptr) {
+    return;
+  }
+
+  m_ingestion->io.stop();
+  m_ingestion->thread.join();
+  // the watchers and the ring drain use the io_context of the ingestion thread
+  for (auto& source : m_logSources) {
+    source->watcher.reset();
+  }
+  m_shmDrainEvent.cancel();
+  m_ingestion.reset();
+}
+
+std::map<ndn::Name, std::map<std::string, std::string>>
 SidecarStatsHandler::getCurrentStats() const
 {
   return getLatestStats();
@@ -91,35 +172,30 @@ SidecarStatsHandler::publishSidecarStats(const ndn::Name& topPrefix,
                                          const ndn::Interest& interest,
                                          ndn::mgmt::StatusDatasetContext& context)
 {
-  try {
-    NLSR_LOG_DEBUG("Received sidecar-stats request from: " + interest.getName().toUri());
-    
-    auto stats = getLatestStats();
-    
+  NLSR_LOG_DEBUG("Received sidecar-stats request from: " + interest.getName().toUri());
+  publishCachedContent(m_sidecarStatsCache, context, [this] {
     std::string response = "Sidecar Statistics Dataset\n";
     response += "================================\n";
-    
-    if (stats.find("error") != stats.end()) {
-      response += "Error: " + stats["error"] + "\n";
-      response += "Log file path: " + m_logPath + "\n";
-      response += "Registration status: " + std::string(m_isRegistered ? "Registered" : "Not registered") + "\n";
-    } else {
-      for (const auto& [key, value] : stats) {
-        response += key + ": " + value + "\n";
+
+    for (const auto& [prefix, stats] : getLatestStats()) {
+      response += "function_prefix: " + prefix.toUri() + "\n";
+      if (stats.find("error") != stats.end()) {
+        response += "Error: " + stats.at("error") + "\n";
+        response += "Registration status: " + std::string(m_isRegistered ? "Registered" : "Not registered") + "\n";
+      } else {
+        for (const auto& [key, value] : stats) {
+          response += key + ": " + value + "\n";
+        }
       }
+      response += "\n";
     }
-
-    context.append(ndn::encoding::makeStringBlock(ndn::tlv::Content, response));
-    context.end();
-    
-    NLSR_LOG_DEBUG("Sidecar-stats response sent successfully");
-  }
-  catch (const std::exception& e) {
-    NLSR_LOG_ERROR("Error in publishSidecarStats: " + std::string(e.what()));
-    std::string errorResponse = "Error: " + std::string(e.what()) + "\n";
-    context.append(ndn::encoding::makeStringBlock(ndn::tlv::Content, errorResponse));
-    context.end();
-  }
+    response += "Log file paths:";
+    for (const auto& source : m_logSources) {
+      response += " " + source->path;
+    }
+    response += "\nstats_version: " + std::to_string(m_statsVersion) + "\n";
+    return response;
+  });
 }
 
 void
@@ -127,24 +203,27 @@ SidecarStatsHandler::publishServiceStats(const ndn::Name& topPrefix,
                                          const ndn::Interest& interest,
                                          ndn::mgmt::StatusDatasetContext& context)
 {
-  auto stats = getLatestStats();
-  
-  std::string serviceStats = "Service Call Statistics\n";
-  serviceStats += "=======================\n";
-  
-  if (stats.find("service_call") != stats.end()) {
-    serviceStats += "Call Name: " + stats["call_name"] + "\n";
-    serviceStats += "In Time: " + stats["in_time"] + "\n";
-    serviceStats += "Out Time: " + stats["out_time"] + "\n";
-    serviceStats += "Port: " + stats["port_num"] + "\n";
-    serviceStats += "Input Data Size: " + stats["in_datasize"] + "\n";
-    serviceStats += "Output Data Size: " + stats["out_datasize"] + "\n";
-  } else {
-    serviceStats += "No service call data available\n";
-  }
-
-  context.append(ndn::encoding::makeStringBlock(ndn::tlv::Content, serviceStats));
-  context.end();
+  publishCachedContent(m_serviceStatsCache, context, [this] {
+    std::string serviceStats = "Service Call Statistics\n";
+    serviceStats += "=======================\n";
+
+    for (const auto& function : m_snapshot->functions) {
+      const auto& latestRecord = function.latestRecord;
+      serviceStats += "Function: " + function.prefix.toUri() + "\n";
+      if (latestRecord && latestRecord->serviceCallInTime != 0) {
+        serviceStats += "In Time: " + formatSidecarTimestamp(latestRecord->serviceCallInTime) + "\n";
+        if (latestRecord->serviceCallOutTime != 0) {
+          serviceStats += "Out Time: " + formatSidecarTimestamp(latestRecord->serviceCallOutTime) + "\n";
+        }
+        serviceStats += "Input Data Size: " + std::to_string(latestRecord->inDataSize) + "\n";
+        serviceStats += "Output Data Size: " + std::to_string(latestRecord->outDataSize) + "\n";
+      } else {
+        serviceStats += "No service call data available\n";
+      }
+      appendQuantiles(serviceStats, "Service Time", function.serviceTime);
+    }
+    return serviceStats;
+  });
 }
 
 void
@@ -152,22 +231,28 @@ SidecarStatsHandler::publishSfcStats(const ndn::Name& topPrefix,
                                      const ndn::Interest& interest,
                                      ndn::mgmt::StatusDatasetContext& context)
 {
-  auto stats = getLatestStats();
-  
-  std::string sfcStats = "SFC Execution Statistics\n";
-  sfcStats += "=========================\n";
-  
-  if (stats.find("sfc_time") != stats.end()) {
-    sfcStats += "SFC Start Time: " + stats["sfc_time"] + "\n";
-    sfcStats += "Sidecar In Time: " + stats["sidecar_in_time"] + "\n";
-    sfcStats += "Sidecar Out Time: " + stats["sidecar_out_time"] + "\n";
-    sfcStats += "Host Name: " + stats["host_name"] + "\n";
-  } else {
-    sfcStats += "No SFC data available\n";
-  }
-
-  context.append(ndn::encoding::makeStringBlock(ndn::tlv::Content, sfcStats));
-  context.end();
+  publishCachedContent(m_sfcStatsCache, context, [this] {
+    std::string sfcStats = "SFC Execution Statistics\n";
+    sfcStats += "=========================\n";
+
+    for (const auto& function : m_snapshot->functions) {
+      const auto& latestRecord = function.latestRecord;
+      sfcStats += "Function: " + function.prefix.toUri() + "\n";
+      if (latestRecord && latestRecord->sfcTime != 0) {
+        sfcStats += "SFC Start Time: " + formatSidecarTimestamp(latestRecord->sfcTime) + "\n";
+        if (latestRecord->sidecarInTime != 0) {
+          sfcStats += "Sidecar In Time: " + formatSidecarTimestamp(latestRecord->sidecarInTime) + "\n";
+        }
+        if (latestRecord->sidecarOutTime != 0) {
+          sfcStats += "Sidecar Out Time: " + formatSidecarTimestamp(latestRecord->sidecarOutTime) + "\n";
+        }
+      } else {
+        sfcStats += "No SFC data available\n";
+      }
+      appendQuantiles(sfcStats, "Sidecar Overhead", function.overhead);
+    }
+    return sfcStats;
+  });
 }
 
 void
@@ -175,166 +260,282 @@ SidecarStatsHandler::publishFunctionInfo(const ndn::Name& topPrefix,
                                          const ndn::Interest& interest,
                                          ndn::mgmt::StatusDatasetContext& context)
 {
-  std::string functionInfo = "Function Information Dataset\n";
-  functionInfo += "===============================\n";
-  functionInfo += "This dataset provides Service Function information\n";
-  functionInfo += "including processing time, load, and usage count.\n";
-  functionInfo += "\n";
-  functionInfo += "Note: Function information is stored in NameLsa\n";
-  functionInfo += "and can be accessed via 'nlsrc status lsdb/names'\n";
-  functionInfo += "\n";
-  functionInfo += "For detailed statistics, use:\n";
-  functionInfo += "- nlsrc status sidecar-stats\n";
-  functionInfo += "- nlsrc status service-stats\n";
-  functionInfo += "- nlsrc status sfc-stats\n";
-
-  context.append(ndn::encoding::makeStringBlock(ndn::tlv::Content, functionInfo));
+  // The text does not depend on the stats, only on the site selections
+  uint64_t version = (m_namePrefixTable != nullptr ? m_namePrefixTable->getSiteSelectionVersion() : 0) + 1;
+  if (m_functionInfoCache.version != version) {
+    std::string functionInfo = "Function Information Dataset\n";
+    functionInfo += "===============================\n";
+    functionInfo += "This dataset provides Service Function information\n";
+    functionInfo += "including processing time, load, and usage count.\n";
+    functionInfo += "\n";
+    functionInfo += "Note: Function information is stored in NameLsa\n";
+    functionInfo += "and can be accessed via 'nlsrc status lsdb/names'\n";
+    functionInfo += "\n";
+    functionInfo += "For detailed statistics, use:\n";
+    functionInfo += "- nlsrc status sidecar-stats\n";
+    functionInfo += "- nlsrc status service-stats\n";
+    functionInfo += "- nlsrc status sfc-stats\n";
+    if (m_namePrefixTable != nullptr && m_confParam != nullptr &&
+        !m_namePrefixTable->getSiteSelections().empty()) {
+      functionInfo += "\n";
+      functionInfo += "Instance selection (site-headroom-threshold "
+                      + std::to_string(m_confParam->getSiteHeadroomThreshold()) + "):\n";
+      for (const auto& [prefix, selection] : m_namePrefixTable->getSiteSelections()) {
+        functionInfo += prefix.toUri() + ": "
+                        + (selection.isLocalPreferred ? "local site first" : "all sites by cost")
+                        + " (" + std::to_string(selection.nLocalInstances) + " local, "
+                        + std::to_string(selection.nRemoteInstances) + " remote instances, "
+                        + "local headroom " + std::to_string(selection.localHeadroom) + ")\n";
+      }
+    }
+    m_functionInfoCache.content = ndn::encoding::makeStringBlock(ndn::tlv::Content, functionInfo);
+    m_functionInfoCache.version = version;
+  }
+
+  context.append(m_functionInfoCache.content);
   context.end();
 }
 
-std::vector<std::map<std::string, std::string>>
-SidecarStatsHandler::parseSidecarLog() const
+void
+SidecarStatsHandler::publishCachedContent(CachedContent& cache, ndn::mgmt::StatusDatasetContext& context,
+                                          const std::function<std::string()>& makeContent)
 {
-  NLSR_LOG_DEBUG("parseSidecarLog called for: " << m_logPath);
-  std::vector<std::map<std::string, std::string>> logEntries;
-  
-  try {
-    std::ifstream logFile(m_logPath);
-    
-    if (!logFile.is_open()) {
-      NLSR_LOG_WARN("Cannot open log file: " + m_logPath);
-      return logEntries;
+  // Within the freshness period, the log is not read again and the cached content is served.
+  // The ingestion thread publishes its snapshots by itself.
+  auto now = ndn::time::steady_clock::now();
+  if (m_ingestion == nullptr && now - m_lastDatasetRefresh >= DATASET_FRESHNESS_PERIOD) {
+    readNewLogEntries();
+    if (m_nNewRecords > 0) {
+      applySnapshot(ingest(false));
     }
-    
-    NLSR_LOG_DEBUG("Log file opened successfully");
-
-    std::string line;
-    int lineCount = 0;
-    while (std::getline(logFile, line)) {
-      lineCount++;
-      try {
-        // Parse nested JSON structure
-        // Expected format: {"service_call": {"in_time": "...", "out_time": "..."}, "sidecar": {...}}
-        std::map<std::string, std::string> entry;
-        
-        // Remove leading/trailing whitespace
-        line.erase(0, line.find_first_not_of(" \t"));
-        line.erase(line.find_last_not_of(" \t") + 1);
-        
-        if (line.empty() || line.front() != '{' || line.back() != '}') {
-          continue;
-        }
-        
-        // Extract service_call information
-        size_t scStart = line.find("\"service_call\"");
-        if (scStart != std::string::npos) {
-          size_t scBegin = line.find('{', scStart);
-          size_t scEnd = line.find('}', scBegin);
-          if (scBegin != std::string::npos && scEnd != std::string::npos) {
-            std::string serviceCall = line.substr(scBegin, scEnd - scBegin + 1);
-            
-            // Extract in_time and out_time
-            size_t inTimePos = serviceCall.find("\"in_time\"");
-            size_t outTimePos = serviceCall.find("\"out_time\"");
-            
-            if (inTimePos != std::string::npos) {
-              size_t colonPos = serviceCall.find(':', inTimePos);
-              size_t quoteStart = serviceCall.find('"', colonPos);
-              size_t quoteEnd = serviceCall.find('"', quoteStart + 1);
-              if (quoteStart != std::string::npos && quoteEnd != std::string::npos) {
-                entry["service_call_in_time"] = serviceCall.substr(quoteStart + 1, quoteEnd - quoteStart - 1);
-              }
-            }
-            
-            if (outTimePos != std::string::npos) {
-              size_t colonPos = serviceCall.find(':', outTimePos);
-              size_t quoteStart = serviceCall.find('"', colonPos);
-              size_t quoteEnd = serviceCall.find('"', quoteStart + 1);
-              if (quoteStart != std::string::npos && quoteEnd != std::string::npos) {
-                entry["service_call_out_time"] = serviceCall.substr(quoteStart + 1, quoteEnd - quoteStart - 1);
-              }
-            }
-          }
-        }
-        
-        // Extract sidecar information
-        size_t sidecarStart = line.find("\"sidecar\"");
-        if (sidecarStart != std::string::npos) {
-          size_t scBegin = line.find('{', sidecarStart);
-          size_t scEnd = line.find('}', scBegin);
-          if (scBegin != std::string::npos && scEnd != std::string::npos) {
-            std::string sidecar = line.substr(scBegin, scEnd - scBegin + 1);
-            
-            // Extract in_time and out_time
-            size_t inTimePos = sidecar.find("\"in_time\"");
-            size_t outTimePos = sidecar.find("\"out_time\"");
-            
-            if (inTimePos != std::string::npos) {
-              size_t colonPos = sidecar.find(':', inTimePos);
-              size_t quoteStart = sidecar.find('"', colonPos);
-              size_t quoteEnd = sidecar.find('"', quoteStart + 1);
-              if (quoteStart != std::string::npos && quoteEnd != std::string::npos) {
-                entry["sidecar_in_time"] = sidecar.substr(quoteStart + 1, quoteEnd - quoteStart - 1);
-              }
-            }
-            
-            if (outTimePos != std::string::npos) {
-              size_t colonPos = sidecar.find(':', outTimePos);
-              size_t quoteStart = sidecar.find('"', colonPos);
-              size_t quoteEnd = sidecar.find('"', quoteStart + 1);
-              if (quoteStart != std::string::npos && quoteEnd != std::string::npos) {
-                entry["sidecar_out_time"] = sidecar.substr(quoteStart + 1, quoteEnd - quoteStart - 1);
-              }
-            }
-          }
-        }
-        
-        // Extract sfc_time if available
-        size_t sfcTimePos = line.find("\"sfc_time\"");
-        if (sfcTimePos != std::string::npos) {
-          size_t colonPos = line.find(':', sfcTimePos);
-          size_t quoteStart = line.find('"', colonPos);
-          size_t quoteEnd = line.find('"', quoteStart + 1);
-          if (quoteStart != std::string::npos && quoteEnd != std::string::npos) {
-            entry["sfc_time"] = line.substr(quoteStart + 1, quoteEnd - quoteStart - 1);
-          }
-        }
-        
-        if (!entry.empty()) {
-          logEntries.push_back(entry);
-        }
-      } catch (const std::exception& e) {
-        NLSR_LOG_WARN("Error parsing line " + std::to_string(lineCount) + ": " + std::string(e.what()));
-        continue;
-      }
+    m_lastDatasetRefresh = now;
+  }
+
+  if (cache.version != m_statsVersion) {
+    try {
+      cache.content = ndn::encoding::makeStringBlock(ndn::tlv::Content, makeContent());
+      cache.version = m_statsVersion;
     }
-    
-    NLSR_LOG_DEBUG("Parsed " + std::to_string(logEntries.size()) + " log entries from " + m_logPath);
-    if (logEntries.size() > 0) {
-      NLSR_LOG_DEBUG("First entry has " + std::to_string(logEntries[0].size()) + " keys");
-      for (const auto& [key, value] : logEntries[0]) {
-        NLSR_LOG_DEBUG("  Key: " << key << " = " << value.substr(0, 50));
-      }
+    catch (const std::exception& e) {
+      NLSR_LOG_ERROR("Error encoding sidecar dataset: " + std::string(e.what()));
+      context.append(ndn::encoding::makeStringBlock(ndn::tlv::Content,
+                                                    "Error: " + std::string(e.what()) + "\n"));
+      context.end();
+      return;
     }
   }
+  else {
+    NLSR_LOG_TRACE("Serving cached dataset of stats version " << cache.version);
+  }
+
+  context.setExpiry(DATASET_FRESHNESS_PERIOD);
+  context.append(cache.content);
+  context.end();
+}
+
+size_t
+SidecarStatsHandler::readNewLogEntries()
+{
+  size_t nEntries = 0;
+  for (auto& source : m_logSources) {
+    nEntries += readNewLogEntries(*source);
+  }
+  return nEntries;
+}
+
+size_t
+SidecarStatsHandler::readNewLogEntries(LogSource& source)
+{
+  if (source.path.empty() || source.functions.empty()) {
+    return 0;
+  }
+
+  // Each line is parsed once, then handed to the function it belongs to
+  size_t nEntries = 0;
+  size_t nDropped = 0;
+  std::string droppedCallName;
+  try {
+    source.reader.readNewLines([&] (std::string_view line) {
+      auto record = parseSidecarRecord(line, m_logTimeZone);
+      if (!record) {
+        return;
+      }
+      ++nEntries;
+      if (!addRecord(source, *record)) {
+        ++nDropped;
+        droppedCallName = record->callName;
+      }
+    });
+  }
   catch (const std::exception& e) {
-    NLSR_LOG_ERROR("Error reading log file: " + std::string(e.what()));
+    NLSR_LOG_ERROR("Error reading log file " << source.path << ": " << e.what());
   }
-  
-  return logEntries;
+
+  if (nDropped > 0) {
+    NLSR_LOG_WARN("Dropped " << nDropped << " records of " << source.path
+                  << " that belong to no function-source, e.g. call_name '" << droppedCallName << "'");
+  }
+
+  if (nEntries > 0) {
+    NLSR_LOG_DEBUG("Read " << nEntries << " new log entries from " << source.path);
+  }
+  return nEntries;
+}
+
+bool
+SidecarStatsHandler::addRecord(const SidecarRecord& record)
+{
+  return addRecord(*m_logSources.front(), record);
+}
+
+bool
+SidecarStatsHandler::addRecord(LogSource& source, const SidecarRecord& record)
+{
+  auto it = source.functions.find(record.callName);
+  if (it == source.functions.end()) {
+    it = source.functions.find("");
+  }
+  if (it == source.functions.end()) {
+    return false;
+  }
+  addRecord(*it->second, record);
+  return true;
+}
+
+bool
+SidecarStatsHandler::addRecord(const SidecarCallRecord& callRecord)
+{
+  auto it = m_shmFunctions.find(callRecord.callNameHash);
+  if (it == m_shmFunctions.end()) {
+    it = m_shmFunctions.find(0);
+  }
+  if (it == m_shmFunctions.end()) {
+    return false;
+  }
+  addRecord(*it->second, callRecord.toRecord());
+  return true;
+}
+
+void
+SidecarStatsHandler::addRecord(FunctionMonitor& function, const SidecarRecord& record)
+{
+  if (function.add(record)) {
+    const auto& detector = function.getOverloadDetector();
+    NLSR_LOG_INFO(function.getPrefix() << (detector.isOverloaded() ? " overloaded" : " no longer overloaded")
+                  << ": " << detector.getInFlight() << " requests in flight, limit "
+                  << function.getMaxConcurrency());
+  }
+  ++m_nNewRecords;
+}
+
+void
+SidecarStatsHandler::addFunction(const ndn::Name& prefix, const std::string& callName,
+                                 const std::string& logPath, const FunctionMonitor::Options& options,
+                                 const AdvertisementController::Options& advertisementOptions)
+{
+  auto sourceIt = std::find_if(m_logSources.begin(), m_logSources.end(),
+                               [&] (const auto& source) { return source->path == logPath; });
+  if (sourceIt == m_logSources.end()) {
+    sourceIt = m_logSources.insert(m_logSources.end(), std::make_unique<LogSource>(logPath));
+  }
+
+  m_functions.push_back(std::make_unique<FunctionMonitor>(prefix, callName, options));
+  m_advertisers.try_emplace(prefix, advertisementOptions);
+  (*sourceIt)->functions[callName] = m_functions.back().get();
+  // the records of the shared-memory ring belong to the functions of the default log
+  if (sourceIt == m_logSources.begin()) {
+    auto [it, isNew] = m_shmFunctions.try_emplace(SidecarCallRecord::hashCallName(callName),
+                                                  m_functions.back().get());
+    if (!isNew) {
+      NLSR_LOG_WARN("call_name " << callName << " of " << prefix << " has the same hash as the one of "
+                    << it->second->getPrefix() << "; its shared-memory records go to the latter");
+    }
+  }
+  NLSR_LOG_INFO("Monitoring " << prefix << " from " << (logPath.empty() ? "the shared-memory ring" : logPath)
+                << (callName.empty() ? "" : " (call_name " + callName + ")"));
 }
 
-std::map<std::string, std::string>
+std::map<ndn::Name, std::map<std::string, std::string>>
 SidecarStatsHandler::getLatestStats() const
 {
-  auto logEntries = parseSidecarLog();
-  
-  if (logEntries.empty()) {
-    return {{"error", "No log entries found"}};
+  std::map<ndn::Name, std::map<std::string, std::string>> stats;
+  for (const auto& function : m_snapshot->functions) {
+    auto& functionStats = stats[function.prefix] = function.stats;
+    auto advertiser = m_advertisers.find(function.prefix);
+    if (functionStats.count("error") > 0 || advertiser == m_advertisers.end()) {
+      continue;
+    }
+    // Service Function info updates flooded and held back
+    functionStats["advertisements"] = std::to_string(advertiser->second.getNAdvertised());
+    functionStats["suppressed_advertisements"] = std::to_string(advertiser->second.getNSuppressed());
+  }
+  return stats;
+}
+
+std::unique_ptr<SidecarStatsHandler::StatsSnapshot>
+SidecarStatsHandler::ingest(bool isSampling)
+{
+  auto now = ndn::time::system_clock::now();
+  auto nowUs = ndn::time::duration_cast<ndn::time::microseconds>(now.time_since_epoch()).count();
+
+  auto snapshot = std::make_unique<StatsSnapshot>();
+  snapshot->isSample = isSampling;
+  for (auto& function : m_functions) {
+    FunctionSnapshot functionSnapshot;
+    functionSnapshot.prefix = function->getPrefix();
+    if (isSampling) {
+      // An instance nobody sends requests to any more is not overloaded
+      if (function->expire(nowUs)) {
+        NLSR_LOG_INFO(function->getPrefix() << " no longer overloaded: no request completed recently");
+      }
+      functionSnapshot.info = function->update(now);
+    }
+    else {
+      functionSnapshot.info = function->makeServiceFunctionInfo(now);
+    }
+    functionSnapshot.stats = function->getStats();
+    functionSnapshot.latestRecord = function->getLatestRecord();
+    functionSnapshot.serviceTime = function->getWindow().getServiceTimeSketch();
+    functionSnapshot.overhead = function->getWindow().getOverheadSketch();
+    snapshot->functions.push_back(std::move(functionSnapshot));
+  }
+  m_nNewRecords = 0;
+  return snapshot;
+}
+
+void
+SidecarStatsHandler::publishSnapshot(std::unique_ptr<StatsSnapshot> snapshot)
+{
+  if (m_ingestion == nullptr) {
+    applySnapshot(std::move(snapshot));
+    return;
+  }
+
+  // A snapshot not taken yet is replaced; the wakeup posted for it takes the new one
+  if (!m_snapshotSlot->put(std::move(snapshot))) {
+    NLSR_LOG_TRACE("Main thread has not taken the previous snapshot yet, replacing it");
+    return;
+  }
+  boost::asio::post(*m_mainIo, [this, slot = std::weak_ptr<LatestValueSlot<StatsSnapshot>>(m_snapshotSlot)] {
+    // the handler may have been destroyed since
+    if (slot.expired()) {
+      return;
+    }
+    auto snapshot = m_snapshotSlot->take();
+    if (snapshot != nullptr) {
+      applySnapshot(std::move(snapshot));
+    }
+  });
+}
+
+void
+SidecarStatsHandler::applySnapshot(std::shared_ptr<const StatsSnapshot> snapshot)
+{
+  m_snapshot = std::move(snapshot);
+  ++m_statsVersion;
+  if (m_snapshot->isSample) {
+    advertise(*m_snapshot);
   }
-  
-  // Return the latest entry
-  return logEntries.back();
 }
 
 // Extended constructor with LSDB and ConfParameter
@@ -346,7 +547,21 @@ SidecarStatsHandler::SidecarStatsHandler(ndn::mgmt::Dispatcher& dispatcher,
   , m_isRegistered(false)
   , m_lsdb(&lsdb)
   , m_confParam(&confParam)
+  , m_logTimeZone(confParam.getSidecarLogTimeZone())
 {
+  m_logSources.push_back(std::make_unique<LogSource>(logPath));
+  auto options = makeFunctionMonitorOptions(confParam);
+  auto advertisementOptions = makeAdvertisementOptions(confParam);
+  const auto& sources = confParam.getServiceFunctionSources();
+  if (sources.empty()) {
+    addFunction(confParam.getServiceFunctionPrefix(), "", logPath, options, advertisementOptions);
+  }
+  for (const auto& source : sources) {
+    addFunction(source.prefix, source.callName, source.logPath.empty() ? logPath : source.logPath,
+                options, advertisementOptions);
+  }
+  m_snapshot = ingest(false);
+
   try {
     // Register dataset handlers with explicit logging
     NLSR_LOG_INFO("Registering sidecar-stats dataset handler");
@@ -379,592 +594,240 @@ SidecarStatsHandler::SidecarStatsHandler(ndn::mgmt::Dispatcher& dispatcher,
   }
 }
 
-std::vector<std::map<std::string, std::string>>
-SidecarStatsHandler::parseSidecarLogWithTimeWindow(uint32_t windowSeconds) const
+void
+SidecarStatsHandler::updateNameLsaWithStats()
 {
-  NLSR_LOG_DEBUG("parseSidecarLogWithTimeWindow called: windowSeconds=" << windowSeconds);
-  
-  std::vector<std::map<std::string, std::string>> logEntries;
+  NLSR_LOG_DEBUG("updateNameLsaWithStats called");
   
-  if (!m_confParam) {
-    NLSR_LOG_WARN("ConfParameter not available, falling back to parseSidecarLog()");
-    return parseSidecarLog();
+  if (!m_lsdb || !m_confParam) {
+    NLSR_LOG_WARN("LSDB or ConfParameter not available, skipping NameLSA update");
+    return;
   }
-  
+
+  runIngestion([this] {
+    readNewLogEntries();
+    publishSnapshot(ingest(true));
+  });
+}
+
+void
+SidecarStatsHandler::advertise(const StatsSnapshot& snapshot)
+{
+  if (!m_lsdb || !m_confParam) {
+    return;
+  }
+
   try {
-    std::ifstream logFile(m_logPath);
-    
-    if (!logFile.is_open()) {
-      NLSR_LOG_WARN("Cannot open log file: " + m_logPath);
-      return logEntries;
-    }
-    
-    // Helper function to parse timestamp string to time_point (ndn::time::system_clock)
-    auto parseTimestampToTimePoint = [](const std::string& timestamp) -> ndn::time::system_clock::time_point {
-      try {
-        // Format: "2025-11-12 02:58:50.676086"
-        if (timestamp.length() < 19) {
-          return ndn::time::system_clock::time_point::min();
-        }
-        
-        int year = std::stoi(timestamp.substr(0, 4));
-        int month = std::stoi(timestamp.substr(5, 2));
-        int day = std::stoi(timestamp.substr(8, 2));
-        int hour = std::stoi(timestamp.substr(11, 2));
-        int minute = std::stoi(timestamp.substr(14, 2));
-        int second = std::stoi(timestamp.substr(17, 2));
-        int microsecond = 0;
-        
-        if (timestamp.length() > 19) {
-          std::string microsecStr = timestamp.substr(20);
-          if (!microsecStr.empty() && microsecStr.length() <= 6) {
-            // Pad to 6 digits if necessary
-            while (microsecStr.length() < 6) {
-              microsecStr += "0";
-            }
-            microsecStr = microsecStr.substr(0, 6);
-            microsecond = std::stoi(microsecStr);
-          }
-        }
-        
-        std::tm timeinfo = {};
-        timeinfo.tm_year = year - 1900;
-        timeinfo.tm_mon = month - 1;
-        timeinfo.tm_mday = day;
-        timeinfo.tm_hour = hour;
-        timeinfo.tm_min = minute;
-        timeinfo.tm_sec = second;
-        
-        std::time_t time = std::mktime(&timeinfo);
-        auto timePoint = ndn::time::system_clock::from_time_t(time);
-        timePoint += boost::chrono::microseconds(microsecond);
-        
-        return timePoint;
-      } catch (const std::exception&) {
-        return ndn::time::system_clock::time_point::min();
-      }
-    };
-    
-    // First pass: Read all entries and find the latest timestamp
-    std::vector<std::pair<std::map<std::string, std::string>, ndn::time::system_clock::time_point>> allEntries;
-    std::string line;
-    int lineCount = 0;
-    auto latestTimestamp = ndn::time::system_clock::time_point::min();
-    
-    // Read all lines and parse timestamps
-    while (std::getline(logFile, line)) {
-      lineCount++;
-      try {
-        // Parse the log entry (same logic as parseSidecarLog)
-        std::map<std::string, std::string> entry;
-        
-        line.erase(0, line.find_first_not_of(" \t"));
-        line.erase(line.find_last_not_of(" \t") + 1);
-        
-        if (line.empty() || line.front() != '{' || line.back() != '}') {
-          continue;
-        }
-        
-        // Extract service_call information
-        size_t scStart = line.find("\"service_call\"");
-        if (scStart != std::string::npos) {
-          size_t scBegin = line.find('{', scStart);
-          size_t scEnd = line.find('}', scBegin);
-          if (scBegin != std::string::npos && scEnd != std::string::npos) {
-            std::string serviceCall = line.substr(scBegin, scEnd - scBegin + 1);
-            
-            size_t inTimePos = serviceCall.find("\"in_time\"");
-            size_t outTimePos = serviceCall.find("\"out_time\"");
-            
-            if (inTimePos != std::string::npos) {
-              size_t colonPos = serviceCall.find(':', inTimePos);
-              size_t quoteStart = serviceCall.find('"', colonPos);
-              size_t quoteEnd = serviceCall.find('"', quoteStart + 1);
-              if (quoteStart != std::string::npos && quoteEnd != std::string::npos) {
-                entry["service_call_in_time"] = serviceCall.substr(quoteStart + 1, quoteEnd - quoteStart - 1);
-              }
-            }
-            
-            if (outTimePos != std::string::npos) {
-              size_t colonPos = serviceCall.find(':', outTimePos);
-              size_t quoteStart = serviceCall.find('"', colonPos);
-              size_t quoteEnd = serviceCall.find('"', quoteStart + 1);
-              if (quoteStart != std::string::npos && quoteEnd != std::string::npos) {
-                entry["service_call_out_time"] = serviceCall.substr(quoteStart + 1, quoteEnd - quoteStart - 1);
-              }
-            }
-          }
-        }
-        
-        // Extract sidecar information
-        size_t sidecarStart = line.find("\"sidecar\"");
-        if (sidecarStart != std::string::npos) {
-          size_t scBegin = line.find('{', sidecarStart);
-          size_t scEnd = line.find('}', scBegin);
-          if (scBegin != std::string::npos && scEnd != std::string::npos) {
-            std::string sidecar = line.substr(scBegin, scEnd - scBegin + 1);
-            
-            size_t inTimePos = sidecar.find("\"in_time\"");
-            size_t outTimePos = sidecar.find("\"out_time\"");
-            
-            if (inTimePos != std::string::npos) {
-              size_t colonPos = sidecar.find(':', inTimePos);
-              size_t quoteStart = sidecar.find('"', colonPos);
-              size_t quoteEnd = sidecar.find('"', quoteStart + 1);
-              if (quoteStart != std::string::npos && quoteEnd != std::string::npos) {
-                entry["sidecar_in_time"] = sidecar.substr(quoteStart + 1, quoteEnd - quoteStart - 1);
-              }
-            }
-            
-            if (outTimePos != std::string::npos) {
-              size_t colonPos = sidecar.find(':', outTimePos);
-              size_t quoteStart = sidecar.find('"', colonPos);
-              size_t quoteEnd = sidecar.find('"', quoteStart + 1);
-              if (quoteStart != std::string::npos && quoteEnd != std::string::npos) {
-                entry["sidecar_out_time"] = sidecar.substr(quoteStart + 1, quoteEnd - quoteStart - 1);
-              }
-            }
-          }
-        }
-        
-        // Extract sfc_time if available
-        size_t sfcTimePos = line.find("\"sfc_time\"");
-        if (sfcTimePos != std::string::npos) {
-          size_t colonPos = line.find(':', sfcTimePos);
-          size_t quoteStart = line.find('"', colonPos);
-          size_t quoteEnd = line.find('"', quoteStart + 1);
-          if (quoteStart != std::string::npos && quoteEnd != std::string::npos) {
-            entry["sfc_time"] = line.substr(quoteStart + 1, quoteEnd - quoteStart - 1);
-          }
-        }
-        
-        // Store entry with its timestamp
-        if (!entry.empty()) {
-          // Use service_call_in_time if available, otherwise use sidecar_in_time
-          std::string timeStr;
-          if (entry.find("service_call_in_time") != entry.end()) {
-            timeStr = entry["service_call_in_time"];
-          } else if (entry.find("sidecar_in_time") != entry.end()) {
-            timeStr = entry["sidecar_in_time"];
-          }
-          
-          if (!timeStr.empty()) {
-            auto entryTime = parseTimestampToTimePoint(timeStr);
-            if (entryTime != ndn::time::system_clock::time_point::min()) {
-              allEntries.push_back({entry, entryTime});
-              if (entryTime > latestTimestamp) {
-                latestTimestamp = entryTime;
-              }
-            } else {
-              // If timestamp parsing failed, include the entry with min timestamp (will be filtered out)
-              allEntries.push_back({entry, ndn::time::system_clock::time_point::min()});
-            }
-          } else {
-            // If no timestamp available, include the entry with min timestamp (will be filtered out)
-            allEntries.push_back({entry, ndn::time::system_clock::time_point::min()});
-          }
-        }
-      } catch (const std::exception& e) {
-        NLSR_LOG_WARN("Error parsing line " + std::to_string(lineCount) + ": " + std::string(e.what()));
+    auto steadyNow = ndn::time::steady_clock::now();
+
+    // Evaluate every function, and collect the updates to flood together
+    std::vector<std::pair<ndn::Name, ServiceFunctionInfo>> updates;
+    for (const auto& function : snapshot.functions) {
+      auto& advertiser = m_advertisers.at(function.prefix);
+      ServiceFunctionInfo sfInfo = function.info;
+
+      // Smooth the sample and flood it only if it changed enough
+      auto decision = advertiser.evaluate(sfInfo, steadyNow);
+      if (decision != AdvertisementController::Decision::ADVERTISE) {
+        NLSR_LOG_DEBUG("Not advertising ServiceFunctionInfo of " << function.prefix << " ("
+                       << (decision == AdvertisementController::Decision::DEFER ? "deferred" : "insignificant")
+                       << "): utilization=" << sfInfo.utilization << ", load=" << sfInfo.load
+                       << ", usageCount=" << sfInfo.usageCount
+                       << ", suppressed so far: " << advertiser.getNSuppressed());
         continue;
       }
+      updates.emplace_back(function.prefix, sfInfo);
     }
-    
-    // Second pass: Filter entries based on time window relative to latest timestamp
-    if (latestTimestamp == ndn::time::system_clock::time_point::min()) {
-      NLSR_LOG_DEBUG("No valid timestamps found in log entries");
-      return logEntries;
+    scheduleAdvertisementCheck();
+    if (updates.empty()) {
+      return;
     }
+
+    // Get the router's own NameLSA
+    const ndn::Name& routerPrefix = m_confParam->getRouterPrefix();
+    NLSR_LOG_DEBUG("Looking for NameLSA for router: " << routerPrefix);
+    auto nameLsa = m_lsdb->findLsa<NameLsa>(routerPrefix);
     
-    // Calculate time window: from (latestTimestamp - windowSeconds) to latestTimestamp
-    auto windowStart = latestTimestamp - boost::chrono::seconds(windowSeconds);
-    int entriesInWindow = 0;
-    
-    NLSR_LOG_DEBUG("Latest entry timestamp: " << boost::chrono::duration_cast<boost::chrono::seconds>(latestTimestamp.time_since_epoch()).count()
-                  << ", window start: " << boost::chrono::duration_cast<boost::chrono::seconds>(windowStart.time_since_epoch()).count()
-                  << ", window duration: " << windowSeconds << " seconds");
+    if (!nameLsa) {
+      NLSR_LOG_WARN("Own NameLSA not found, cannot update Service Function info");
+      return;
+    }
     
-    for (const auto& [entry, entryTime] : allEntries) {
-      if (entryTime >= windowStart && entryTime <= latestTimestamp) {
-        logEntries.push_back(entry);
-        entriesInWindow++;
-      }
+    // Update the Service Function information of all the functions at once
+    for (const auto& [servicePrefix, sfInfo] : updates) {
+      nameLsa->setServiceFunctionInfo(servicePrefix, sfInfo);
+      NLSR_LOG_DEBUG("ServiceFunctionInfo of " << servicePrefix << ": utilization=" << sfInfo.utilization
+                     << ", load=" << sfInfo.load << ", usageCount=" << sfInfo.usageCount
+                     << ", utilizationTrend=" << sfInfo.utilizationTrend << "/s");
     }
     
-    NLSR_LOG_DEBUG("Parsed " << entriesInWindow << " entries within time window (total lines: " << lineCount 
-                  << ", total entries: " << allEntries.size() << ")");
+    // Rebuild and install the updated NameLSA
+    // This will increment the sequence number and trigger sync
+    NLSR_LOG_DEBUG("Rebuilding and installing NameLSA...");
+    m_lsdb->buildAndInstallOwnNameLsa();
+    
+    NLSR_LOG_INFO("Updated NameLSA with Service Function info of " << updates.size() << " of "
+                  << snapshot.functions.size() << " functions");
   }
   catch (const std::exception& e) {
-    NLSR_LOG_ERROR("Error reading log file: " + std::string(e.what()));
+    NLSR_LOG_ERROR("Error updating NameLSA with stats: " + std::string(e.what()));
   }
-  
-  return logEntries;
 }
 
-double
-SidecarStatsHandler::calculateUtilization(const std::vector<std::map<std::string, std::string>>& entries,
-                                           uint32_t windowSeconds) const
+void
+SidecarStatsHandler::scheduleAdvertisementCheck()
 {
-  if (entries.empty() || windowSeconds == 0) {
-    return 0.0;
+  if (m_scheduler == nullptr) {
+    return;
   }
-  
-  // Helper function to parse timestamp string to seconds since epoch
-  auto parseTimestamp = [](const std::string& timestamp) -> double {
-    try {
-      if (timestamp.length() < 19) {
-        return 0.0;
-      }
-      
-      int year = std::stoi(timestamp.substr(0, 4));
-      int month = std::stoi(timestamp.substr(5, 2));
-      int day = std::stoi(timestamp.substr(8, 2));
-      int hour = std::stoi(timestamp.substr(11, 2));
-      int minute = std::stoi(timestamp.substr(14, 2));
-      int second = std::stoi(timestamp.substr(17, 2));
-      double microsecond = 0.0;
-      
-      if (timestamp.length() > 19) {
-        std::string microsecStr = timestamp.substr(20);
-        if (!microsecStr.empty()) {
-          microsecond = std::stod("0." + microsecStr);
-        }
-      }
-      
-      std::tm timeinfo = {};
-      timeinfo.tm_year = year - 1900;
-      timeinfo.tm_mon = month - 1;
-      timeinfo.tm_mday = day;
-      timeinfo.tm_hour = hour;
-      timeinfo.tm_min = minute;
-      timeinfo.tm_sec = second;
-      
-      std::time_t time = std::mktime(&timeinfo);
-      return static_cast<double>(time) + microsecond;
-    } catch (const std::exception&) {
-      return 0.0;
-    }
-  };
-  
-  double totalProcessingTime = 0.0;
-  int validEntries = 0;
-  
-  // Calculate total processing time from all entries
-  for (const auto& entry : entries) {
-    double processingTime = 0.0;
-    
-    // Priority: 1) service_call times, 2) sidecar times
-    if (entry.find("service_call_in_time") != entry.end() && 
-        entry.find("service_call_out_time") != entry.end()) {
-      try {
-        double inTime = parseTimestamp(entry.at("service_call_in_time"));
-        double outTime = parseTimestamp(entry.at("service_call_out_time"));
-        if (inTime > 0.0 && outTime > 0.0) {
-          processingTime = outTime - inTime;
-        }
-      } catch (const std::exception&) {
-        // Skip this entry
-        continue;
-      }
-    } else if (entry.find("sidecar_in_time") != entry.end() && 
-               entry.find("sidecar_out_time") != entry.end()) {
-      try {
-        double inTime = parseTimestamp(entry.at("sidecar_in_time"));
-        double outTime = parseTimestamp(entry.at("sidecar_out_time"));
-        if (inTime > 0.0 && outTime > 0.0) {
-          processingTime = outTime - inTime;
-        }
-      } catch (const std::exception&) {
-        // Skip this entry
-        continue;
-      }
-    }
-    
-    if (processingTime > 0.0) {
-      totalProcessingTime += processingTime;
-      validEntries++;
-    }
+
+  auto nextCheckTime = ndn::time::steady_clock::time_point::max();
+  for (const auto& [prefix, advertiser] : m_advertisers) {
+    nextCheckTime = std::min(nextCheckTime, advertiser.getNextCheckTime());
   }
-  
-  // Calculate utilization: total processing time / time window
-  double utilization = totalProcessingTime / static_cast<double>(windowSeconds);
-  
-  // Clamp to [0.0, 1.0] (utilization cannot exceed 100%)
-  if (utilization > 1.0) {
-    utilization = 1.0;
+  if (nextCheckTime == ndn::time::steady_clock::time_point::max()) {
+    return;
   }
-  
-  NLSR_LOG_DEBUG("Calculated utilization: " << utilization 
-                 << " (totalProcessingTime=" << totalProcessingTime 
-                 << "s, windowSeconds=" << windowSeconds 
-                 << ", validEntries=" << validEntries << ")");
-  
-  return utilization;
+
+  auto delay = nextCheckTime - ndn::time::steady_clock::now();
+  m_advertisementCheckEvent = m_scheduler->schedule(std::max<ndn::time::nanoseconds>(delay, 0_ns), [this] {
+    NLSR_LOG_DEBUG("Advertisement check triggered");
+    updateNameLsaWithStats();
+  });
 }
 
-ServiceFunctionInfo
-SidecarStatsHandler::convertStatsToServiceFunctionInfo() const
+void
+SidecarStatsHandler::startLogMonitoring(boost::asio::io_context& io, ndn::Scheduler& scheduler,
+                                        uint32_t pollIntervalMs)
 {
-  ServiceFunctionInfo info;
-  
-  // Initialize with default values
-  info.utilization = 0.0;  // 利用率（0.0 ~ 1.0）
-  info.load = 0.0;
-  info.usageCount = 0;
-  info.lastUpdateTime = ndn::time::system_clock::now();
-  info.processingWeight = 0.4;  // Default weight
-  info.loadWeight = 0.4;       // Default weight
-  info.usageWeight = 0.2;       // Default weight
+  NLSR_LOG_INFO("startLogMonitoring called with poll interval: " << pollIntervalMs << "ms, "
+                << m_logSources.size() << " log files, " << m_functions.size() << " functions");
   
-  if (!m_confParam) {
-    NLSR_LOG_WARN("ConfParameter not available, cannot calculate utilization");
-    return info;
+  if (!m_lsdb || !m_confParam) {
+    NLSR_LOG_WARN("LSDB or ConfParameter not available, cannot start log monitoring");
+    return;
   }
   
-  // Get weight information from configuration file
-  info.processingWeight = m_confParam->getProcessingWeight();
-  info.loadWeight = m_confParam->getLoadWeight();
-  info.usageWeight = m_confParam->getUsageWeight();
-  
-  // Get time window from configuration
-  uint32_t windowSeconds = m_confParam->getUtilizationWindowSeconds();
-  NLSR_LOG_DEBUG("Calculating utilization with time window: " << windowSeconds << " seconds");
-  
-  // Parse log entries within time window (based on entry timestamps)
-  auto entries = parseSidecarLogWithTimeWindow(windowSeconds);
+  startIngestion(io, scheduler);
   
-  if (entries.empty()) {
-    NLSR_LOG_DEBUG("No log entries found within time window, returning default values");
-    return info;
-  }
-  
-  // Find the latest entry timestamp to set lastUpdateTime
-  // This is done by parsing all entries again to find the latest timestamp
-  auto parseTimestampToTimePoint = [](const std::string& timestamp) -> ndn::time::system_clock::time_point {
-    try {
-      if (timestamp.length() < 19) {
-        return ndn::time::system_clock::time_point::min();
+  SidecarLogWatcher::Options options;
+  options.minUpdateInterval = m_confParam->getSidecarMinUpdateInterval();
+  options.pollInterval = ndn::time::milliseconds(pollIntervalMs);
+  runIngestion([this, options] {
+    // Consume what the logs already hold; later checks only read appended lines
+    readNewLogEntries();
+    publishSnapshot(ingest(false));
+
+    for (auto& sourcePtr : m_logSources) {
+      auto& source = *sourcePtr;
+      if (source.path.empty() || source.functions.empty()) {
+        continue;
       }
-      
-      int year = std::stoi(timestamp.substr(0, 4));
-      int month = std::stoi(timestamp.substr(5, 2));
-      int day = std::stoi(timestamp.substr(8, 2));
-      int hour = std::stoi(timestamp.substr(11, 2));
-      int minute = std::stoi(timestamp.substr(14, 2));
-      int second = std::stoi(timestamp.substr(17, 2));
-      int microsecond = 0;
-      
-      if (timestamp.length() > 19) {
-        std::string microsecStr = timestamp.substr(20);
-        if (!microsecStr.empty() && microsecStr.length() <= 6) {
-          while (microsecStr.length() < 6) {
-            microsecStr += "0";
-          }
-          microsecStr = microsecStr.substr(0, 6);
-          microsecond = std::stoi(microsecStr);
+      source.watcher = std::make_unique<SidecarLogWatcher>(*m_ingestionIo, *m_ingestionScheduler, source.path,
+                                                           options, [this, &source] {
+        NLSR_LOG_DEBUG("Log monitoring check triggered for " << source.path);
+        if (readNewLogEntries(source) > 0) {
+          NLSR_LOG_INFO("Log file " << source.path << " changed, updating NameLSA (read offset: "
+                        << source.reader.getOffset() << ")");
+          publishSnapshot(ingest(true));
         }
-      }
-      
-      std::tm timeinfo = {};
-      timeinfo.tm_year = year - 1900;
-      timeinfo.tm_mon = month - 1;
-      timeinfo.tm_mday = day;
-      timeinfo.tm_hour = hour;
-      timeinfo.tm_min = minute;
-      timeinfo.tm_sec = second;
-      
-      std::time_t time = std::mktime(&timeinfo);
-      auto timePoint = ndn::time::system_clock::from_time_t(time);
-      timePoint += boost::chrono::microseconds(microsecond);
-      
-      return timePoint;
-    } catch (const std::exception&) {
-      return ndn::time::system_clock::time_point::min();
-    }
-  };
-  
-  auto latestTimestamp = ndn::time::system_clock::time_point::min();
-  for (const auto& entry : entries) {
-    std::string timeStr;
-    if (entry.find("service_call_in_time") != entry.end()) {
-      timeStr = entry.at("service_call_in_time");
-    } else if (entry.find("sidecar_in_time") != entry.end()) {
-      timeStr = entry.at("sidecar_in_time");
-    }
-    
-    if (!timeStr.empty()) {
-      auto entryTime = parseTimestampToTimePoint(timeStr);
-      if (entryTime != ndn::time::system_clock::time_point::min() && entryTime > latestTimestamp) {
-        latestTimestamp = entryTime;
-      }
+        else {
+          NLSR_LOG_DEBUG("Log file unchanged, skipping update");
+        }
+      });
+      source.watcher->start();
+
+      NLSR_LOG_INFO("Started log file monitoring (" << (source.watcher->isEventDriven() ? "inotify" : "polling")
+                    << "), logPath: " << source.path);
     }
-  }
-  
-  // Set lastUpdateTime to the latest entry timestamp
-  if (latestTimestamp != ndn::time::system_clock::time_point::min()) {
-    info.lastUpdateTime = latestTimestamp;
-  }
-  
-  // Check if the latest entry is too old (more than windowSeconds * 2 ago)
-  // If so, set utilization to 0
-  auto now = ndn::time::system_clock::now();
-  auto timeSinceLastUpdate = boost::chrono::duration_cast<boost::chrono::seconds>(now - latestTimestamp).count();
-  uint32_t staleThreshold = windowSeconds * 2;  // Consider stale if older than 2x window
-  
-  if (timeSinceLastUpdate > static_cast<int64_t>(staleThreshold)) {
-    NLSR_LOG_DEBUG("Latest entry is too old (" << timeSinceLastUpdate << "s ago, threshold: " << staleThreshold 
-                  << "s), setting utilization to 0");
-    info.utilization = 0.0;
-    return info;
-  }
-  
-  // Calculate utilization
-  info.utilization = calculateUtilization(entries, windowSeconds);
-  
-  NLSR_LOG_DEBUG("ServiceFunctionInfo: utilization=" << info.utilization 
-                 << " (calculated from " << entries.size() << " entries, lastUpdateTime: " 
-                 << boost::chrono::duration_cast<boost::chrono::seconds>(latestTimestamp.time_since_epoch()).count() << ")");
-  
-  return info;
+  });
 }
 
-ndn::Name
-SidecarStatsHandler::getServiceFunctionPrefix() const
+void
+SidecarStatsHandler::startShmIngestion(boost::asio::io_context& io, ndn::Scheduler& scheduler,
+                                       const std::string& shmName)
 {
-  // Get service function prefix from configuration
-  if (m_confParam) {
-    return m_confParam->getServiceFunctionPrefix();
-  }
-  // Return empty Name if ConfParameter is not available
-  // (no hardcoded default to maintain extensibility)
-  return ndn::Name();
+  NLSR_LOG_INFO("Starting shared-memory ingestion from " << shmName);
+  m_shmName = shmName;
+  startIngestion(io, scheduler);
+  runIngestion([this] { drainShmRing(); });
 }
 
 void
-SidecarStatsHandler::updateNameLsaWithStats()
+SidecarStatsHandler::startIngestion(boost::asio::io_context& io, ndn::Scheduler& scheduler)
 {
-  NLSR_LOG_DEBUG("updateNameLsaWithStats called");
-  
-  if (!m_lsdb || !m_confParam) {
-    NLSR_LOG_WARN("LSDB or ConfParameter not available, skipping NameLSA update");
+  m_mainIo = &io;
+  m_scheduler = &scheduler;
+  if (m_ingestionScheduler != nullptr) {
     return;
   }
-  
-  try {
-    // Convert statistics to ServiceFunctionInfo (now calculates utilization)
-    NLSR_LOG_DEBUG("Converting stats to ServiceFunctionInfo (utilization-based)...");
-    ServiceFunctionInfo sfInfo = convertStatsToServiceFunctionInfo();
-    
-    NLSR_LOG_DEBUG("ServiceFunctionInfo: utilization=" << sfInfo.utilization 
-                   << ", load=" << sfInfo.load 
-                   << ", usageCount=" << sfInfo.usageCount);
-    
-    // Get the router's own NameLSA
-    const ndn::Name& routerPrefix = m_confParam->getRouterPrefix();
-    NLSR_LOG_DEBUG("Looking for NameLSA for router: " << routerPrefix);
-    auto nameLsa = m_lsdb->findLsa<NameLsa>(routerPrefix);
-    
-    if (!nameLsa) {
-      NLSR_LOG_WARN("Own NameLSA not found, cannot update Service Function info");
-      return;
-    }
-    
-    // Get service function prefix
-    ndn::Name servicePrefix = getServiceFunctionPrefix();
-    NLSR_LOG_DEBUG("Service function prefix: " << servicePrefix);
-    
-    // Update Service Function information
-    nameLsa->setServiceFunctionInfo(servicePrefix, sfInfo);
-    NLSR_LOG_DEBUG("Service Function info set in NameLSA");
-    
-    // Rebuild and install the updated NameLSA
-    // This will increment the sequence number and trigger sync
-    NLSR_LOG_DEBUG("Rebuilding and installing NameLSA...");
-    m_lsdb->buildAndInstallOwnNameLsa();
-    
-    NLSR_LOG_INFO("Updated NameLSA with Service Function info: prefix=" << servicePrefix
-                  << ", utilization=" << sfInfo.utilization
-                  << ", load=" << sfInfo.load
-                  << ", usageCount=" << sfInfo.usageCount);
-  }
-  catch (const std::exception& e) {
-    NLSR_LOG_ERROR("Error updating NameLSA with stats: " + std::string(e.what()));
+
+  if (m_confParam == nullptr || !m_confParam->isSidecarIngestionThreadEnabled()) {
+    m_ingestionIo = &io;
+    m_ingestionScheduler = &scheduler;
+    return;
   }
+
+  m_ingestion = std::make_unique<IngestionThread>();
+  m_ingestionIo = &m_ingestion->io;
+  m_ingestionScheduler = &m_ingestion->scheduler;
+  m_ingestion->thread = std::thread([ingestionIo = m_ingestionIo] {
+    try {
+      ingestionIo->run();
+    }
+    catch (const std::exception& e) {
+      NLSR_LOG_ERROR("Sidecar ingestion thread stopped: " << e.what());
+    }
+  });
+  NLSR_LOG_INFO("Started the sidecar ingestion thread");
 }
 
 void
-SidecarStatsHandler::startLogMonitoring(ndn::Scheduler& scheduler, uint32_t intervalMs)
+SidecarStatsHandler::runIngestion(std::function<void()> task)
 {
-  NLSR_LOG_INFO("startLogMonitoring called with interval: " << intervalMs << "ms, logPath: " << m_logPath);
-  
-  if (!m_lsdb || !m_confParam) {
-    NLSR_LOG_WARN("LSDB or ConfParameter not available, cannot start log monitoring");
+  if (m_ingestion == nullptr) {
+    task();
     return;
   }
-  
-  // Calculate hash of current log file for change detection
-  try {
-    std::ifstream logFile(m_logPath);
-    if (!logFile.is_open()) {
-      NLSR_LOG_WARN("Cannot open log file for initial hash calculation: " + m_logPath);
-      m_lastLogHash = "";
-    } else {
-      std::string content((std::istreambuf_iterator<char>(logFile)),
-                          std::istreambuf_iterator<char>());
-      std::hash<std::string> hasher;
-      m_lastLogHash = std::to_string(hasher(content));
-      NLSR_LOG_DEBUG("Initial log file hash calculated: " << m_lastLogHash.substr(0, std::min(16UL, m_lastLogHash.size())) << "... (size: " << content.size() << " bytes)");
-    }
-  } catch (const std::exception& e) {
-    NLSR_LOG_ERROR("Error reading log file for initial hash: " + std::string(e.what()));
-    m_lastLogHash = "";
-  }
-  
-  // Schedule periodic monitoring
-  // Use shared_ptr to allow recursive scheduling of the same function
-  auto monitorFunc = std::make_shared<std::function<void()>>();
-  *monitorFunc = [this, &scheduler, intervalMs, monitorFunc]() {
-    NLSR_LOG_DEBUG("Log monitoring check triggered");
+  boost::asio::post(m_ingestion->io, std::move(task));
+}
+
+void
+SidecarStatsHandler::drainShmRing()
+{
+  if (!m_shmRing) {
     try {
-      // Read current log file
-      std::ifstream logFile(m_logPath);
-      if (!logFile.is_open()) {
-        NLSR_LOG_DEBUG("Cannot open log file for monitoring: " + m_logPath);
-        // Schedule next check using the same function
-        scheduler.schedule(ndn::time::milliseconds(intervalMs), *monitorFunc);
-        return;
-      }
-      
-      std::string content((std::istreambuf_iterator<char>(logFile)),
-                          std::istreambuf_iterator<char>());
-      std::hash<std::string> hasher;
-      std::string currentHash = std::to_string(hasher(content));
-      
-      std::string lastHashPreview = m_lastLogHash.empty() ? "(empty)" : m_lastLogHash.substr(0, std::min(16UL, m_lastLogHash.size()));
-      NLSR_LOG_DEBUG("Current log file hash: " << currentHash.substr(0, std::min(16UL, currentHash.size())) << "... (size: " << content.size() << " bytes), last hash: " << lastHashPreview << "...");
-      
-      // Check if log file has changed
-      if (m_lastLogHash.empty() || currentHash != m_lastLogHash) {
-        std::string oldHashPreview = m_lastLogHash.empty() ? "(empty)" : m_lastLogHash.substr(0, std::min(16UL, m_lastLogHash.size()));
-        NLSR_LOG_INFO("Log file changed, updating NameLSA (old hash: " << oldHashPreview << "..., new hash: " << currentHash.substr(0, std::min(16UL, currentHash.size())) << "...)");
-        m_lastLogHash = currentHash;
-        updateNameLsaWithStats();
-      } else {
-        NLSR_LOG_DEBUG("Log file unchanged, skipping update");
-      }
-      
-      // Schedule next check using the same function
-      scheduler.schedule(ndn::time::milliseconds(intervalMs), *monitorFunc);
+      m_shmRing = SidecarShmRing::open(m_shmName);
+      NLSR_LOG_INFO("Opened sidecar ring " << m_shmName << " with " << m_shmRing->getCapacity() << " slots");
     }
-    catch (const std::exception& e) {
-      NLSR_LOG_ERROR("Error in log monitoring: " + std::string(e.what()));
-      // Continue monitoring even on error
-      scheduler.schedule(ndn::time::milliseconds(intervalMs), *monitorFunc);
+    catch (const SidecarShmRing::Error& e) {
+      NLSR_LOG_TRACE("Sidecar ring not available: " << e.what());
+      m_shmDrainEvent = m_ingestionScheduler->schedule(SHM_OPEN_RETRY_INTERVAL, [this] { drainShmRing(); });
+      return;
     }
-  };
-  
-  scheduler.schedule(ndn::time::milliseconds(intervalMs), *monitorFunc);
-  NLSR_LOG_INFO("Started log file monitoring with interval: " << intervalMs << "ms, logPath: " << m_logPath);
+  }
+
+  size_t nDropped = 0;
+  size_t nRecords = m_shmRing->drain([this, &nDropped] (const SidecarCallRecord& callRecord) {
+    if (!addRecord(callRecord)) {
+      ++nDropped;
+    }
+  });
+  if (nDropped > 0) {
+    NLSR_LOG_WARN("Dropped " << nDropped << " records of " << m_shmName
+                  << " whose call_name belongs to no function-source");
+  }
+  if (nRecords > 0) {
+    NLSR_LOG_DEBUG("Drained " << nRecords << " records from " << m_shmName
+                   << ", " << m_shmRing->getNDropped() << " dropped by the sidecar so far");
+    publishSnapshot(ingest(true));
+  }
+  else if (m_shmRing->isClosed()) {
+    NLSR_LOG_INFO("Sidecar closed ring " << m_shmName << ", waiting for a new one");
+    m_shmRing.reset();
+  }
+
+  m_shmDrainEvent = m_ingestionScheduler->schedule(SHM_DRAIN_INTERVAL, [this] { drainShmRing(); });
 }
 
-} // namespace nlsr 
\ No newline at end of file
+} // namespace nlsr
@@ -22,10 +22,25 @@
 #ifndef NLSR_PUBLISHER_SIDECAR_STATS_HANDLER_HPP
 #define NLSR_PUBLISHER_SIDECAR_STATS_HANDLER_HPP
 
+#include "advertisement-controller.hpp"
+#include "function-monitor.hpp"
+#include "latest-value-slot.hpp"
+#include "sidecar-log-reader.hpp"
+#include "sidecar-log-watcher.hpp"
+#include "sidecar-shm-ring.hpp"
+#include "sidecar-record.hpp"
+#include "test-access-control.hpp"
+
 #include <ndn-cxx/face.hpp>
 #include <ndn-cxx/mgmt/dispatcher.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
 #include <boost/noncopyable.hpp>
+#include <memory>
+#include <optional>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 #include <map>
 
@@ -34,6 +49,7 @@ namespace nlsr {
 // Forward declarations
 class Lsdb;
 class ConfParameter;
+class NamePrefixTable;
 
 // Forward declaration for ServiceFunctionInfo
 struct ServiceFunctionInfo;
@@ -48,6 +64,20 @@ inline const ndn::PartialName FUNCTION_INFO_DATASET{"function-info"};
 /*!
    \brief Class to publish sidecar statistics dataset
    \sa https://redmine.named-data.net/projects/nlsr/wiki/Sidecar_Stats_DataSet
+
+   Each Service Function hosted on the router has its own FunctionMonitor. A function
+   reads either its own log, or the records of a shared log with its call_name (see
+   ServiceFunctionSource); each log is read and parsed once for all the functions it
+   feeds. Records from the shared-memory ring are handled as records of the default log.
+   Without any function-source, all records of the default log belong to the first
+   function prefix.
+
+   With sidecar-ingestion-thread, the logs and the ring are read, and the records
+   aggregated, on a dedicated thread, so reading a large log does not delay the routing
+   protocol. That thread publishes a StatsSnapshot of all the functions through a
+   LatestValueSlot; the main thread only decides whether to advertise it and serves the
+   datasets from it. FunctionMonitor and LogSource are then only used by the ingestion
+   thread, and AdvertisementController and the Name LSA only by the main thread.
  */
 class SidecarStatsHandler : boost::noncopyable
 {
@@ -67,10 +97,14 @@ public:
                       ConfParameter& confParam,
                       const std::string& logPath = "/var/log/sidecar/service.log");
 
+  /*! \brief Stop the ingestion thread, if started
+  */
+  ~SidecarStatsHandler();
+
 public:
-  /*! \brief Get current sidecar statistics for external access
+  /*! \brief Get current sidecar statistics for external access, per function prefix
   */
-  std::map<std::string, std::string>
+  std::map<ndn::Name, std::map<std::string, std::string>>
   getCurrentStats() const;
 
   /*! \brief Check if the handler is properly registered
@@ -78,21 +112,53 @@ public:
   bool
   isRegistered() const { return m_isRegistered; }
 
-  /*! \brief Get the log file path
+  /*! \brief Get the path of the default log file
   */
   std::string
   getLogPath() const { return m_logPath; }
 
+  /*! \brief Show the site selection of each function prefix in the function-info dataset
+   *  \param namePrefixTable The table, or nullptr; must outlive this handler
+   */
+  void
+  setNamePrefixTable(const NamePrefixTable* namePrefixTable)
+  {
+    m_namePrefixTable = namePrefixTable;
+  }
+
   /*! \brief Update NameLSA with latest sidecar statistics
+   *
+   *  The info of each function is only updated when its AdvertisementController lets the
+   *  update through, and the own NameLSA is rebuilt once for all the functions updated;
+   *  once log monitoring has started, a suppressed or deferred update is evaluated again
+   *  at the earliest AdvertisementController::getNextCheckTime(). Once the ingestion thread
+   *  has started, the statistics are sampled on that thread and the update happens when
+   *  the main io_context receives them.
    */
   void
   updateNameLsaWithStats();
 
-  /*! \brief Start monitoring log file for changes (polling-based)
-   *  \param intervalMs Polling interval in milliseconds
+  /*! \brief Start monitoring the log files for changes
+   *
+   *  Changes are detected with inotify where available (see SidecarLogWatcher), and each
+   *  check reads only the lines appended since the previous one (see SidecarLogReader).
+   *  The logs are watched from the ingestion thread if sidecar-ingestion-thread is set.
+   *  \param io The main io_context, where the Name LSA is updated
+   *  \param pollIntervalMs Polling interval in milliseconds if inotify is not available
+   */
+  void
+  startLogMonitoring(boost::asio::io_context& io, ndn::Scheduler& scheduler,
+                     uint32_t pollIntervalMs = 5000);
+
+  /*! \brief Start draining call records from the shared-memory ring \p shmName
+   *
+   *  The ring is created by the sidecar (see SidecarShmRing) and opened once it exists;
+   *  it is drained every few milliseconds, from the ingestion thread if
+   *  sidecar-ingestion-thread is set. The log file, if configured, is still monitored, so
+   *  a sidecar can use either channel.
    */
   void
-  startLogMonitoring(ndn::Scheduler& scheduler, uint32_t intervalMs = 5000);
+  startShmIngestion(boost::asio::io_context& io, ndn::Scheduler& scheduler, const std::string& shmName);
 
 private:
   /*! \brief provide sidecar statistics dataset
@@ -119,49 +185,215 @@ private:
   publishFunctionInfo(const ndn::Name& topPrefix, const ndn::Interest& interest,
                       ndn::mgmt::StatusDatasetContext& context);
 
-  /*! \brief parse sidecar log file
-  */
-  std::vector<std::map<std::string, std::string>>
-  parseSidecarLog() const;
+  struct CachedContent
+  {
+    /// stats version the content was encoded from; 0 if never encoded
+    uint64_t version = 0;
+    ndn::Block content;
+  };
 
-  /*! \brief parse sidecar log file with time window
-   *  \param windowSeconds Time window in seconds
+  /*! \brief Reply with the content of a dataset, encoded by \p makeContent only if the
+   *         stats changed since \p cache was filled
+   *
+   *  The log is read at most once per freshness period, and not at all once the ingestion
+   *  thread has started, so a monitoring system polling several datasets often costs one
+   *  cache lookup per request.
    */
-  std::vector<std::map<std::string, std::string>>
-  parseSidecarLogWithTimeWindow(uint32_t windowSeconds) const;
+  void
+  publishCachedContent(CachedContent& cache, ndn::mgmt::StatusDatasetContext& context,
+                       const std::function<std::string()>& makeContent);
+
+  /*! \brief Read the entries appended to the log files since the previous call
+   *  \return Number of new entries
+   */
+  size_t
+  readNewLogEntries();
 
-  /*! \brief get latest statistics
+  /*! \brief A log file and the functions whose records it holds
+   */
+  struct LogSource
+  {
+    explicit
+    LogSource(const std::string& path)
+      : path(path)
+      , reader(path)
+    {
+    }
+
+    std::string path;
+    SidecarLogReader reader;
+    std::unique_ptr<SidecarLogWatcher> watcher;
+    /// functions by call_name; the function under "" takes the records no other one takes
+    std::unordered_map<std::string, FunctionMonitor*> functions;
+  };
+
+  size_t
+  readNewLogEntries(LogSource& source);
+
+  /*! \brief Add a record of \p source to the function it belongs to
+   *  \return false if the record belongs to no function and was dropped
+   */
+  bool
+  addRecord(LogSource& source, const SidecarRecord& record);
+
+  void
+  addRecord(FunctionMonitor& function, const SidecarRecord& record);
+
+  /*! \brief Create the FunctionMonitor of \p prefix, fed by the log at \p logPath
+   */
+  void
+  addFunction(const ndn::Name& prefix, const std::string& callName, const std::string& logPath,
+              const FunctionMonitor::Options& options,
+              const AdvertisementController::Options& advertisementOptions);
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /*! \brief The statistics of a function at the time of a StatsSnapshot
+   */
+  struct FunctionSnapshot
+  {
+    ndn::Name prefix;
+    ServiceFunctionInfo info;
+    std::map<std::string, std::string> stats;
+    std::optional<SidecarRecord> latestRecord;
+    LatencySketch serviceTime;
+    LatencySketch overhead;
+  };
+
+  /*! \brief The statistics of all the functions, handed from ingestion to the main thread
+   */
+  struct StatsSnapshot
+  {
+    /// whether the info was sampled for advertisement, see FunctionMonitor::update()
+    bool isSample = false;
+    std::vector<FunctionSnapshot> functions;
+  };
+
+  /*! \brief Take a snapshot of the statistics of every function
+   *
+   *  Runs where the records are ingested.
+   *  \param isSampling Whether to sample the info for advertisement, which also ends the
+   *                    overloads nothing completed recently
+   */
+  std::unique_ptr<StatsSnapshot>
+  ingest(bool isSampling);
+
+  /*! \brief Hand \p snapshot to the main thread
+   */
+  void
+  publishSnapshot(std::unique_ptr<StatsSnapshot> snapshot);
+
+  /*! \brief Install \p snapshot on the main thread, and advertise it if it is a sample
+   */
+  void
+  applySnapshot(std::shared_ptr<const StatsSnapshot> snapshot);
+
+  /*! \brief Update the own NameLSA with the info of \p snapshot that is worth flooding
+   */
+  void
+  advertise(const StatsSnapshot& snapshot);
+
+private:
+  /*! \brief Choose where records are ingested, starting the ingestion thread if enabled
+   */
+  void
+  startIngestion(boost::asio::io_context& io, ndn::Scheduler& scheduler);
+
+  /*! \brief Run \p task where records are ingested
+   */
+  void
+  runIngestion(std::function<void()> task);
+
+  /*! \brief Drain the shared-memory ring and schedule the next drain
+   */
+  void
+  drainShmRing();
+
+  /*! \brief get latest statistics, per function prefix
   */
-  std::map<std::string, std::string>
+  std::map<ndn::Name, std::map<std::string, std::string>>
   getLatestStats() const;
 
-  /*! \brief Calculate utilization from log entries
-   *  \param entries Log entries within time window
-   *  \param windowSeconds Time window in seconds
-   *  \return Utilization (0.0 ~ 1.0)
+private:
+  /*! \brief Schedule the next evaluation of the own Service Function info
    */
-  double
-  calculateUtilization(const std::vector<std::map<std::string, std::string>>& entries,
-                       uint32_t windowSeconds) const;
+  void
+  scheduleAdvertisementCheck();
 
-private:
-  /*! \brief Convert statistics map to ServiceFunctionInfo
-   *  Now calculates utilization instead of single request processing time
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /*! \brief Add a record read from the default log file
+   *
+   *  Must be called where the records are ingested.
+   *  \return false if the record belongs to no function and was dropped
    */
-  ServiceFunctionInfo
-  convertStatsToServiceFunctionInfo() const;
+  bool
+  addRecord(const SidecarRecord& record);
 
-  /*! \brief Get the prefix name for service function
+  /*! \brief Add a record of the shared-memory ring to the function whose call_name hash
+   *         it carries, or else to the function taking all the records of the default log
+   *  \return false if the record belongs to no function and was dropped
    */
-  ndn::Name
-  getServiceFunctionPrefix() const;
+  bool
+  addRecord(const SidecarCallRecord& callRecord);
 
 private:
   std::string m_logPath;
   bool m_isRegistered = false;  // Add registration status flag
   Lsdb* m_lsdb = nullptr;  // Pointer to LSDB (optional, for NameLSA updates)
   ConfParameter* m_confParam = nullptr;  // Pointer to ConfParameter (optional)
-  std::string m_lastLogHash;  // Hash of last processed log content for change detection
+  const NamePrefixTable* m_namePrefixTable = nullptr;
+  /// time zone of the log timestamps; set at construction, read where the records are ingested
+  SidecarTimeZone m_logTimeZone = SidecarTimeZone::LOCAL;
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /// hosted functions, in configuration order; used where the records are ingested
+  std::vector<std::unique_ptr<FunctionMonitor>> m_functions;
+  /// log files; the first one is the default log
+  std::vector<std::unique_ptr<LogSource>> m_logSources;
+  /// functions of the default log by SidecarCallRecord::hashCallName() of their call_name
+  std::unordered_map<uint32_t, FunctionMonitor*> m_shmFunctions;
+  /// records added since the latest snapshot
+  size_t m_nNewRecords = 0;
+
+  /// advertisement gate of each function; used on the main thread
+  std::map<ndn::Name, AdvertisementController> m_advertisers;
+  /// latest statistics received on the main thread
+  std::shared_ptr<const StatsSnapshot> m_snapshot;
+
+private:
+  boost::asio::io_context* m_mainIo = nullptr;
+  ndn::Scheduler* m_scheduler = nullptr;
+  ndn::scheduler::ScopedEventId m_advertisementCheckEvent;
+
+  /*! \brief The thread that reads and aggregates the sidecar records
+   */
+  struct IngestionThread
+  {
+    boost::asio::io_context io;
+    boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work{io.get_executor()};
+    ndn::Scheduler scheduler{io};
+    std::thread thread;
+  };
+
+  std::unique_ptr<IngestionThread> m_ingestion;
+  /// where the logs are watched and the ring is drained; null until ingestion starts
+  boost::asio::io_context* m_ingestionIo = nullptr;
+  ndn::Scheduler* m_ingestionScheduler = nullptr;
+  /// snapshots published by the ingestion thread; the main thread takes the latest one
+  std::shared_ptr<LatestValueSlot<StatsSnapshot>> m_snapshotSlot =
+    std::make_shared<LatestValueSlot<StatsSnapshot>>();
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /// incremented whenever a snapshot is installed
+  uint64_t m_statsVersion = 1;
+  ndn::time::steady_clock::time_point m_lastDatasetRefresh;
+  CachedContent m_sidecarStatsCache;
+  CachedContent m_serviceStatsCache;
+  CachedContent m_sfcStatsCache;
+  CachedContent m_functionInfoCache;
+
+private:
+  std::string m_shmName;
+  std::unique_ptr<SidecarShmRing> m_shmRing;
+  ndn::scheduler::ScopedEventId m_shmDrainEvent;
 };
 
 } // namespace nlsr
@@ -0,0 +1,181 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sidecar-stats-window.hpp"
+
+#include <algorithm>
+
+namespace nlsr {
+
+SidecarStatsWindow::SidecarStatsWindow(int64_t windowLength, int64_t bucketLength)
+  : m_bucketLength(std::max<int64_t>(bucketLength, 1))
+  , m_buckets(static_cast<size_t>(std::max<int64_t>((windowLength + m_bucketLength - 1) / m_bucketLength, 1)))
+{
+}
+
+void
+SidecarStatsWindow::add(const SidecarRecord& record)
+{
+  int64_t timestamp = record.getTimestamp();
+  if (timestamp <= 0) {
+    return;
+  }
+
+  int64_t index = timestamp / m_bucketLength;
+  if (index > m_headIndex) {
+    advanceTo(index);
+  }
+  else if (index <= m_headIndex - static_cast<int64_t>(m_buckets.size())) {
+    // older than the window
+    return;
+  }
+  m_latestTimestamp = std::max(m_latestTimestamp, timestamp);
+  m_occupancyCache.reset();
+
+  Bucket& bucket = m_buckets[static_cast<size_t>(index) % m_buckets.size()];
+  int64_t busyTime = record.getProcessingTime();
+  uint64_t nBytes = record.inDataSize + record.outDataSize;
+  bucket.busyTime += busyTime;
+  bucket.nRequests += 1;
+  bucket.nBytes += nBytes;
+  if (auto interval = record.getProcessingInterval(); interval && interval->second > interval->first) {
+    bucket.intervals.push_back(*interval);
+    m_latestEnd = std::max(m_latestEnd, interval->second);
+    bucket.serviceTime.record(busyTime);
+    m_serviceTime.record(busyTime);
+  }
+  if (auto overhead = record.getSidecarOverhead()) {
+    bucket.overhead.record(*overhead);
+    m_overhead.record(*overhead);
+  }
+  if (auto delay = record.getQueueingDelay()) {
+    bucket.queueingTime += *delay;
+    bucket.nQueued += 1;
+    m_queueingTime += *delay;
+    m_nQueued += 1;
+  }
+  m_busyTime += busyTime;
+  m_nRequests += 1;
+  m_nBytes += nBytes;
+}
+
+void
+SidecarStatsWindow::advanceTo(int64_t bucketIndex)
+{
+  int64_t nBuckets = static_cast<int64_t>(m_buckets.size());
+  if (m_headIndex < 0 || bucketIndex - m_headIndex >= nBuckets) {
+    // the whole window moves past its previous contents
+    for (auto& bucket : m_buckets) {
+      evict(bucket);
+    }
+  }
+  else {
+    for (int64_t index = m_headIndex + 1; index <= bucketIndex; ++index) {
+      evict(m_buckets[static_cast<size_t>(index) % m_buckets.size()]);
+    }
+  }
+  m_headIndex = bucketIndex;
+}
+
+void
+SidecarStatsWindow::evict(Bucket& bucket)
+{
+  m_busyTime -= bucket.busyTime;
+  m_nRequests -= bucket.nRequests;
+  m_nBytes -= bucket.nBytes;
+  m_queueingTime -= bucket.queueingTime;
+  m_nQueued -= bucket.nQueued;
+  m_serviceTime.subtract(bucket.serviceTime);
+  m_overhead.subtract(bucket.overhead);
+
+  bucket.busyTime = 0;
+  bucket.nRequests = 0;
+  bucket.nBytes = 0;
+  bucket.queueingTime = 0;
+  bucket.nQueued = 0;
+  bucket.serviceTime.clear();
+  bucket.overhead.clear();
+  // keeps the allocated capacity for the next use of the bucket
+  bucket.intervals.clear();
+}
+
+SidecarStatsWindow::Occupancy
+SidecarStatsWindow::getOccupancy(uint32_t capacity) const
+{
+  capacity = std::max<uint32_t>(capacity, 1);
+  if (m_occupancyCache && m_occupancyCache->first == capacity) {
+    return m_occupancyCache->second;
+  }
+
+  Occupancy occupancy;
+  if (m_headIndex >= 0) {
+    // a request is logged when it completes, so the log has reached the latest end time
+    int64_t windowEnd = std::max(m_latestEnd, m_latestTimestamp);
+    int64_t windowStart = windowEnd - getWindowLength();
+
+    // +1 when a request starts, -1 when it ends; intervals are clipped to the window
+    std::vector<std::pair<int64_t, int>> events;
+    for (const auto& bucket : m_buckets) {
+      for (const auto& [start, end] : bucket.intervals) {
+        int64_t clippedStart = std::max(start, windowStart);
+        int64_t clippedEnd = std::min(end, windowEnd);
+        if (clippedStart < clippedEnd) {
+          events.emplace_back(clippedStart, 1);
+          events.emplace_back(clippedEnd, -1);
+        }
+      }
+    }
+    std::sort(events.begin(), events.end());
+
+    double inFlightTime = 0.0;
+    double servedTime = 0.0;
+    int64_t inFlight = 0;
+    int64_t previous = windowStart;
+    for (const auto& [time, delta] : events) {
+      double elapsed = static_cast<double>(time - previous);
+      inFlightTime += elapsed * inFlight;
+      servedTime += elapsed * std::min<int64_t>(inFlight, capacity);
+      inFlight += delta;
+      previous = time;
+    }
+
+    double windowLength = static_cast<double>(getWindowLength());
+    occupancy.meanConcurrency = inFlightTime / windowLength;
+    occupancy.utilization = std::min(servedTime / (windowLength * capacity), 1.0);
+  }
+
+  m_occupancyCache.emplace(capacity, occupancy);
+  return occupancy;
+}
+
+double
+SidecarStatsWindow::getRequestRate() const
+{
+  return static_cast<double>(m_nRequests) * 1e6 / getWindowLength();
+}
+
+double
+SidecarStatsWindow::getThroughput() const
+{
+  return static_cast<double>(m_nBytes) * 1e6 / getWindowLength();
+}
+
+} // namespace nlsr
@@ -0,0 +1,209 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_PUBLISHER_SIDECAR_STATS_WINDOW_HPP
+#define NLSR_PUBLISHER_SIDECAR_STATS_WINDOW_HPP
+
+#include "latency-sketch.hpp"
+#include "sidecar-record.hpp"
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace nlsr {
+
+/*! \brief Sliding-window totals of sidecar records, kept in a ring of time buckets.
+
+  Each record is added to the bucket of its timestamp (SidecarRecord::getTimestamp()).
+  The window ends at the bucket of the latest timestamp seen so far and spans
+  <tt>windowLength / bucketLength</tt> buckets; buckets that fall out of it are subtracted
+  from the running totals when the window moves forward. Reading the totals is therefore
+  O(1), and adding a record is amortized O(1), however long the log is.
+
+  Requests served in parallel overlap, so their summed processing time can exceed the
+  window. getOccupancy() therefore sweeps over the processing intervals and integrates
+  the number of requests in flight over the window length, up to the latest end time.
+  The result is cached until the next record is added.
+
+  All times are in microseconds.
+ */
+class SidecarStatsWindow
+{
+public:
+  static constexpr int64_t DEFAULT_BUCKET_LENGTH = 100000;
+
+  struct Occupancy
+  {
+    /// average number of requests in flight over the window
+    double meanConcurrency = 0.0;
+    /// fraction of the worker capacity in use over the window, 0.0 ~ 1.0
+    double utilization = 0.0;
+  };
+
+  explicit
+  SidecarStatsWindow(int64_t windowLength, int64_t bucketLength = DEFAULT_BUCKET_LENGTH);
+
+  /*! \brief Adds a record.
+
+    Records without a timestamp and records older than the window are ignored.
+   */
+  void
+  add(const SidecarRecord& record);
+
+  int64_t
+  getWindowLength() const
+  {
+    return static_cast<int64_t>(m_buckets.size()) * m_bucketLength;
+  }
+
+  /*! \brief Returns the latest record timestamp, or 0 if no record was added.
+   */
+  int64_t
+  getLatestTimestamp() const
+  {
+    return m_latestTimestamp;
+  }
+
+  /*! \brief Returns the total processing time of the requests in the window.
+   */
+  int64_t
+  getBusyTime() const
+  {
+    return m_busyTime;
+  }
+
+  uint64_t
+  getNRequests() const
+  {
+    return m_nRequests;
+  }
+
+  /*! \brief Returns the input and output bytes of the requests in the window.
+   */
+  uint64_t
+  getNBytes() const
+  {
+    return m_nBytes;
+  }
+
+  /*! \brief Returns the mean processing time of the requests in the window, or 0.
+   */
+  double
+  getMeanProcessingTime() const
+  {
+    return m_nRequests > 0 ? static_cast<double>(m_busyTime) / m_nRequests : 0.0;
+  }
+
+  /*! \brief Returns the mean queueing delay of the requests in the window, or 0.
+
+    Only requests with a known delay (see SidecarRecord::getQueueingDelay) are counted.
+   */
+  double
+  getMeanQueueingDelay() const
+  {
+    return m_nQueued > 0 ? static_cast<double>(m_queueingTime) / m_nQueued : 0.0;
+  }
+
+  /*! \brief Returns the distribution of the processing times in the window.
+   */
+  const LatencySketch&
+  getServiceTimeSketch() const
+  {
+    return m_serviceTime;
+  }
+
+  /*! \brief Returns the distribution of the sidecar overheads in the window.
+    \sa SidecarRecord::getSidecarOverhead
+   */
+  const LatencySketch&
+  getOverheadSketch() const
+  {
+    return m_overhead;
+  }
+
+  /*! \brief Returns the in-flight requests over the window, for \p capacity workers.
+
+    At any moment, at most \p capacity requests count as being served; the others are
+    waiting. With one worker, the utilization is the fraction of the window covered by
+    the union of the processing intervals.
+   */
+  Occupancy
+  getOccupancy(uint32_t capacity = 1) const;
+
+  /*! \brief Returns getOccupancy(capacity).utilization.
+   */
+  double
+  getUtilization(uint32_t capacity = 1) const
+  {
+    return getOccupancy(capacity).utilization;
+  }
+
+  /*! \brief Returns the requests per second in the window.
+   */
+  double
+  getRequestRate() const;
+
+  /*! \brief Returns the bytes per second in the window.
+   */
+  double
+  getThroughput() const;
+
+private:
+  struct Bucket
+  {
+    int64_t busyTime = 0;
+    uint64_t nRequests = 0;
+    uint64_t nBytes = 0;
+    int64_t queueingTime = 0;
+    uint64_t nQueued = 0;
+    LatencySketch serviceTime;
+    LatencySketch overhead;
+    std::vector<std::pair<int64_t, int64_t>> intervals;
+  };
+
+  void
+  advanceTo(int64_t bucketIndex);
+
+  void
+  evict(Bucket& bucket);
+
+private:
+  int64_t m_bucketLength;
+  std::vector<Bucket> m_buckets;
+  int64_t m_headIndex = -1;
+  int64_t m_latestTimestamp = 0;
+  int64_t m_latestEnd = 0;
+
+  int64_t m_busyTime = 0;
+  uint64_t m_nRequests = 0;
+  uint64_t m_nBytes = 0;
+  int64_t m_queueingTime = 0;
+  uint64_t m_nQueued = 0;
+  LatencySketch m_serviceTime;
+  LatencySketch m_overhead;
+
+  mutable std::optional<std::pair<uint32_t, Occupancy>> m_occupancyCache;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_PUBLISHER_SIDECAR_STATS_WINDOW_HPP
@@ -0,0 +1,75 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "trend-forecaster.hpp"
+
+#include <algorithm>
+
+namespace nlsr {
+
+namespace {
+
+double
+toSeconds(ndn::time::nanoseconds duration)
+{
+  return duration.count() / 1e9;
+}
+
+} // anonymous namespace
+
+TrendForecaster::TrendForecaster(const Options& options)
+  : m_options(options)
+{
+  m_options.levelSmoothing = std::clamp(m_options.levelSmoothing, 1e-3, 1.0);
+  m_options.trendSmoothing = std::clamp(m_options.trendSmoothing, 1e-3, 1.0);
+}
+
+void
+TrendForecaster::update(double value, ndn::time::system_clock::time_point time)
+{
+  if (!m_lastTime) {
+    m_lastTime = time;
+    m_level = value;
+    return;
+  }
+  if (time <= *m_lastTime) {
+    // an idle function stops projecting its last slope
+    m_trend *= 1.0 - m_options.trendSmoothing;
+    return;
+  }
+
+  double elapsed = toSeconds(time - *m_lastTime);
+  double alpha = m_options.levelSmoothing;
+  double beta = m_options.trendSmoothing;
+
+  double previousLevel = m_level;
+  m_level = alpha * value + (1.0 - alpha) * (previousLevel + m_trend * elapsed);
+  m_trend = beta * (m_level - previousLevel) / elapsed + (1.0 - beta) * m_trend;
+  m_lastTime = time;
+}
+
+double
+TrendForecaster::forecast(ndn::time::nanoseconds horizon) const
+{
+  return m_level + m_trend * toSeconds(horizon);
+}
+
+} // namespace nlsr
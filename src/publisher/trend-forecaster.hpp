@@ -0,0 +1,83 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_PUBLISHER_TREND_FORECASTER_HPP
+#define NLSR_PUBLISHER_TREND_FORECASTER_HPP
+
+#include "common.hpp"
+
+#include <optional>
+
+namespace nlsr {
+
+/*! \brief Tracks the level and linear trend of a metric with Holt's double exponential smoothing.
+
+  Samples may arrive at irregular intervals, so the trend is kept per second and the level
+  is projected over the actual time between samples before the new sample is blended in.
+  A sample no newer than the previous one marks an idle interval: the level is kept, and the
+  trend decays toward 0 as if a flat slope had been blended in.
+ */
+class TrendForecaster
+{
+public:
+  struct Options
+  {
+    /// weight of a new sample in the level, 0.0 (exclusive) ~ 1.0
+    double levelSmoothing = 0.5;
+    /// weight of a new slope in the trend, 0.0 (exclusive) ~ 1.0
+    double trendSmoothing = 0.3;
+  };
+
+  explicit
+  TrendForecaster(const Options& options);
+
+  void
+  update(double value, ndn::time::system_clock::time_point time);
+
+  double
+  getLevel() const
+  {
+    return m_level;
+  }
+
+  /*! \brief Returns the trend, in units per second.
+   */
+  double
+  getTrend() const
+  {
+    return m_trend;
+  }
+
+  /*! \brief Returns the level projected \p horizon past the latest sample.
+   */
+  double
+  forecast(ndn::time::nanoseconds horizon) const;
+
+private:
+  Options m_options;
+  std::optional<ndn::time::system_clock::time_point> m_lastTime;
+  double m_level = 0.0;
+  double m_trend = 0.0;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_PUBLISHER_TREND_FORECASTER_HPP
@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "weight-learner.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace nlsr {
+
+namespace {
+
+/// initial covariance, large because nothing is known about the coefficients yet
+constexpr double INITIAL_COVARIANCE = 1000.0;
+/// bound on the covariance, which forgetting inflates while the inputs do not vary
+constexpr double MAX_COVARIANCE = 1e6;
+/// share of the latency at full inputs below which the inputs are considered to have no effect
+constexpr double MIN_EXPLAINED_SHARE = 0.01;
+
+} // anonymous namespace
+
+WeightLearner::WeightLearner(const Weights& initial, const Options& options)
+  : m_options(options)
+  , m_weights(initial)
+  , m_totalWeight(initial.processing + initial.load + initial.usage)
+{
+  m_options.forgetting = std::clamp(m_options.forgetting, 1e-3, 1.0);
+  m_options.maxWeight = std::max(m_options.minWeight, m_options.maxWeight);
+  for (size_t i = 0; i < N_FEATURES; ++i) {
+    m_covariance[i][i] = INITIAL_COVARIANCE;
+  }
+}
+
+void
+WeightLearner::update(const ServiceFunctionInfo& info, double latency)
+{
+  if (!std::isfinite(latency)) {
+    return;
+  }
+  const std::array<double, N_FEATURES> x{info.utilization, info.load, info.usageCount / 100.0, 1.0};
+
+  // gain = P x / (lambda + x' P x)
+  std::array<double, N_FEATURES> px{};
+  for (size_t i = 0; i < N_FEATURES; ++i) {
+    for (size_t j = 0; j < N_FEATURES; ++j) {
+      px[i] += m_covariance[i][j] * x[j];
+    }
+  }
+  double denominator = m_options.forgetting;
+  for (size_t i = 0; i < N_FEATURES; ++i) {
+    denominator += x[i] * px[i];
+  }
+
+  double error = latency;
+  for (size_t i = 0; i < N_FEATURES; ++i) {
+    error -= m_coefficients[i] * x[i];
+  }
+  for (size_t i = 0; i < N_FEATURES; ++i) {
+    m_coefficients[i] += px[i] / denominator * error;
+  }
+
+  // P = (P - P x x' P / (lambda + x' P x)) / lambda, as P is symmetric
+  double trace = 0.0;
+  for (size_t i = 0; i < N_FEATURES; ++i) {
+    for (size_t j = 0; j < N_FEATURES; ++j) {
+      m_covariance[i][j] -= px[i] * px[j] / denominator;
+    }
+    trace += m_covariance[i][i];
+  }
+  if (trace / m_options.forgetting < MAX_COVARIANCE) {
+    for (auto& row : m_covariance) {
+      for (auto& value : row) {
+        value /= m_options.forgetting;
+      }
+    }
+  }
+
+  if (++m_nSamples < m_options.minSamples) {
+    return;
+  }
+
+  std::array<double, 3> learned{std::max(m_coefficients[0], 0.0),
+                                std::max(m_coefficients[1], 0.0),
+                                std::max(m_coefficients[2], 0.0)};
+  double learnedSum = learned[0] + learned[1] + learned[2];
+  if (learnedSum <= MIN_EXPLAINED_SHARE * (learnedSum + std::abs(m_coefficients[3]))) {
+    // none of the inputs predicts the latency
+    return;
+  }
+
+  auto moveTowards = [this, learnedSum] (double& weight, double coefficient) {
+    double target = std::clamp(coefficient / learnedSum * m_totalWeight,
+                               m_options.minWeight, m_options.maxWeight);
+    weight += std::clamp(target - weight, -m_options.maxStep, m_options.maxStep);
+    weight = std::clamp(weight, m_options.minWeight, m_options.maxWeight);
+  };
+  moveTowards(m_weights.processing, learned[0]);
+  moveTowards(m_weights.load, learned[1]);
+  moveTowards(m_weights.usage, learned[2]);
+}
+
+} // namespace nlsr
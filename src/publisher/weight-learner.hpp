@@ -0,0 +1,102 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_PUBLISHER_WEIGHT_LEARNER_HPP
+#define NLSR_PUBLISHER_WEIGHT_LEARNER_HPP
+
+#include "lsa/name-lsa.hpp"
+
+#include <array>
+
+namespace nlsr {
+
+/*! \brief Learns the processing, load and usage weights of the linear function cost
+           from the latency the instance actually shows.
+
+  Each sample regresses the mean response time, in seconds, on the utilization, the load
+  and the usage (usageCount / 100, as in the linear cost), plus an intercept for the
+  latency none of them explains. The coefficients are estimated with recursive least
+  squares and exponential forgetting, so they follow a changing workload.
+
+  Only the relative size of the coefficients is used: negative ones count as 0, and the
+  rest are scaled to the sum of the initial weights, so the cost keeps the magnitude the
+  operator configured. The published weights stay at the initial ones until
+  Options::minSamples samples were seen, then move towards the learned ones by at most
+  Options::maxStep per sample, within [Options::minWeight, Options::maxWeight].
+ */
+class WeightLearner
+{
+public:
+  struct Weights
+  {
+    double processing = 0.0;
+    double load = 0.0;
+    double usage = 0.0;
+  };
+
+  struct Options
+  {
+    /// weight of the previous samples in each update, 0.0 (exclusive) ~ 1.0
+    double forgetting = 0.98;
+    double minWeight = 0.0;
+    double maxWeight = 1.0;
+    /// largest change of one weight per sample
+    double maxStep = 0.05;
+    /// samples needed before the weights change
+    size_t minSamples = 10;
+  };
+
+  WeightLearner(const Weights& initial, const Options& options);
+
+  /*! \brief Adds a sample.
+    \param info The inputs of the cost; utilization, load and usageCount are used
+    \param latency The mean response time over the same window, in seconds
+   */
+  void
+  update(const ServiceFunctionInfo& info, double latency);
+
+  const Weights&
+  getWeights() const
+  {
+    return m_weights;
+  }
+
+  size_t
+  getNSamples() const
+  {
+    return m_nSamples;
+  }
+
+private:
+  /// utilization, load, usage and the intercept
+  static constexpr size_t N_FEATURES = 4;
+
+  Options m_options;
+  Weights m_weights;
+  double m_totalWeight;
+  std::array<double, N_FEATURES> m_coefficients{};
+  std::array<std::array<double, N_FEATURES>, N_FEATURES> m_covariance{};
+  size_t m_nSamples = 0;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_PUBLISHER_WEIGHT_LEARNER_HPP
@@ -57,6 +57,19 @@ Fib::remove(const ndn::Name& name)
     }
     m_table.erase(it);
   }
+
+  if (m_trafficSplits.erase(name) > 0) {
+    ndn::nfd::ControlParameters parameters;
+    parameters.setName(name);
+    m_controller.start<ndn::nfd::StrategyChoiceUnsetCommand>(parameters,
+      [] (const ndn::nfd::ControlParameters& commandSuccessResult) {
+        NLSR_LOG_DEBUG("Unset strategy choice for name: " << commandSuccessResult.getName());
+      },
+      [name] (const ndn::nfd::ControlResponse& response) {
+        NLSR_LOG_DEBUG("Failed to unset strategy choice for name: " << name << ": " <<
+                       response.getText() << " (code " << response.getCode() << ")");
+      });
+  }
 }
 
 void
@@ -316,6 +329,29 @@ Fib::setStrategy(const ndn::Name& name, const ndn::Name& strategy, uint32_t coun
     std::bind(&Fib::onSetStrategyFailure, this, _1, parameters, count));
 }
 
+void
+Fib::setTrafficSplit(const ndn::Name& name, const std::map<ndn::FaceUri, uint32_t>& split)
+{
+  ndn::Name strategy(m_confParameter.getLoadBalancingStrategy());
+  for (const auto& [faceUri, weight] : split) {
+    uint64_t faceId = m_adjacencyList.getFaceId(faceUri);
+    if (faceId == 0) {
+      NLSR_LOG_DEBUG("No Face Id for face uri: " << faceUri << ", left out of the split for " << name);
+      continue;
+    }
+    strategy.append(std::to_string(faceId) + "~" + std::to_string(weight));
+  }
+
+  auto it = m_trafficSplits.find(name);
+  if (it != m_trafficSplits.end() && it->second == strategy) {
+    return;
+  }
+
+  NLSR_LOG_DEBUG("Setting traffic split for " << name << ": " << strategy);
+  m_trafficSplits[name] = strategy;
+  setStrategy(name, strategy, 0);
+}
+
 void
 Fib::onSetStrategySuccess(const ndn::nfd::ControlParameters& commandSuccessResult)
 {
@@ -127,6 +127,18 @@ public:
   void
   setStrategy(const ndn::Name& name, const ndn::Name& strategy, uint32_t count);
 
+  /*! \brief Spread the Interests under a name over its next hops by weight.
+   *
+   * Sets the configured load-balancing strategy on \p name, with one
+   * <tt>faceId~weight</tt> parameter component per face. The strategy is only set
+   * again when the weights change. Faces without a known Face ID are left out.
+   *
+   * \param name The name prefix
+   * \param split Weight of each next hop, by FaceUri
+   */
+  void
+  setTrafficSplit(const ndn::Name& name, const std::map<ndn::FaceUri, uint32_t>& split);
+
   void
   writeLog();
 
@@ -220,6 +232,8 @@ private:
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   std::map<ndn::Name, FibEntry> m_table;
+  /// strategy with parameters set by setTrafficSplit, per name
+  std::map<ndn::Name, ndn::Name> m_trafficSplits;
 
 private:
   AdjacencyList& m_adjacencyList;
@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "function-cost-model.hpp"
+
+#include <algorithm>
+
+namespace nlsr {
+
+double
+LinearFunctionCostModel::computeCost(const ServiceFunctionInfo& info) const
+{
+  return info.utilization * info.processingWeight +
+         info.load * info.loadWeight +
+         (info.usageCount / 100.0) * info.usageWeight +
+         (info.latencyP99 / 1e6) * info.latencyWeight;
+}
+
+QueueingFunctionCostModel::QueueingFunctionCostModel(double costPerSecond)
+  : m_costPerSecond(costPerSecond)
+{
+}
+
+double
+QueueingFunctionCostModel::computeCost(const ServiceFunctionInfo& info) const
+{
+  if (info.meanServiceTime == 0) {
+    return m_fallback.computeCost(info);
+  }
+  double sojournTime = computeSojournTime(std::max<uint32_t>(info.workerCapacity, 1),
+                                          info.utilization, info.meanServiceTime / 1e6);
+  return sojournTime * m_costPerSecond;
+}
+
+double
+QueueingFunctionCostModel::computeWaitProbability(uint32_t nWorkers, double utilization)
+{
+  double rho = std::clamp(utilization, 0.0, MAX_UTILIZATION);
+  if (rho == 0.0) {
+    return 0.0;
+  }
+
+  // Erlang B by recurrence, which stays stable for many workers, then converted to Erlang C
+  double offeredLoad = nWorkers * rho;
+  double erlangB = 1.0;
+  for (uint32_t k = 1; k <= nWorkers; ++k) {
+    erlangB = offeredLoad * erlangB / (k + offeredLoad * erlangB);
+  }
+  return erlangB / (1.0 - rho * (1.0 - erlangB));
+}
+
+double
+QueueingFunctionCostModel::computeSojournTime(uint32_t nWorkers, double utilization,
+                                              double meanServiceTime)
+{
+  nWorkers = std::max<uint32_t>(nWorkers, 1);
+  double rho = std::clamp(utilization, 0.0, MAX_UTILIZATION);
+  double waitingTime = computeWaitProbability(nWorkers, rho) * meanServiceTime /
+                       (nWorkers * (1.0 - rho));
+  return meanServiceTime + waitingTime;
+}
+
+ServiceFunctionInfo
+extrapolateServiceFunctionInfo(const ServiceFunctionInfo& info, ndn::time::system_clock::time_point now,
+                               ndn::time::nanoseconds maxHorizon)
+{
+  ServiceFunctionInfo extrapolated = info;
+  if (info.utilizationTrend == 0.0 || now <= info.lastUpdateTime) {
+    return extrapolated;
+  }
+
+  auto horizon = std::min<ndn::time::nanoseconds>(now - info.lastUpdateTime, maxHorizon);
+  double utilization = info.utilization + info.utilizationTrend * (horizon.count() / 1e9);
+  extrapolated.utilization = std::clamp(utilization, 0.0, std::max(1.0, info.utilization));
+  return extrapolated;
+}
+
+std::unique_ptr<FunctionCostModel>
+makeFunctionCostModel(FunctionCostModelType type, const ConfParameter& confParam)
+{
+  switch (type) {
+    case FunctionCostModelType::QUEUEING:
+      return std::make_unique<QueueingFunctionCostModel>(confParam.getQueueingCostPerSecond());
+    case FunctionCostModelType::LINEAR:
+    default:
+      return std::make_unique<LinearFunctionCostModel>();
+  }
+}
+
+} // namespace nlsr
@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_ROUTE_FUNCTION_COST_MODEL_HPP
+#define NLSR_ROUTE_FUNCTION_COST_MODEL_HPP
+
+#include "conf-parameter.hpp"
+#include "lsa/name-lsa.hpp"
+
+#include <memory>
+
+namespace nlsr {
+
+/*! \brief Computes the cost of sending requests to a Service Function instance.
+
+  The cost is added to the route cost of every next hop towards the router hosting the
+  instance, so it must be in the same unit as the link costs.
+ */
+class FunctionCostModel
+{
+public:
+  virtual
+  ~FunctionCostModel() = default;
+
+  /*! \brief Computes the cost of an instance from the info in its Name LSA.
+   */
+  virtual double
+  computeCost(const ServiceFunctionInfo& info) const = 0;
+};
+
+/*! \brief Weighted sum of the advertised metrics, with the weights of the hosting router.
+ */
+class LinearFunctionCostModel : public FunctionCostModel
+{
+public:
+  double
+  computeCost(const ServiceFunctionInfo& info) const override;
+};
+
+/*! \brief Expected sojourn time of a request at the instance, modeled as an M/M/c queue.
+
+  With c workers of utilization rho and mean service time S, the expected sojourn time is
+  <tt>S + C(c, c*rho) * S / (c * (1 - rho))</tt>, where C is the Erlang C probability that
+  a request has to wait. Unlike the linear model, the cost grows without bound as the
+  instance approaches saturation. Utilization is capped at MAX_UTILIZATION so a saturated
+  instance keeps a finite, very high cost.
+
+  Instances that do not advertise their mean service time are costed with the linear model.
+ */
+class QueueingFunctionCostModel : public FunctionCostModel
+{
+public:
+  /*! \param costPerSecond cost added per second of expected sojourn time
+   */
+  explicit
+  QueueingFunctionCostModel(double costPerSecond);
+
+  double
+  computeCost(const ServiceFunctionInfo& info) const override;
+
+  /*! \brief Computes the Erlang C probability that a request waits for a worker.
+    \param nWorkers number of workers c, at least 1
+    \param utilization per-worker utilization rho, below 1.0
+   */
+  static double
+  computeWaitProbability(uint32_t nWorkers, double utilization);
+
+  /*! \brief Computes the expected sojourn time, in the unit of \p meanServiceTime.
+   */
+  static double
+  computeSojournTime(uint32_t nWorkers, double utilization, double meanServiceTime);
+
+public:
+  static constexpr double MAX_UTILIZATION = 0.99;
+
+private:
+  double m_costPerSecond;
+  LinearFunctionCostModel m_fallback;
+};
+
+/*! \brief Returns \p info with the utilization extrapolated to \p now along its advertised trend.
+
+  The advertised utilization was measured at lastUpdateTime, a window, a flooding and a fetch
+  earlier. The extrapolation covers at most \p maxHorizon, and the result does not fall below
+  0.0 nor rise above 1.0, or the advertised utilization if it is higher.
+ */
+ServiceFunctionInfo
+extrapolateServiceFunctionInfo(const ServiceFunctionInfo& info, ndn::time::system_clock::time_point now,
+                               ndn::time::nanoseconds maxHorizon);
+
+/*! \brief Creates the cost model of type \p type with the parameters in \p confParam.
+ */
+std::unique_ptr<FunctionCostModel>
+makeFunctionCostModel(FunctionCostModelType type, const ConfParameter& confParam);
+
+} // namespace nlsr
+
+#endif // NLSR_ROUTE_FUNCTION_COST_MODEL_HPP
@@ -29,37 +29,64 @@ namespace nlsr {
 void
 NameMap::addEntry(const ndn::Name& rtrName)
 {
-  int32_t mappingNo = static_cast<int32_t>(m_bimap.size());
-  m_bimap.by<ndn::Name>().insert({rtrName, mappingNo});
+  addEntry(RouterNameInterner::getGlobal().intern(rtrName));
+}
+
+void
+NameMap::addEntry(RouterId routerId)
+{
+  auto mappingNo = static_cast<int32_t>(m_routerIds.size());
+  if (m_mappingNos.try_emplace(routerId, mappingNo).second) {
+    m_routerIds.push_back(routerId);
+  }
 }
 
 std::optional<ndn::Name>
 NameMap::getRouterNameByMappingNo(int32_t mn) const
 {
-  auto it = m_bimap.by<MappingNo>().find(mn);
-  if (it == m_bimap.by<MappingNo>().end()) {
+  auto routerId = getRouterIdByMappingNo(mn);
+  if (!routerId) {
     return std::nullopt;
   }
-  return it->get<ndn::Name>();
+  return RouterNameInterner::getGlobal().getName(*routerId);
 }
 
 std::optional<int32_t>
 NameMap::getMappingNoByRouterName(const ndn::Name& rtrName) const
 {
-  auto it = m_bimap.by<ndn::Name>().find(rtrName);
-  if (it == m_bimap.by<ndn::Name>().end()) {
+  auto routerId = RouterNameInterner::getGlobal().find(rtrName);
+  if (!routerId) {
+    return std::nullopt;
+  }
+  return getMappingNoByRouterId(*routerId);
+}
+
+std::optional<RouterId>
+NameMap::getRouterIdByMappingNo(int32_t mn) const
+{
+  if (mn < 0 || static_cast<size_t>(mn) >= m_routerIds.size()) {
+    return std::nullopt;
+  }
+  return m_routerIds[mn];
+}
+
+std::optional<int32_t>
+NameMap::getMappingNoByRouterId(RouterId routerId) const
+{
+  auto it = m_mappingNos.find(routerId);
+  if (it == m_mappingNos.end()) {
     return std::nullopt;
   }
-  return it->get<MappingNo>();
+  return it->second;
 }
 
 std::ostream&
 operator<<(std::ostream& os, const NameMap& map)
 {
   os << "---------------NameMap---------------";
-  for (const auto& entry : map.m_bimap) {
-    os << "\nMapEntry: ( Router: " << entry.get<ndn::Name>()
-       << " Mapping No: " << entry.get<NameMap::MappingNo>() << " )";
+  for (size_t mappingNo = 0; mappingNo < map.m_routerIds.size(); ++mappingNo) {
+    os << "\nMapEntry: ( Router: " << RouterNameInterner::getGlobal().getName(map.m_routerIds[mappingNo])
+       << " Mapping No: " << mappingNo << " )";
   }
   return os;
 }
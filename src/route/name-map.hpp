@@ -22,13 +22,14 @@
 #define NLSR_NAME_MAP_HPP
 
 #include "common.hpp"
+#include "router-name-interner.hpp"
 #include "lsa/adj-lsa.hpp"
 
-#include <boost/bimap.hpp>
-#include <boost/bimap/unordered_set_of.hpp>
 #include <boost/concept_check.hpp>
 
 #include <optional>
+#include <unordered_map>
+#include <vector>
 
 namespace nlsr {
 
@@ -41,6 +42,9 @@ namespace nlsr {
  * These numbers are non-negative integers assigned sequentially, starting from zero. They can
  * support constructing a matrix of routers, where the mapping numbers are used as row and column
  * indices in place of router names.
+ *
+ * Router names are held as their RouterNameInterner ids, so building a NameMap for every
+ * routing calculation hashes integers rather than names.
  */
 class NameMap
 {
@@ -62,7 +66,7 @@ public:
     for (auto it = first; it != last; ++it) {
       // *it has type std::shared_ptr<Lsa> ; it->get() has type Lsa*
       auto lsa = static_cast<const AdjLsa*>(it->get());
-      map.addEntry(lsa->getOriginRouter());
+      map.addEntry(lsa->getOriginRouterId());
       for (const auto& adjacent : lsa->getAdl().getAdjList()) {
         map.addEntry(adjacent.getName());
       }
@@ -84,7 +88,7 @@ public:
     BOOST_CONCEPT_ASSERT((boost::InputIterator<IteratorType>));
     NameMap map;
     for (auto it = first; it != last; ++it) {
-      map.addEntry((*it)->getOriginRouter());
+      map.addEntry((*it)->getOriginRouterId());
     }
     return map;
   }
@@ -96,6 +100,13 @@ public:
   void
   addEntry(const ndn::Name& rtrName);
 
+  /**
+   * @brief Insert a router by its interned id.
+   * @param routerId Id of the router name in the global RouterNameInterner.
+   */
+  void
+  addEntry(RouterId routerId);
+
   /**
    * @brief Find router name by its mapping number.
    * @param mn Mapping number.
@@ -112,6 +123,22 @@ public:
   std::optional<int32_t>
   getMappingNoByRouterName(const ndn::Name& rtrName) const;
 
+  /**
+   * @brief Find interned router id by mapping number.
+   * @param mn Mapping number.
+   * @returns Router id, or @c std::nullopt if it does not exist.
+   */
+  std::optional<RouterId>
+  getRouterIdByMappingNo(int32_t mn) const;
+
+  /**
+   * @brief Find mapping number of an interned router id.
+   * @param routerId Router id.
+   * @returns Mapping number, or @c std::nullopt if it does not exist.
+   */
+  std::optional<int32_t>
+  getMappingNoByRouterId(RouterId routerId) const;
+
   /**
    * @brief Return number of entries in this container.
    * @returns Number of entries in this container.
@@ -119,20 +146,14 @@ public:
   size_t
   size() const
   {
-    return m_bimap.size();
+    return m_routerIds.size();
   }
 
 private:
-  struct MappingNo;
-  boost::bimap<
-    boost::bimaps::unordered_set_of<
-      boost::bimaps::tagged<ndn::Name, ndn::Name>,
-      std::hash<ndn::Name>
-    >,
-    boost::bimaps::unordered_set_of<
-      boost::bimaps::tagged<int32_t, MappingNo>
-    >
-  > m_bimap;
+  // mapping number => router id
+  std::vector<RouterId> m_routerIds;
+  // router id => mapping number
+  std::unordered_map<RouterId, int32_t> m_mappingNos;
 
   friend std::ostream&
   operator<<(std::ostream& os, const NameMap& map);
@@ -26,11 +26,15 @@
 #include "routing-table.hpp"
 #include "lsa/name-lsa.hpp"
 #include "conf-parameter.hpp"
+#include "route/routing-calculator.hpp"
 
 #include <algorithm>
+#include <limits>
 #include <list>
 #include <utility>
 #include <map>
+#include <set>
+#include <vector>
 
 namespace nlsr {
 
@@ -40,12 +44,14 @@ NamePrefixTable::NamePrefixTable(const ndn::Name& ownRouterName, Fib& fib,
                                  RoutingTable& routingTable,
                                  AfterRoutingChange& afterRoutingChangeSignal,
                                  Lsdb::AfterLsdbModified& afterLsdbModifiedSignal,
-                                 Lsdb& lsdb, ConfParameter& confParam)
+                                 Lsdb& lsdb, ConfParameter& confParam,
+                                 ndn::Scheduler& scheduler)
   : m_ownRouterName(ownRouterName)
   , m_fib(fib)
   , m_routingTable(routingTable)
   , m_lsdb(lsdb)
   , m_confParam(confParam)
+  , m_scheduler(scheduler)
 {
   m_afterRoutingChangeConnection = afterRoutingChangeSignal.connect(
     [this] (const std::list<RoutingTableEntry>& entries) {
@@ -71,8 +77,17 @@ NamePrefixTable::updateFromLsdb(std::shared_ptr<Lsa> lsa, LsdbUpdate updateType,
                                 const std::list<nlsr::PrefixInfo>& namesToAdd,
                                 const std::list<nlsr::PrefixInfo>& namesToRemove)
 {
+  if (lsa->getType() == Lsa::Type::ADJACENCY) {
+    // the distances between chain instances are recomputed after the routing calculation
+    m_areChainDistancesStale = true;
+  }
+
   if (m_ownRouterName == lsa->getOriginRouter()) {
     NLSR_LOG_DEBUG("updateFromLsdb: Skipping own router's LSA");
+    // own instances are chain candidates too
+    if (isChainInput(*lsa)) {
+      updateChainSelections();
+    }
     return;
   }
   NLSR_LOG_DEBUG("updateFromLsdb called: router=" << lsa->getOriginRouter() 
@@ -87,11 +102,11 @@ NamePrefixTable::updateFromLsdb(std::shared_ptr<Lsa> lsa, LsdbUpdate updateType,
     addEntry(lsa->getOriginRouter(), lsa->getOriginRouter());
 
     if (lsa->getType() == Lsa::Type::NAME) {
-      auto nlsa = std::static_pointer_cast<NameLsa>(lsa);
+      auto nlsa = std::static_pointer_cast<const NameLsa>(lsa);
       NLSR_LOG_DEBUG("updateFromLsdb: Processing NAME LSA with " << nlsa->getNpl().getPrefixInfo().size() << " prefixes");
       for (const auto &prefix : nlsa->getNpl().getPrefixInfo()) {
         if (prefix.getName() != m_ownRouterName) {
-          m_nexthopCost[DestNameKey(lsa->getOriginRouter(), prefix.getName())] = prefix.getCost();
+          m_nexthopCost[DestNameKey(lsa->getOriginRouterId(), prefix.getName())] = prefix.getCost();
           addEntry(prefix.getName(), lsa->getOriginRouter());
         }
       }
@@ -153,14 +168,14 @@ NamePrefixTable::updateFromLsdb(std::shared_ptr<Lsa> lsa, LsdbUpdate updateType,
 
     for (const auto &prefix : namesToAdd) {
       if (prefix.getName() != m_ownRouterName) {
-        m_nexthopCost[DestNameKey(lsa->getOriginRouter(), prefix.getName())] = prefix.getCost();
+        m_nexthopCost[DestNameKey(lsa->getOriginRouterId(), prefix.getName())] = prefix.getCost();
         addEntry(prefix.getName(), lsa->getOriginRouter());
       }
     }
 
     for (const auto &prefix : namesToRemove) {
       if (prefix.getName() != m_ownRouterName) {
-        m_nexthopCost.erase(m_nexthopCost.find(DestNameKey(lsa->getOriginRouter(), prefix.getName())));
+        m_nexthopCost.erase(m_nexthopCost.find(DestNameKey(lsa->getOriginRouterId(), prefix.getName())));
         removeEntry(prefix.getName(), lsa->getOriginRouter());
       }
     }
@@ -168,15 +183,40 @@ NamePrefixTable::updateFromLsdb(std::shared_ptr<Lsa> lsa, LsdbUpdate updateType,
   else {
     removeEntry(lsa->getOriginRouter(), lsa->getOriginRouter());
     if (lsa->getType() == Lsa::Type::NAME) {
-      auto nlsa = std::static_pointer_cast<NameLsa>(lsa);
+      auto nlsa = std::static_pointer_cast<const NameLsa>(lsa);
       for (const auto& name : nlsa->getNpl().getNames()) {
         if (name != m_ownRouterName) {
-          m_nexthopCost.erase(m_nexthopCost.find(DestNameKey(lsa->getOriginRouter(), name)));
+          m_nexthopCost.erase(m_nexthopCost.find(DestNameKey(lsa->getOriginRouterId(), name)));
           removeEntry(name, lsa->getOriginRouter());
         }
       }
     }
   }
+  if (isChainInput(*lsa)) {
+    updateChainSelections();
+  }
+}
+
+bool
+NamePrefixTable::isChainInput(const Lsa& lsa) const
+{
+  const auto& chains = m_confParam.getServiceFunctionChains();
+  if (chains.empty() || lsa.getType() != Lsa::Type::NAME) {
+    return false;
+  }
+  // an instance may have stopped advertising its stage
+  if (m_chainInstances.count(lsa.getOriginRouter()) > 0) {
+    return true;
+  }
+  auto names = static_cast<const NameLsa&>(lsa).getNpl().getNames();
+  for (const auto& [chainName, stages] : chains) {
+    for (const auto& stage : stages) {
+      if (std::find(names.begin(), names.end(), stage) != names.end()) {
+        return true;
+      }
+    }
+  }
+  return false;
 }
 
 NexthopList
@@ -188,7 +228,7 @@ NamePrefixTable::adjustNexthopCosts(const NexthopList& nhlist, const ndn::Name&
   
   for (const auto& rtpe : npte.getRteList()) {
     const ndn::Name& destRouterName = rtpe->getDestination();
-    auto nameLsa = m_lsdb.findLsa<NameLsa>(destRouterName);
+    std::shared_ptr<const NameLsa> nameLsa = m_lsdb.findLsa<NameLsa>(destRouterName);
     if (nameLsa) {
       const auto& prefixInfoList = nameLsa->getNpl().getPrefixInfo();
       for (const auto& prefixInfo : prefixInfoList) {
@@ -207,6 +247,9 @@ NamePrefixTable::adjustNexthopCosts(const NexthopList& nhlist, const ndn::Name&
   
   if (!isServiceFunction) {
     NLSR_LOG_DEBUG("adjustNexthopCosts: " << nameToCheck << " is not a service function, returning original NextHopList");
+    if (m_siteSelections.erase(nameToCheck) > 0) {
+      ++m_siteSelectionVersion;
+    }
     return nhlist;
   }
   
@@ -216,99 +259,85 @@ NamePrefixTable::adjustNexthopCosts(const NexthopList& nhlist, const ndn::Name&
   // FaceUriとdestRouterNameのペアをキーとして使用
   // (FaceUri, destRouterName) -> (NextHop, functionCost)
   std::map<std::pair<ndn::FaceUri, ndn::Name>, std::pair<NextHop, double>> nextHopMap;
+  // spare capacity of the instances behind each face, for the traffic split
+  std::map<ndn::FaceUri, double> headroomPerFace;
+  // next hops towards any instance, for the prober
+  std::set<ndn::FaceUri> probeTargets;
   
+  // Instances that advertise an overload are left out, unless all of them do
+  std::set<ndn::Name> shedRouters;
+  for (const auto& rtpe : npte.getRteList()) {
+    auto sfInfo = getFreshServiceFunctionInfo(nameToCheck, rtpe->getDestination());
+    if (isShedForOverload(nameToCheck, *rtpe, sfInfo)) {
+      shedRouters.insert(rtpe->getDestination());
+    }
+  }
+  if (shedRouters.size() == npte.getRteList().size()) {
+    NLSR_LOG_DEBUG("All instances of " << nameToCheck << " are overloaded, keeping them");
+    shedRouters.clear();
+  }
+
+  // Instances of other sites are a fallback while the local site has headroom
+  std::set<ndn::Name> remoteRouters;
+  if (m_confParam.isSitePreferenceEnabled()) {
+    remoteRouters = selectSiteOf(nameToCheck, npte, shedRouters);
+  }
+
   // 各RoutingTablePoolEntryに対して個別にFunctionCostを計算
   // これにより、各NextHopがどのdestRouterNameに対応するかを正確に判断できる
   for (const auto& rtpe : npte.getRteList()) {
     const ndn::Name& destRouterName = rtpe->getDestination();
     NLSR_LOG_DEBUG("Processing RoutingTablePoolEntry for destRouterName=" << destRouterName);
+    if (shedRouters.count(destRouterName) > 0) {
+      NLSR_LOG_DEBUG("Skipping next hops towards overloaded " << destRouterName);
+      continue;
+    }
     
     // destRouterNameのNameLSAからFunctionCostを計算
     double functionCost = 0.0;
-    auto nameLsa = m_lsdb.findLsa<NameLsa>(destRouterName);
-    if (nameLsa) {
-      NLSR_LOG_DEBUG("NameLSA found for " << destRouterName);
-      NLSR_LOG_DEBUG("NameLSA from LSDB has m_serviceFunctionInfo size: " 
-                    << nameLsa->getServiceFunctionInfoMapSize());
-      
-      // Log all Service Function info in the NameLSA for debugging
-      const auto& allSfInfo = nameLsa->getAllServiceFunctionInfo();
-      for (const auto& [sfName, sfInfo] : allSfInfo) {
-        NLSR_LOG_DEBUG("NameLSA contains Service Function: " << sfName.toUri()
-                      << " -> utilization=" << sfInfo.utilization
-                      << ", processingWeight=" << sfInfo.processingWeight);
-      }
-      
-      ServiceFunctionInfo sfInfo = nameLsa->getServiceFunctionInfo(nameToCheck);
-      
-      NLSR_LOG_DEBUG("ServiceFunctionInfo for " << nameToCheck << " (destRouterName=" << destRouterName 
-                    << "): utilization=" << sfInfo.utilization
-                    << ", load=" << sfInfo.load << ", usageCount=" << sfInfo.usageCount
-                    << ", processingWeight=" << sfInfo.processingWeight
-                    << ", loadWeight=" << sfInfo.loadWeight
-                    << ", usageWeight=" << sfInfo.usageWeight);
-      
-      // Check if Service Function info is stale (lastUpdateTime is too old)
-      // If stale, set functionCost to 0
-      bool isStale = false;
-      if (sfInfo.lastUpdateTime != ndn::time::system_clock::time_point::min()) {
-        auto now = ndn::time::system_clock::now();
-        auto timeSinceLastUpdate = boost::chrono::duration_cast<boost::chrono::seconds>(now - sfInfo.lastUpdateTime).count();
-        uint32_t staleThreshold = m_confParam.getUtilizationWindowSeconds() * 3;  // 3x window duration (180 seconds if window is 60s)
-        
-        if (timeSinceLastUpdate > static_cast<int64_t>(staleThreshold)) {
-          isStale = true;
-          NLSR_LOG_DEBUG("Service Function info is stale (lastUpdateTime: " 
-                        << boost::chrono::duration_cast<boost::chrono::seconds>(sfInfo.lastUpdateTime.time_since_epoch()).count()
-                        << ", timeSinceLastUpdate: " << timeSinceLastUpdate << "s, threshold: " << staleThreshold << "s)");
-        }
-      }
-      
-      // Calculate function cost if Service Function info is available and not stale
-      // NameLSAにService Function情報が存在する場合、そのプレフィックスはサービスファンクションと判断
-      // weight情報は、サービスファンクションを持つノード（destRouterName）の設定ファイルから取得
-      // NameLSAに含まれるweight情報を使用する
-      if (!isStale && (sfInfo.utilization > 0.0 || sfInfo.load > 0.0 || sfInfo.usageCount > 0)) {
-        NLSR_LOG_DEBUG("Service Function info found in NameLSA for " << nameToCheck 
-                      << " (destRouterName=" << destRouterName << "), calculating FunctionCost");
-        
-        // NameLSAから取得したweight情報を使用（サービスファンクションを持つノードの設定ファイルの値）
-        double processingWeight = sfInfo.processingWeight;
-        double loadWeight = sfInfo.loadWeight;
-        double usageWeight = sfInfo.usageWeight;
-        
-        NLSR_LOG_DEBUG("Weights from NameLSA (node " << destRouterName << "): processing=" << processingWeight 
-                      << ", load=" << loadWeight << ", usage=" << usageWeight);
-        
-        functionCost = sfInfo.utilization * processingWeight +
-                      sfInfo.load * loadWeight +
-                      (sfInfo.usageCount / 100.0) * usageWeight;
-        
-        NLSR_LOG_DEBUG("FunctionCost calculated for " << nameToCheck << " prefix to " << destRouterName 
-                      << ": utilization=" << sfInfo.utilization 
-                      << ", functionCost=" << functionCost);
-      } else if (isStale) {
-        NLSR_LOG_DEBUG("Service Function info is stale for " << nameToCheck 
-                      << " (destRouterName=" << destRouterName << "), functionCost=0");
-        functionCost = 0.0;
-      } else {
-        NLSR_LOG_DEBUG("No Service Function info in NameLSA for " << nameToCheck 
-                      << " (destRouterName=" << destRouterName << ", all values are zero)");
-      }
-    } else {
-      NLSR_LOG_DEBUG("NameLSA not found for " << destRouterName);
+    // an instance without (fresh) Service Function info is taken as idle
+    double headroom = computeHeadroom(ServiceFunctionInfo{});
+    auto sfInfo = getFreshServiceFunctionInfo(nameToCheck, destRouterName);
+    if (sfInfo) {
+      // NameLSAに含まれるweight情報を使用する（サービスファンクションを持つノードの設定ファイルの値）
+      NLSR_LOG_DEBUG("Weights from NameLSA (node " << destRouterName << "): processing=" << sfInfo->processingWeight
+                    << ", load=" << sfInfo->loadWeight << ", usage=" << sfInfo->usageWeight);
+
+      functionCost = getFunctionCostModel(nameToCheck).computeCost(*sfInfo);
+      headroom = computeHeadroom(*sfInfo);
+
+      NLSR_LOG_DEBUG("FunctionCost calculated for " << nameToCheck << " prefix to " << destRouterName
+                    << ": utilization=" << sfInfo->utilization
+                    << ", workers=" << sfInfo->workerCapacity
+                    << ", meanServiceTime=" << sfInfo->meanServiceTime << " us"
+                    << ", functionCost=" << functionCost);
+    }
+
+    // Keep the chains this prefix is a stage of on their selected instances
+    double chainDetourCost = getChainDetourCost(nameToCheck, destRouterName);
+
+    // Requests for this instance leave through its lowest-cost next hop
+    if (!rtpe->getNexthopList().getNextHops().empty() && remoteRouters.count(destRouterName) == 0) {
+      headroomPerFace[rtpe->getNexthopList().cbegin()->getConnectingFaceUri()] += headroom;
     }
     
     // このRoutingTablePoolEntryのNextHopに対してFunctionCostを適用
     for (const auto& nh : rtpe->getNexthopList().getNextHops()) {
       double originalCost = nh.getRouteCost();
-      double nexthopCost = m_nexthopCost[DestNameKey(destRouterName, nameToCheck)];
-      double adjustedCost = originalCost + nexthopCost + functionCost;
+      double nexthopCost = m_nexthopCost[DestNameKey(rtpe->getDestinationId(), nameToCheck)];
+      double probeCost = 0.0;
+      if (m_prober != nullptr) {
+        probeTargets.insert(nh.getConnectingFaceUri());
+        probeCost = computeProbeCost(nameToCheck, nh.getConnectingFaceUri());
+      }
+      double adjustedCost = originalCost + nexthopCost + functionCost + probeCost + chainDetourCost;
       
       NLSR_LOG_DEBUG("Adjusting cost for " << nameToCheck << " to " << destRouterName
                     << ": originalCost=" << originalCost 
                     << ", nexthopCost=" << nexthopCost
                     << ", functionCost=" << functionCost
+                    << ", probeCost=" << probeCost
+                    << ", chainDetourCost=" << chainDetourCost
                     << ", adjustedCost=" << adjustedCost);
       
       const NextHop newNextHop = NextHop(nh.getConnectingFaceUri(), adjustedCost);
@@ -342,6 +371,30 @@ NamePrefixTable::adjustNexthopCosts(const NexthopList& nhlist, const ndn::Name&
     }
   }
   
+  // Rank the next hops towards other sites after the local ones, keeping their order
+  if (!remoteRouters.empty()) {
+    double maxLocalCost = 0.0;
+    double minRemoteCost = std::numeric_limits<double>::max();
+    for (const auto& [key, pair] : nextHopMap) {
+      double cost = pair.first.getRouteCost();
+      if (remoteRouters.count(key.second) > 0) {
+        minRemoteCost = std::min(minRemoteCost, cost);
+      }
+      else {
+        maxLocalCost = std::max(maxLocalCost, cost);
+      }
+    }
+    if (minRemoteCost <= maxLocalCost) {
+      double offset = maxLocalCost - minRemoteCost + 1.0;
+      for (auto& [key, pair] : nextHopMap) {
+        if (remoteRouters.count(key.second) > 0) {
+          pair.first.setRouteCost(pair.first.getRouteCost() + offset);
+        }
+      }
+      NLSR_LOG_DEBUG("Next hops of " << nameToCheck << " towards other sites raised by " << offset);
+    }
+  }
+
   // マップからNexthopListを構築
   // 同じFaceUriでも異なるdestRouterNameのNextHopは両方とも保持される
   NexthopList new_nhList;
@@ -354,11 +407,302 @@ NamePrefixTable::adjustNexthopCosts(const NexthopList& nhlist, const ndn::Name&
                   << ", functionCost=" << pair.second);
   }
   
+  if (m_prober != nullptr) {
+    m_prober->setTargets(nameToCheck, probeTargets);
+  }
+
+  if (m_confParam.isLoadBalancingEnabled()) {
+    m_fib.setTrafficSplit(nameToCheck, computeTrafficSplit(headroomPerFace));
+  }
+
   NLSR_LOG_DEBUG("adjustNexthopCosts returning NexthopList with " << new_nhList.size() << " entries");
   
   return new_nhList;
 }
 
+double
+NamePrefixTable::computeProbeCost(const ndn::Name& functionPrefix, const ndn::FaceUri& faceUri) const
+{
+  const auto* measurement = m_prober->getMeasurement(functionPrefix, faceUri);
+  if (measurement == nullptr) {
+    return 0.0;
+  }
+
+  double cost = (1.0 - measurement->successRate) * m_confParam.getProbeFailureCost();
+  if (measurement->srtt) {
+    cost += measurement->srtt->count() / 1e9 * m_confParam.getProbeCostPerSecond();
+  }
+  return cost;
+}
+
+std::optional<ServiceFunctionInfo>
+NamePrefixTable::getFreshServiceFunctionInfo(const ndn::Name& functionPrefix,
+                                             const ndn::Name& destRouter) const
+{
+  auto nameLsa = m_lsdb.findLsa<NameLsa>(destRouter);
+  if (!nameLsa) {
+    NLSR_LOG_DEBUG("NameLSA not found for " << destRouter);
+    return std::nullopt;
+  }
+
+  ServiceFunctionInfo sfInfo = nameLsa->getServiceFunctionInfo(functionPrefix);
+  NLSR_LOG_DEBUG("ServiceFunctionInfo for " << functionPrefix << " (destRouterName=" << destRouter
+                << "): utilization=" << sfInfo.utilization
+                << ", load=" << sfInfo.load << ", usageCount=" << sfInfo.usageCount);
+
+  // Check if Service Function info is stale (lastUpdateTime is too old)
+  if (sfInfo.lastUpdateTime != ndn::time::system_clock::time_point::min()) {
+    auto now = ndn::time::system_clock::now();
+    auto timeSinceLastUpdate = boost::chrono::duration_cast<boost::chrono::seconds>(now - sfInfo.lastUpdateTime).count();
+    uint32_t staleThreshold = m_confParam.getUtilizationWindowSeconds() * 3;  // 3x window duration (180 seconds if window is 60s)
+    // Unchanged info is only re-advertised every advertise-max-interval
+    staleThreshold = std::max<uint32_t>(staleThreshold, m_confParam.getAdvertisementMaxInterval().count() * 2);
+
+    if (timeSinceLastUpdate > static_cast<int64_t>(staleThreshold)) {
+      NLSR_LOG_DEBUG("Service Function info is stale (timeSinceLastUpdate: " << timeSinceLastUpdate
+                    << "s, threshold: " << staleThreshold << "s), functionCost=0");
+      return std::nullopt;
+    }
+  }
+
+  // Make up for the time the info took to get here
+  sfInfo = extrapolateServiceFunctionInfo(sfInfo, ndn::time::system_clock::now(),
+                                          m_confParam.getForecastHorizon());
+
+  if (sfInfo.utilization <= 0.0 && sfInfo.load <= 0.0 && sfInfo.usageCount == 0 &&
+      sfInfo.latencyP99 == 0) {
+    NLSR_LOG_DEBUG("No Service Function info in NameLSA for " << functionPrefix
+                  << " (destRouterName=" << destRouter << ", all values are zero)");
+    return std::nullopt;
+  }
+  return sfInfo;
+}
+
+bool
+NamePrefixTable::isShedForOverload(const ndn::Name& functionPrefix, const RoutingTablePoolEntry& rtpe,
+                                   const std::optional<ServiceFunctionInfo>& sfInfo)
+{
+  DestNameKey key(rtpe.getDestinationId(), functionPrefix);
+  auto it = m_overloadedInstances.find(key);
+
+  if (sfInfo && sfInfo->isOverloaded) {
+    if (it == m_overloadedInstances.end()) {
+      NLSR_LOG_INFO(rtpe.getDestination() << " is overloaded for " << functionPrefix
+                    << " (max concurrency " << sfInfo->maxConcurrency << "), removing its next hops");
+      m_overloadedInstances.try_emplace(key);
+    }
+    else if (it->second.isRestoring) {
+      // overloaded again before its next hops were restored
+      it->second.restoreEvent.cancel();
+      it->second.isRestoring = false;
+    }
+    return true;
+  }
+
+  if (it == m_overloadedInstances.end()) {
+    return false;
+  }
+  if (!it->second.isRestoring) {
+    NLSR_LOG_INFO(rtpe.getDestination() << " is no longer overloaded for " << functionPrefix
+                  << ", restoring its next hops in " << m_confParam.getOverloadHoldTime());
+    it->second.isRestoring = true;
+    it->second.restoreEvent = m_scheduler.schedule(m_confParam.getOverloadHoldTime(),
+                                                   [this, key, functionPrefix] {
+      m_overloadedInstances.erase(key);
+      updateFibEntry(functionPrefix);
+    });
+  }
+  return true;
+}
+
+bool
+NamePrefixTable::isInLocalSite(const ndn::Name& router) const
+{
+  ndn::Name site = m_confParam.getNetwork();
+  site.append(m_confParam.getSiteName());
+  return site.isPrefixOf(router);
+}
+
+std::set<ndn::Name>
+NamePrefixTable::selectSiteOf(const ndn::Name& functionPrefix, const NamePrefixTableEntry& npte,
+                              const std::set<ndn::Name>& shedRouters)
+{
+  std::vector<std::pair<bool, ServiceFunctionInfo>> instances;
+  std::set<ndn::Name> remoteRouters;
+  for (const auto& rtpe : npte.getRteList()) {
+    const ndn::Name& destRouterName = rtpe->getDestination();
+    if (shedRouters.count(destRouterName) > 0) {
+      continue;
+    }
+    bool isLocal = isInLocalSite(destRouterName);
+    if (!isLocal) {
+      remoteRouters.insert(destRouterName);
+    }
+    // an instance without (fresh) Service Function info is taken as idle
+    auto sfInfo = getFreshServiceFunctionInfo(functionPrefix, destRouterName);
+    instances.emplace_back(isLocal, sfInfo.value_or(ServiceFunctionInfo{}));
+  }
+
+  auto selection = selectSite(instances, m_confParam.getSiteHeadroomThreshold());
+  auto& current = m_siteSelections[functionPrefix];
+  if (selection.isLocalPreferred != current.isLocalPreferred) {
+    NLSR_LOG_INFO((selection.isLocalPreferred ? "Serving " : "Ranking all instances of ") << functionPrefix
+                  << (selection.isLocalPreferred ? " in the local site" : " by cost")
+                  << ": local headroom " << selection.localHeadroom << " of "
+                  << selection.nLocalInstances << " instances, threshold "
+                  << m_confParam.getSiteHeadroomThreshold());
+  }
+  if (selection != current) {
+    current = selection;
+    ++m_siteSelectionVersion;
+  }
+
+  if (!selection.isLocalPreferred) {
+    remoteRouters.clear();
+  }
+  return remoteRouters;
+}
+
+void
+NamePrefixTable::updateFibEntry(const ndn::Name& name)
+{
+  auto entryIt = std::find_if(m_table.begin(), m_table.end(),
+                              [&] (const auto& entry) { return name == entry->getNamePrefix(); });
+  if (entryIt == m_table.end()) {
+    return;
+  }
+  auto& entry = *entryIt;
+  entry->generateNhlfromRteList();
+  if (entry->getNexthopList().size() > 0) {
+    m_fib.update(entry->getNamePrefix(),
+                 adjustNexthopCosts(entry->getNexthopList(), entry->getNamePrefix(), *entry));
+  }
+}
+
+double
+NamePrefixTable::getChainDetourCost(const ndn::Name& functionPrefix, const ndn::Name& destRouter) const
+{
+  double detourCost = 0.0;
+  for (const auto& [chainName, selection] : m_chainSelections) {
+    const auto& stages = m_confParam.getServiceFunctionChains().at(chainName);
+    for (size_t k = 0; k < stages.size(); ++k) {
+      if (stages[k] != functionPrefix) {
+        continue;
+      }
+      auto it = selection.detourCosts[k].find(destRouter);
+      if (it != selection.detourCosts[k].end()) {
+        detourCost = std::max(detourCost, it->second);
+      }
+    }
+  }
+  return detourCost;
+}
+
+void
+NamePrefixTable::updateChainSelections()
+{
+  const auto& chains = m_confParam.getServiceFunctionChains();
+  m_areChainDistancesStale = false;
+  if (chains.empty()) {
+    return;
+  }
+
+  // Instances of a stage are the routers whose NameLSA advertises its prefix
+  m_chainInstances.clear();
+  std::map<ndn::Name, std::vector<ChainCandidate>> candidates;
+  for (const auto& [chainName, stages] : chains) {
+    for (const auto& stage : stages) {
+      candidates.try_emplace(stage);
+    }
+  }
+  auto nameLsaRange = m_lsdb.getLsdbIterator<NameLsa>();
+  for (auto it = nameLsaRange.first; it != nameLsaRange.second; ++it) {
+    auto nameLsa = std::static_pointer_cast<const NameLsa>(*it);
+    auto names = nameLsa->getNpl().getNames();
+    for (auto& [stage, stageCandidates] : candidates) {
+      if (std::find(names.begin(), names.end(), stage) != names.end()) {
+        double functionCost = 0.0;
+        auto sfInfo = getFreshServiceFunctionInfo(stage, nameLsa->getOriginRouter());
+        if (sfInfo) {
+          functionCost = getFunctionCostModel(stage).computeCost(*sfInfo);
+        }
+        stageCandidates.push_back({nameLsa->getOriginRouter(), functionCost});
+        m_chainInstances.insert(nameLsa->getOriginRouter());
+      }
+    }
+  }
+
+  // A leg starts at this router or at an instance of any stage but the last
+  std::set<ndn::Name> sources{m_ownRouterName};
+  for (const auto& [chainName, stages] : chains) {
+    for (size_t k = 0; k + 1 < stages.size(); ++k) {
+      for (const auto& candidate : candidates[stages[k]]) {
+        sources.insert(candidate.router);
+      }
+    }
+  }
+  auto adjLsaRange = m_lsdb.getLsdbIterator<AdjLsa>();
+  auto map = NameMap::createFromAdjLsdb(adjLsaRange.first, adjLsaRange.second);
+  auto distances = calculateLinkStateDistances(map, m_lsdb, sources);
+  auto distance = [&] (const ndn::Name& from, const ndn::Name& to) -> std::optional<double> {
+    auto fromIt = distances.find(from);
+    if (fromIt == distances.end()) {
+      return std::nullopt;
+    }
+    auto toIt = fromIt->second.find(to);
+    if (toIt == fromIt->second.end()) {
+      return std::nullopt;
+    }
+    return toIt->second;
+  };
+
+  std::map<std::string, ChainSelection> selections;
+  for (const auto& [chainName, stages] : chains) {
+    std::vector<std::vector<ChainCandidate>> stageCandidates;
+    for (const auto& stage : stages) {
+      stageCandidates.push_back(candidates[stage]);
+    }
+    auto selection = optimizeChain(m_ownRouterName, stageCandidates, distance);
+    if (!selection) {
+      NLSR_LOG_DEBUG("No reachable instance sequence for chain " << chainName);
+      continue;
+    }
+    NLSR_LOG_DEBUG("Selected chain " << chainName << " with cost " << selection->totalCost);
+    selections.emplace(chainName, std::move(*selection));
+  }
+
+  bool isChanged = selections.size() != m_chainSelections.size() ||
+    !std::equal(selections.begin(), selections.end(), m_chainSelections.begin(),
+                [] (const auto& a, const auto& b) {
+                  return a.first == b.first && a.second.routers == b.second.routers &&
+                         a.second.detourCosts == b.second.detourCosts;
+                });
+  if (!isChanged) {
+    return;
+  }
+  m_chainSelections = std::move(selections);
+
+  // The detour costs of every stage prefix may have changed
+  std::set<ndn::Name> stagePrefixes;
+  for (const auto& [chainName, stages] : chains) {
+    stagePrefixes.insert(stages.begin(), stages.end());
+  }
+  for (const auto& stage : stagePrefixes) {
+    updateFibEntry(stage);
+  }
+}
+
+const FunctionCostModel&
+NamePrefixTable::getFunctionCostModel(const ndn::Name& functionPrefix)
+{
+  auto type = m_confParam.getFunctionCostModel(functionPrefix);
+  auto& model = m_functionCostModels[type];
+  if (model == nullptr) {
+    model = makeFunctionCostModel(type, m_confParam);
+  }
+  return *model;
+}
+
 void
 NamePrefixTable::addEntry(const ndn::Name& name, const ndn::Name& destRouter)
 {
@@ -368,7 +712,7 @@ NamePrefixTable::addEntry(const ndn::Name& name, const ndn::Name& destRouter)
                               [&] (const auto& entry) { return name == entry->getNamePrefix(); });
 
   // Attempt to find a routing table pool entry (RTPE) we can use.
-  auto rtpeItr = m_rtpool.find(destRouter);
+  auto rtpeItr = m_rtpool.find(RouterNameInterner::getGlobal().intern(destRouter));
 
   // These declarations just to make the compiler happy...
   RoutingTablePoolEntry rtpe;
@@ -420,6 +764,9 @@ NamePrefixTable::addEntry(const ndn::Name& name, const ndn::Name& destRouter)
     else {
       NLSR_LOG_TRACE(npte->getNamePrefix() << " has no next hops; removing from FIB");
       m_fib.remove(name);
+      if (m_prober != nullptr) {
+        m_prober->removeTarget(name);
+      }
     }
   }
   else {
@@ -436,6 +783,9 @@ NamePrefixTable::addEntry(const ndn::Name& name, const ndn::Name& destRouter)
     else {
       NLSR_LOG_TRACE(npte->getNamePrefix() << " has no next hops; removing from FIB");
       m_fib.remove(name);
+      if (m_prober != nullptr) {
+        m_prober->removeTarget(name);
+      }
     }
   }
 
@@ -450,7 +800,8 @@ NamePrefixTable::removeEntry(const ndn::Name& name, const ndn::Name& destRouter)
   NLSR_LOG_DEBUG("Removing origin: " << destRouter << " from " << name);
 
   // Fetch an iterator to the appropriate pair object in the pool.
-  auto rtpeItr = m_rtpool.find(destRouter);
+  auto destRouterId = RouterNameInterner::getGlobal().find(destRouter);
+  auto rtpeItr = destRouterId ? m_rtpool.find(*destRouterId) : m_rtpool.end();
 
   // Simple error checking to prevent any unusual behavior in the case
   // that we try to remove an entry that isn't there.
@@ -494,6 +845,9 @@ NamePrefixTable::removeEntry(const ndn::Name& name, const ndn::Name& destRouter)
                      << " removing from table and FIB");
       m_table.erase(nameItr);
       m_fib.remove(name);
+      if (m_prober != nullptr) {
+        m_prober->removeTarget(name);
+      }
     }
     else {
       NLSR_LOG_TRACE(**nameItr << " has other routing table entries;"
@@ -513,15 +867,20 @@ NamePrefixTable::updateWithNewRoute(const std::list<RoutingTableEntry>& entries)
 {
   NLSR_LOG_DEBUG("Updating table with newly calculated routes");
 
+  // Index the new routes by destination, so that each pool entry finds its route directly
+  std::unordered_map<RouterId, const RoutingTableEntry*> entriesByDestination;
+  for (const auto& entry : entries) {
+    entriesByDestination.try_emplace(entry.getDestinationId(), &entry);
+  }
+
   // Iterate over each pool entry we have
   for (auto&& poolEntryPair : m_rtpool) {
     auto&& poolEntry = poolEntryPair.second;
-    auto sourceEntry = std::find_if(entries.begin(), entries.end(),
-                                    [&poolEntry] (const RoutingTableEntry& entry) {
-                                      return poolEntry->getDestination() == entry.getDestination();
-                                    });
+    auto sourceIt = entriesByDestination.find(poolEntryPair.first);
+    const RoutingTableEntry* sourceEntry = sourceIt != entriesByDestination.end() ?
+                                           sourceIt->second : nullptr;
     // If this pool entry has a corresponding entry in the routing table now
-    if (sourceEntry != entries.end()
+    if (sourceEntry != nullptr
         && poolEntry->getNexthopList() != sourceEntry->getNexthopList()) {
       NLSR_LOG_DEBUG("Routing entry: " << poolEntry->getDestination() << " has changed next-hops.");
       poolEntry->setNexthopList(sourceEntry->getNexthopList());
@@ -530,7 +889,7 @@ NamePrefixTable::updateWithNewRoute(const std::list<RoutingTableEntry>& entries)
         addEntry(nameEntryFullPtr->getNamePrefix(), poolEntry->getDestination());
       }
     }
-    else if (sourceEntry == entries.end()) {
+    else if (sourceEntry == nullptr) {
       NLSR_LOG_DEBUG("Routing entry: " << poolEntry->getDestination() << " now has no next-hops.");
       poolEntry->getNexthopList().clear();
       for (const auto& nameEntry : poolEntry->namePrefixTableEntries) {
@@ -543,6 +902,10 @@ NamePrefixTable::updateWithNewRoute(const std::list<RoutingTableEntry>& entries)
                  << ", no action necessary.");
     }
   }
+  // Distances between instances may have changed
+  if (m_areChainDistancesStale) {
+    updateChainSelections();
+  }
 }
 
 // Inserts the routing table pool entry into the NPT's RTE storage
@@ -551,7 +914,7 @@ NamePrefixTable::updateWithNewRoute(const std::list<RoutingTableEntry>& entries)
 std::shared_ptr<RoutingTablePoolEntry>
 NamePrefixTable::addRtpeToPool(RoutingTablePoolEntry& rtpe)
 {
-  auto poolIt = m_rtpool.try_emplace(rtpe.getDestination(),
+  auto poolIt = m_rtpool.try_emplace(rtpe.getDestinationId(),
                                      std::make_shared<RoutingTablePoolEntry>(rtpe)).first;
   return poolIt->second;
 }
@@ -565,7 +928,7 @@ NamePrefixTable::addRtpeToPool(RoutingTablePoolEntry& rtpe)
 void
 NamePrefixTable::deleteRtpeFromPool(std::shared_ptr<RoutingTablePoolEntry> rtpePtr)
 {
-  if (m_rtpool.erase(rtpePtr->getDestination()) != 1) {
+  if (m_rtpool.erase(rtpePtr->getDestinationId()) != 1) {
     NLSR_LOG_DEBUG("Attempted to delete non-existent origin: "
                    << rtpePtr->getDestination()
                    << " from NPT routing table entry storage pool.");
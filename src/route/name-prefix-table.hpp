@@ -27,10 +27,17 @@
 #include "signals.hpp"
 #include "test-access-control.hpp"
 #include "route/fib.hpp"
+#include "route/function-cost-model.hpp"
+#include "route/service-function-prober.hpp"
+#include "route/sfc-chain-optimizer.hpp"
+#include "route/traffic-split.hpp"
 #include "lsdb.hpp"
 #include "conf-parameter.hpp"
 
+#include <ndn-cxx/util/scheduler.hpp>
+
 #include <list>
+#include <set>
 #include <unordered_map>
 
 namespace nlsr {
@@ -39,21 +46,30 @@ class NamePrefixTable
 {
 public:
   using RoutingTableEntryPool =
-    std::unordered_map<ndn::Name, std::shared_ptr<RoutingTablePoolEntry>>;
+    std::unordered_map<RouterId, std::shared_ptr<RoutingTablePoolEntry>>;
   using NptEntryList = std::list<std::shared_ptr<NamePrefixTableEntry>>;
   using const_iterator = NptEntryList::const_iterator;
-  using DestNameKey = std::tuple<ndn::Name, ndn::Name>;
+  using DestNameKey = std::tuple<RouterId, ndn::Name>;
 
   NamePrefixTable(const ndn::Name& ownRouterName, Fib& fib, RoutingTable& routingTable,
                   AfterRoutingChange& afterRoutingChangeSignal,
                   Lsdb::AfterLsdbModified& afterLsdbModifiedSignal,
-                  Lsdb& lsdb, ConfParameter& confParam);
+                  Lsdb& lsdb, ConfParameter& confParam, ndn::Scheduler& scheduler);
 
   ~NamePrefixTable();
 
   NexthopList
   adjustNexthopCosts(const NexthopList& nhlist, const ndn::Name& nameToCheck, const NamePrefixTableEntry& npte);
 
+  /*! \brief Blend the probe measurements of \p prober into the cost of Service Function next hops.
+    \param prober The prober, or nullptr to stop using it; must outlive this table
+   */
+  void
+  setServiceFunctionProber(ServiceFunctionProber* prober)
+  {
+    m_prober = prober;
+  }
+
   /*! \brief Add, update, or remove Names according to the Lsdb update
     \param lsa The LSA class pointer
     \param updateType Update type from Lsdb (INSTALLED, UPDATED, REMOVED)
@@ -129,6 +145,35 @@ public:
   void
   deleteRtpeFromPool(std::shared_ptr<RoutingTablePoolEntry> rtpePtr);
 
+  /*! \brief Returns the instance sequence selected for each configured chain.
+
+    Chains without a reachable instance sequence are absent.
+   */
+  const std::map<std::string, ChainSelection>&
+  getChainSelections() const
+  {
+    return m_chainSelections;
+  }
+
+  /*! \brief Returns whether the requests for each Service Function prefix stay in the
+    local site, see selectSite().
+
+    Only filled if site-preference is enabled.
+   */
+  const std::map<ndn::Name, SiteSelection>&
+  getSiteSelections() const
+  {
+    return m_siteSelections;
+  }
+
+  /*! \brief Returns a number incremented whenever a site selection changes.
+   */
+  uint64_t
+  getSiteSelectionVersion() const
+  {
+    return m_siteSelectionVersion;
+  }
+
   void
   writeLog();
 
@@ -143,6 +188,76 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
   NptEntryList m_table;
 
+private:
+  /*! \brief Returns the cost model configured for \p functionPrefix, creating it if needed.
+   */
+  const FunctionCostModel&
+  getFunctionCostModel(const ndn::Name& functionPrefix);
+
+  /*! \brief Returns the cost of the probe measurement of \p functionPrefix through \p faceUri.
+
+    The smoothed RTT costs probe-cost-per-second, and every probe failure raises the cost
+    towards probe-failure-cost.
+   */
+  double
+  computeProbeCost(const ndn::Name& functionPrefix, const ndn::FaceUri& faceUri) const;
+
+  /*! \brief Returns the Service Function info \p destRouter advertises for \p functionPrefix,
+    extrapolated to now, or nullopt if there is none or it is stale.
+   */
+  std::optional<ServiceFunctionInfo>
+  getFreshServiceFunctionInfo(const ndn::Name& functionPrefix, const ndn::Name& destRouter) const;
+
+  /*! \brief Returns how much more the best chain through \p destRouter costs than the
+    selected chain, over the chains \p functionPrefix is a stage of.
+   */
+  double
+  getChainDetourCost(const ndn::Name& functionPrefix, const ndn::Name& destRouter) const;
+
+  /*! \brief Returns whether the next hops towards \p rtpe are left out of \p functionPrefix
+    because the instance there is overloaded.
+
+    They are left out as soon as the instance advertises an overload, and restored
+    overload-hold-time after it stopped advertising one.
+    \param sfInfo The fresh Service Function info of the instance, if any
+   */
+  bool
+  isShedForOverload(const ndn::Name& functionPrefix, const RoutingTablePoolEntry& rtpe,
+                    const std::optional<ServiceFunctionInfo>& sfInfo);
+
+  /*! \brief Returns whether \p router is in the site of this router.
+   */
+  bool
+  isInLocalSite(const ndn::Name& router) const;
+
+  /*! \brief Selects the site the requests for \p functionPrefix are served in.
+    \param shedRouters Instances left out for an overload, which are not counted
+    \return the routers of other sites to rank after the local ones
+   */
+  std::set<ndn::Name>
+  selectSiteOf(const ndn::Name& functionPrefix, const NamePrefixTableEntry& npte,
+               const std::set<ndn::Name>& shedRouters);
+
+  /*! \brief Returns whether \p lsa is a Name LSA the chain selections depend on: it
+    advertises a stage prefix, or its router was an instance of a stage.
+   */
+  bool
+  isChainInput(const Lsa& lsa) const;
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /*! \brief Installs the next hops of the entry of \p name in the FIB again, if it exists.
+   */
+  void
+  updateFibEntry(const ndn::Name& name);
+
+  /*! \brief Selects the instances of every configured chain again.
+
+    Uses the link-state distances between routers and the advertised function costs. If
+    a selection changes, the FIB entries of the stage prefixes are updated.
+   */
+  void
+  updateChainSelections();
+
 private:
   const ndn::Name& m_ownRouterName;
   Fib& m_fib;
@@ -151,7 +266,25 @@ private:
   ConfParameter& m_confParam;
   ndn::signal::Connection m_afterRoutingChangeConnection;
   ndn::signal::Connection m_afterLsdbModified;
-  std::map<std::tuple<ndn::Name, ndn::Name>, double> m_nexthopCost;
+  std::map<DestNameKey, double> m_nexthopCost;
+  std::map<FunctionCostModelType, std::unique_ptr<FunctionCostModel>> m_functionCostModels;
+  ServiceFunctionProber* m_prober = nullptr;
+  std::map<std::string, ChainSelection> m_chainSelections;
+  /// routers that were instances of a chain stage at the latest selection
+  std::set<ndn::Name> m_chainInstances;
+  /// whether the adjacency LSDB changed since the latest selection
+  bool m_areChainDistancesStale = true;
+  std::map<ndn::Name, SiteSelection> m_siteSelections;
+  uint64_t m_siteSelectionVersion = 0;
+
+  ndn::Scheduler& m_scheduler;
+  struct OverloadedInstance
+  {
+    /// whether the overload ended and the next hops are about to be restored
+    bool isRestoring = false;
+    ndn::scheduler::ScopedEventId restoreEvent;
+  };
+  std::map<DestNameKey, OverloadedInstance> m_overloadedInstances;
 };
 
 inline NamePrefixTable::const_iterator
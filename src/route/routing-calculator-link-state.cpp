@@ -175,7 +175,7 @@ makeAdjMatrix(const Lsdb& lsdb, NameMap& map)
   auto lsaRange = lsdb.getLsdbIterator<AdjLsa>();
   for (auto lsaIt = lsaRange.first; lsaIt != lsaRange.second; ++lsaIt) {
     auto adjLsa = std::static_pointer_cast<AdjLsa>(*lsaIt);
-    auto row = map.getMappingNoByRouterName(adjLsa->getOriginRouter());
+    auto row = map.getMappingNoByRouterId(adjLsa->getOriginRouterId());
 
     std::list<Adjacent> adl = adjLsa->getAdl().getAdjList();
     // For each adjacency represented in the LSA
@@ -424,4 +424,29 @@ calculateLinkStateRoutingPath(NameMap& map, RoutingTable& rt, ConfParameter& con
   }
 }
 
+std::map<ndn::Name, std::map<ndn::Name, double>>
+calculateLinkStateDistances(NameMap& map, const Lsdb& lsdb, const std::set<ndn::Name>& sources)
+{
+  std::map<ndn::Name, std::map<ndn::Name, double>> distances;
+  AdjMatrix matrix = makeAdjMatrix(lsdb, map);
+
+  for (const auto& source : sources) {
+    auto sourceRouter = map.getMappingNoByRouterName(source);
+    if (!sourceRouter) {
+      continue;
+    }
+
+    auto dr = calculateDijkstraPath(matrix, *sourceRouter);
+    auto& fromSource = distances[source];
+    for (size_t i = 0; i < map.size(); ++i) {
+      auto routerName = map.getRouterNameByMappingNo(i);
+      bool isReachable = i == static_cast<size_t>(*sourceRouter) || dr.parent[i] != EMPTY_PARENT;
+      if (routerName && isReachable) {
+        fromSource[*routerName] = dr.costs[i].totalCost;
+      }
+    }
+  }
+  return distances;
+}
+
 } // namespace nlsr
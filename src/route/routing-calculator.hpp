@@ -26,6 +26,8 @@
 #include "name-map.hpp"
 #include "conf-parameter.hpp"
 
+#include <set>
+
 namespace nlsr {
 
 constexpr double INF_DISTANCE = 2147483647;
@@ -55,6 +57,13 @@ calculateLinkStateRoutingPath(NameMap& map, RoutingTable& rt,
                             ConfParameter& confParam,
                             const Lsdb& lsdb);
 
+/*! \brief Computes the link-state distance from each of \p sources to every router it reaches.
+
+  Sources absent from \p map are left out of the result.
+ */
+std::map<ndn::Name, std::map<ndn::Name, double>>
+calculateLinkStateDistances(NameMap& map, const Lsdb& lsdb, const std::set<ndn::Name>& sources);
+
 void
 calculateHyperbolicRoutingPath(NameMap& map, RoutingTable& rt, Lsdb& lsdb,
                                AdjacencyList& adjacencies, ndn::Name thisRouterName,
@@ -78,6 +78,7 @@ RoutingTableEntry::wireDecode(const ndn::Block& wire)
 
   if (val != m_wire.elements_end() && val->type() == ndn::tlv::Name) {
     m_destination.wireDecode(*val);
+    m_destinationId.reset();
     ++val;
   }
   else {
@@ -22,6 +22,7 @@
 #define NLSR_ROUTING_TABLE_ENTRY_HPP
 
 #include "nexthop-list.hpp"
+#include "router-name-interner.hpp"
 
 #include <ndn-cxx/encoding/block.hpp>
 #include <ndn-cxx/encoding/encoding-buffer.hpp>
@@ -61,6 +62,17 @@ public:
     return m_destination;
   }
 
+  /*! \brief Returns the id of the destination in the global RouterNameInterner.
+   */
+  RouterId
+  getDestinationId() const
+  {
+    if (!m_destinationId) {
+      m_destinationId = RouterNameInterner::getGlobal().intern(m_destination);
+    }
+    return *m_destinationId;
+  }
+
   NexthopList&
   getNexthopList()
   {
@@ -95,6 +107,7 @@ protected:
   NexthopList m_nexthopList;
 
   mutable ndn::Block m_wire;
+  mutable std::optional<RouterId> m_destinationId;
 };
 
 NDN_CXX_DECLARE_WIRE_ENCODE_INSTANTIATIONS(RoutingTableEntry);
@@ -0,0 +1,191 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "service-function-prober.hpp"
+#include "adjacency-list.hpp"
+#include "logger.hpp"
+
+#include <ndn-cxx/lp/tags.hpp>
+#include <ndn-cxx/util/random.hpp>
+
+#include <algorithm>
+
+namespace nlsr {
+
+INIT_LOGGER(route.ServiceFunctionProber);
+
+ServiceFunctionProber::ServiceFunctionProber(ndn::Face& face, ndn::Scheduler& scheduler,
+                                             AdjacencyList& adjacencyList, const Options& options)
+  : m_face(face)
+  , m_scheduler(scheduler)
+  , m_adjacencyList(adjacencyList)
+  , m_options(options)
+{
+}
+
+void
+ServiceFunctionProber::setTargets(const ndn::Name& prefix, const std::set<ndn::FaceUri>& faces)
+{
+  if (faces.empty()) {
+    removeTarget(prefix);
+    return;
+  }
+
+  auto [it, isNew] = m_targets.try_emplace(prefix);
+  auto& target = it->second;
+  for (auto mIt = target.measurements.begin(); mIt != target.measurements.end();) {
+    if (faces.count(mIt->first) == 0) {
+      target.pendingProbes.erase(mIt->first);
+      mIt = target.measurements.erase(mIt);
+    }
+    else {
+      ++mIt;
+    }
+  }
+  for (const auto& faceUri : faces) {
+    target.measurements.try_emplace(faceUri);
+  }
+
+  if (isNew) {
+    auto intervalMs = static_cast<uint32_t>(std::max<int64_t>(m_options.interval.count(), 1));
+    scheduleRound(prefix, ndn::time::milliseconds(ndn::random::generateWord32() % intervalMs));
+  }
+}
+
+void
+ServiceFunctionProber::removeTarget(const ndn::Name& prefix)
+{
+  if (m_targets.erase(prefix) > 0) {
+    NLSR_LOG_DEBUG("Stopped probing " << prefix);
+  }
+}
+
+const ServiceFunctionProber::Measurement*
+ServiceFunctionProber::getMeasurement(const ndn::Name& prefix, const ndn::FaceUri& faceUri) const
+{
+  auto it = m_targets.find(prefix);
+  if (it == m_targets.end()) {
+    return nullptr;
+  }
+  auto mIt = it->second.measurements.find(faceUri);
+  return mIt != it->second.measurements.end() ? &mIt->second : nullptr;
+}
+
+void
+ServiceFunctionProber::scheduleRound(const ndn::Name& prefix, ndn::time::nanoseconds delay)
+{
+  auto it = m_targets.find(prefix);
+  if (it == m_targets.end()) {
+    return;
+  }
+  it->second.roundEvent = m_scheduler.schedule(delay, [this, prefix] { probe(prefix); });
+}
+
+void
+ServiceFunctionProber::probe(const ndn::Name& prefix)
+{
+  auto it = m_targets.find(prefix);
+  if (it == m_targets.end()) {
+    return;
+  }
+  auto& target = it->second;
+
+  // take turns among the next hops when there are more than a round may probe
+  size_t nFaces = target.measurements.size();
+  size_t nProbes = std::min(nFaces, m_options.maxFacesPerRound);
+  auto faceIt = std::next(target.measurements.begin(), target.nextFace % nFaces);
+  for (size_t i = 0; i < nProbes; ++i) {
+    const auto& faceUri = faceIt->first;
+    if (target.pendingProbes.count(faceUri) == 0) {
+      uint64_t faceId = m_adjacencyList.getFaceId(faceUri);
+      if (faceId != 0) {
+        sendProbe(prefix, faceUri, faceId);
+      }
+    }
+    if (++faceIt == target.measurements.end()) {
+      faceIt = target.measurements.begin();
+    }
+  }
+  target.nextFace = (target.nextFace + nProbes) % nFaces;
+
+  scheduleRound(prefix, m_options.interval);
+}
+
+void
+ServiceFunctionProber::sendProbe(const ndn::Name& prefix, const ndn::FaceUri& faceUri, uint64_t faceId)
+{
+  ndn::Interest interest(ndn::Name(prefix).append(PROBE_COMPONENT)
+                                          .appendNumber(ndn::random::generateWord64()));
+  interest.setMustBeFresh(true);
+  interest.setInterestLifetime(m_options.interestLifetime);
+  interest.setTag(std::make_shared<ndn::lp::NextHopFaceIdTag>(faceId));
+
+  NLSR_LOG_TRACE("Probing " << prefix << " via " << faceUri << " (face " << faceId << ")");
+  auto sendTime = ndn::time::steady_clock::now();
+  m_targets.at(prefix).pendingProbes[faceUri] = m_face.expressInterest(interest,
+    [this, prefix, faceUri, sendTime] (const auto&, const auto&) {
+      afterProbe(prefix, faceUri,
+                 ndn::time::duration_cast<ndn::time::nanoseconds>(ndn::time::steady_clock::now() - sendTime));
+    },
+    [this, prefix, faceUri] (const auto&, const auto&) {
+      afterProbe(prefix, faceUri, std::nullopt);
+    },
+    [this, prefix, faceUri] (const auto&) {
+      afterProbe(prefix, faceUri, std::nullopt);
+    });
+}
+
+void
+ServiceFunctionProber::afterProbe(const ndn::Name& prefix, const ndn::FaceUri& faceUri,
+                                  std::optional<ndn::time::nanoseconds> rtt)
+{
+  auto it = m_targets.find(prefix);
+  if (it == m_targets.end()) {
+    return;
+  }
+  auto& target = it->second;
+  target.pendingProbes.erase(faceUri);
+  auto mIt = target.measurements.find(faceUri);
+  if (mIt == target.measurements.end()) {
+    return;
+  }
+
+  auto& measurement = mIt->second;
+  ++measurement.nProbes;
+  double outcome = rtt ? 1.0 : 0.0;
+  measurement.successRate += m_options.successAlpha * (outcome - measurement.successRate);
+  if (rtt) {
+    measurement.srtt = measurement.srtt ?
+      ndn::time::nanoseconds(static_cast<int64_t>((1 - m_options.rttAlpha) * measurement.srtt->count() +
+                                                  m_options.rttAlpha * rtt->count())) :
+      *rtt;
+  }
+  else {
+    ++measurement.nFailures;
+  }
+
+  NLSR_LOG_DEBUG("Probe of " << prefix << " via " << faceUri
+                 << (rtt ? " answered" : " failed") << ", srtt="
+                 << (measurement.srtt ? measurement.srtt->count() / 1000 : -1) << " us"
+                 << ", successRate=" << measurement.successRate);
+}
+
+} // namespace nlsr
@@ -0,0 +1,135 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_ROUTE_SERVICE_FUNCTION_PROBER_HPP
+#define NLSR_ROUTE_SERVICE_FUNCTION_PROBER_HPP
+
+#include "common.hpp"
+#include "test-access-control.hpp"
+
+#include <ndn-cxx/face.hpp>
+#include <ndn-cxx/net/face-uri.hpp>
+#include <ndn-cxx/util/scheduler.hpp>
+
+#include <boost/noncopyable.hpp>
+
+#include <map>
+#include <optional>
+#include <set>
+
+namespace nlsr {
+
+class AdjacencyList;
+
+/*! \brief Measures the RTT and success rate of Service Function prefixes through each next hop.
+
+  The advertised Service Function info only reflects what the instance itself logs, which
+  misses congestion on the way to it and instances whose sidecar has stalled. The prober
+  periodically sends a probe Interest, <tt>\<prefix\>/nlsr-probe/\<random\></tt>, through a
+  specific next hop, and the instance is expected to answer it with any Data. A Data is a
+  success; a Nack or a timeout is a failure.
+
+  Probing is strictly rate limited per prefix: a prefix gets one probe round every
+  Options::interval, and a round probes at most Options::maxFacesPerRound next hops,
+  taking turns when the prefix has more. A next hop with a probe in flight is skipped.
+ */
+class ServiceFunctionProber : boost::noncopyable
+{
+public:
+  struct Options
+  {
+    ndn::time::milliseconds interval = 10_s;
+    size_t maxFacesPerRound = 4;
+    ndn::time::milliseconds interestLifetime = 2_s;
+    /// weight of a new sample in the smoothed RTT
+    double rttAlpha = 0.125;
+    /// weight of a new outcome in the success rate
+    double successAlpha = 0.2;
+  };
+
+  struct Measurement
+  {
+    std::optional<ndn::time::nanoseconds> srtt;
+    /// smoothed share of probes answered, 1.0 before the first probe
+    double successRate = 1.0;
+    uint64_t nProbes = 0;
+    uint64_t nFailures = 0;
+  };
+
+  ServiceFunctionProber(ndn::Face& face, ndn::Scheduler& scheduler,
+                        AdjacencyList& adjacencyList, const Options& options);
+
+  /*! \brief Sets the next hops through which \p prefix is probed.
+
+    Measurements of next hops no longer in \p faces are dropped. The first round of a new
+    prefix is scheduled at a random point of the interval, so that prefixes learned together
+    are not probed together.
+   */
+  void
+  setTargets(const ndn::Name& prefix, const std::set<ndn::FaceUri>& faces);
+
+  /*! \brief Stops probing \p prefix.
+   */
+  void
+  removeTarget(const ndn::Name& prefix);
+
+  /*! \brief Returns the measurement of \p prefix through \p faceUri, or nullptr if none.
+   */
+  const Measurement*
+  getMeasurement(const ndn::Name& prefix, const ndn::FaceUri& faceUri) const;
+
+public:
+  static inline const ndn::name::Component PROBE_COMPONENT{"nlsr-probe"};
+
+private:
+  void
+  scheduleRound(const ndn::Name& prefix, ndn::time::nanoseconds delay);
+
+  void
+  probe(const ndn::Name& prefix);
+
+  void
+  sendProbe(const ndn::Name& prefix, const ndn::FaceUri& faceUri, uint64_t faceId);
+
+  void
+  afterProbe(const ndn::Name& prefix, const ndn::FaceUri& faceUri,
+             std::optional<ndn::time::nanoseconds> rtt);
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  struct Target
+  {
+    std::map<ndn::FaceUri, Measurement> measurements;
+    std::map<ndn::FaceUri, ndn::ScopedPendingInterestHandle> pendingProbes;
+    /// index of the next hop that starts the next round
+    size_t nextFace = 0;
+    ndn::scheduler::ScopedEventId roundEvent;
+  };
+
+  ndn::Face& m_face;
+  ndn::Scheduler& m_scheduler;
+  AdjacencyList& m_adjacencyList;
+  Options m_options;
+  std::map<ndn::Name, Target> m_targets;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_ROUTE_SERVICE_FUNCTION_PROBER_HPP
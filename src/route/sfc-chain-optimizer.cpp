@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sfc-chain-optimizer.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace nlsr {
+
+namespace {
+
+constexpr double UNREACHABLE = std::numeric_limits<double>::infinity();
+
+double
+getDistance(const ChainDistance& distance, const ndn::Name& from, const ndn::Name& to)
+{
+  if (from == to) {
+    return 0.0;
+  }
+  return distance(from, to).value_or(UNREACHABLE);
+}
+
+} // anonymous namespace
+
+std::optional<ChainSelection>
+optimizeChain(const ndn::Name& source, const std::vector<std::vector<ChainCandidate>>& stages,
+              const ChainDistance& distance)
+{
+  size_t nStages = stages.size();
+  if (nStages == 0) {
+    return std::nullopt;
+  }
+
+  // forward[k][i]: cheapest cost from source up to and including candidate i of stage k
+  std::vector<std::vector<double>> forward(nStages);
+  std::vector<std::vector<size_t>> parent(nStages);
+  for (size_t k = 0; k < nStages; ++k) {
+    forward[k].assign(stages[k].size(), UNREACHABLE);
+    parent[k].assign(stages[k].size(), 0);
+    for (size_t i = 0; i < stages[k].size(); ++i) {
+      const auto& candidate = stages[k][i];
+      if (k == 0) {
+        forward[k][i] = getDistance(distance, source, candidate.router) + candidate.functionCost;
+        continue;
+      }
+      for (size_t j = 0; j < stages[k - 1].size(); ++j) {
+        double cost = forward[k - 1][j] +
+                      getDistance(distance, stages[k - 1][j].router, candidate.router) +
+                      candidate.functionCost;
+        if (cost < forward[k][i]) {
+          forward[k][i] = cost;
+          parent[k][i] = j;
+        }
+      }
+    }
+  }
+
+  // backward[k][i]: cheapest cost of the remaining stages after candidate i of stage k
+  std::vector<std::vector<double>> backward(nStages);
+  backward[nStages - 1].assign(stages[nStages - 1].size(), 0.0);
+  for (size_t k = nStages - 1; k-- > 0;) {
+    backward[k].assign(stages[k].size(), UNREACHABLE);
+    for (size_t i = 0; i < stages[k].size(); ++i) {
+      for (size_t j = 0; j < stages[k + 1].size(); ++j) {
+        double cost = getDistance(distance, stages[k][i].router, stages[k + 1][j].router) +
+                      stages[k + 1][j].functionCost + backward[k + 1][j];
+        backward[k][i] = std::min(backward[k][i], cost);
+      }
+    }
+  }
+
+  const auto& last = forward[nStages - 1];
+  auto best = std::min_element(last.begin(), last.end());
+  if (best == last.end() || *best == UNREACHABLE) {
+    return std::nullopt;
+  }
+
+  ChainSelection selection;
+  selection.totalCost = *best;
+  selection.routers.resize(nStages);
+  size_t index = std::distance(last.begin(), best);
+  for (size_t k = nStages; k-- > 0;) {
+    selection.routers[k] = stages[k][index].router;
+    index = parent[k][index];
+  }
+
+  selection.detourCosts.resize(nStages);
+  for (size_t k = 0; k < nStages; ++k) {
+    for (size_t i = 0; i < stages[k].size(); ++i) {
+      double cost = forward[k][i] + backward[k][i];
+      if (cost == UNREACHABLE) {
+        continue;
+      }
+      // the same router may host several candidates of one stage; keep the cheapest
+      double detour = std::max(0.0, cost - selection.totalCost);
+      auto [it, isNew] = selection.detourCosts[k].emplace(stages[k][i].router, detour);
+      if (!isNew) {
+        it->second = std::min(it->second, detour);
+      }
+    }
+  }
+
+  return selection;
+}
+
+} // namespace nlsr
@@ -0,0 +1,75 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_ROUTE_SFC_CHAIN_OPTIMIZER_HPP
+#define NLSR_ROUTE_SFC_CHAIN_OPTIMIZER_HPP
+
+#include "common.hpp"
+
+#include <functional>
+#include <map>
+#include <optional>
+#include <vector>
+
+namespace nlsr {
+
+/*! \brief An instance of one chain stage: the router that hosts it and its function cost.
+ */
+struct ChainCandidate
+{
+  ndn::Name router;
+  double functionCost = 0.0;
+};
+
+/*! \brief The instance sequence selected for a Service Function chain.
+ */
+struct ChainSelection
+{
+  /// selected instance router of each stage
+  std::vector<ndn::Name> routers;
+  /// link distance plus function cost of the whole chain
+  double totalCost = 0.0;
+  /// per stage, how much more the best chain through each candidate costs than the selection
+  std::vector<std::map<ndn::Name, double>> detourCosts;
+};
+
+/*! \brief Returns the link distance between two routers, or nullopt if unreachable.
+ */
+using ChainDistance = std::function<std::optional<double>(const ndn::Name&, const ndn::Name&)>;
+
+/*! \brief Selects the instance sequence that minimizes the total cost of a chain.
+
+  A request enters at \p source, visits one instance of every stage in order, and pays
+  the link distance of every leg plus the function cost of every instance it visits.
+  Dynamic programming over the stages keeps, for each candidate, the cheapest way to
+  reach it; the work is linear in the number of stages and quadratic in the number of
+  candidates per stage. A backward pass over the same stages gives, for every candidate,
+  the cost of the best chain forced through it, from which the detour costs are derived.
+
+  \return nullopt if the chain is empty or some stage has no reachable candidate
+ */
+std::optional<ChainSelection>
+optimizeChain(const ndn::Name& source, const std::vector<std::vector<ChainCandidate>>& stages,
+              const ChainDistance& distance);
+
+} // namespace nlsr
+
+#endif // NLSR_ROUTE_SFC_CHAIN_OPTIMIZER_HPP
@@ -0,0 +1,98 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "traffic-split.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace nlsr {
+
+double
+computeHeadroom(const ServiceFunctionInfo& info)
+{
+  double nWorkers = std::max<uint32_t>(info.workerCapacity, 1);
+  return nWorkers * std::clamp(1.0 - info.utilization, 0.0, 1.0);
+}
+
+std::map<ndn::FaceUri, uint32_t>
+computeTrafficSplit(const std::map<ndn::FaceUri, double>& headroomPerFace, uint32_t total)
+{
+  std::map<ndn::FaceUri, uint32_t> split;
+  if (headroomPerFace.empty()) {
+    return split;
+  }
+
+  // the minimum weight of every face is set aside first
+  auto nFaces = static_cast<uint32_t>(headroomPerFace.size());
+  total = std::max(total, nFaces);
+  uint32_t remaining = total - nFaces;
+
+  double sum = 0.0;
+  for (const auto& [faceUri, headroom] : headroomPerFace) {
+    sum += std::max(headroom, 0.0);
+  }
+
+  std::vector<std::pair<double, ndn::FaceUri>> remainders;
+  uint32_t assigned = 0;
+  for (const auto& [faceUri, headroom] : headroomPerFace) {
+    double share = sum > 0.0 ? remaining * std::max(headroom, 0.0) / sum
+                             : static_cast<double>(remaining) / nFaces;
+    auto weight = static_cast<uint32_t>(std::floor(share));
+    split[faceUri] = 1 + weight;
+    assigned += weight;
+    remainders.emplace_back(share - weight, faceUri);
+  }
+
+  std::stable_sort(remainders.begin(), remainders.end(),
+                   [] (const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+  for (size_t i = 0; assigned < remaining && i < remainders.size(); ++i, ++assigned) {
+    ++split[remainders[i].second];
+  }
+  return split;
+}
+
+SiteSelection
+selectSite(const std::vector<std::pair<bool, ServiceFunctionInfo>>& instances, double headroomThreshold)
+{
+  SiteSelection selection;
+  double localWorkers = 0.0;
+  double localHeadroom = 0.0;
+  for (const auto& [isLocal, info] : instances) {
+    if (!isLocal) {
+      ++selection.nRemoteInstances;
+      continue;
+    }
+    ++selection.nLocalInstances;
+    localWorkers += std::max<uint32_t>(info.workerCapacity, 1);
+    localHeadroom += computeHeadroom(info);
+  }
+
+  if (selection.nLocalInstances > 0) {
+    selection.localHeadroom = localHeadroom / localWorkers;
+  }
+  selection.isLocalPreferred = selection.nLocalInstances > 0 && selection.nRemoteInstances > 0 &&
+                               selection.localHeadroom >= headroomThreshold;
+  return selection;
+}
+
+} // namespace nlsr
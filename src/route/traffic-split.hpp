@@ -0,0 +1,90 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_ROUTE_TRAFFIC_SPLIT_HPP
+#define NLSR_ROUTE_TRAFFIC_SPLIT_HPP
+
+#include "lsa/name-lsa.hpp"
+
+#include <ndn-cxx/net/face-uri.hpp>
+
+#include <map>
+#include <vector>
+
+namespace nlsr {
+
+/*! \brief Returns the spare capacity of a Service Function instance, in workers.
+
+  An instance that advertises no worker capacity counts as one worker.
+ */
+double
+computeHeadroom(const ServiceFunctionInfo& info);
+
+/*! \brief Splits traffic over next hops in proportion to the headroom behind them.
+  \param headroomPerFace Summed headroom of the instances reached through each face
+  \param total Sum of the returned weights
+
+  Every face gets a weight of at least 1, so a saturated instance still receives a trickle
+  of traffic and its recovery is noticed. If no face has headroom, traffic is split evenly.
+  Weights are rounded with the largest remainder method, so they add up to \p total.
+ */
+std::map<ndn::FaceUri, uint32_t>
+computeTrafficSplit(const std::map<ndn::FaceUri, double>& headroomPerFace, uint32_t total = 100);
+
+/*! \brief Whether the requests for a Service Function stay in the local site.
+ */
+struct SiteSelection
+{
+  size_t nLocalInstances = 0;
+  size_t nRemoteInstances = 0;
+  /// spare share of the workers of the local instances, 0.0 ~ 1.0
+  double localHeadroom = 0.0;
+  /// whether the instances of other sites are only used as a fallback
+  bool isLocalPreferred = false;
+
+  friend bool
+  operator==(const SiteSelection& lhs, const SiteSelection& rhs)
+  {
+    return lhs.nLocalInstances == rhs.nLocalInstances && lhs.nRemoteInstances == rhs.nRemoteInstances &&
+           lhs.localHeadroom == rhs.localHeadroom && lhs.isLocalPreferred == rhs.isLocalPreferred;
+  }
+
+  friend bool
+  operator!=(const SiteSelection& lhs, const SiteSelection& rhs)
+  {
+    return !(lhs == rhs);
+  }
+};
+
+/*! \brief Decides whether the requests for a Service Function stay in the local site.
+  \param instances Whether each instance is in the local site, and its Service Function info
+  \param headroomThreshold Spare share of the local workers below which requests spill over
+
+  The local instances are preferred while at least \p headroomThreshold of their workers
+  are spare (see computeHeadroom()), so that requests do not cross the WAN before the
+  local site nears saturation. Without local or remote instances, there is nothing to prefer.
+ */
+SiteSelection
+selectSite(const std::vector<std::pair<bool, ServiceFunctionInfo>>& instances, double headroomThreshold);
+
+} // namespace nlsr
+
+#endif // NLSR_ROUTE_TRAFFIC_SPLIT_HPP
@@ -0,0 +1,62 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "router-name-interner.hpp"
+
+namespace nlsr {
+
+RouterNameInterner&
+RouterNameInterner::getGlobal()
+{
+  static RouterNameInterner interner;
+  return interner;
+}
+
+RouterId
+RouterNameInterner::intern(const ndn::Name& name)
+{
+  size_t hash = std::hash<ndn::Name>{}(name);
+  auto range = m_ids.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (m_entries[it->second].name == name) {
+      return it->second;
+    }
+  }
+
+  auto id = static_cast<RouterId>(m_entries.size());
+  m_entries.push_back({name, hash});
+  m_ids.emplace(hash, id);
+  return id;
+}
+
+std::optional<RouterId>
+RouterNameInterner::find(const ndn::Name& name) const
+{
+  auto range = m_ids.equal_range(std::hash<ndn::Name>{}(name));
+  for (auto it = range.first; it != range.second; ++it) {
+    if (m_entries[it->second].name == name) {
+      return it->second;
+    }
+  }
+  return std::nullopt;
+}
+
+} // namespace nlsr
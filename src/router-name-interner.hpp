@@ -0,0 +1,103 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_ROUTER_NAME_INTERNER_HPP
+#define NLSR_ROUTER_NAME_INTERNER_HPP
+
+#include "common.hpp"
+
+#include <boost/noncopyable.hpp>
+
+#include <deque>
+#include <optional>
+#include <unordered_map>
+
+namespace nlsr {
+
+/*! \brief Identifies an interned router name.
+ */
+using RouterId = uint32_t;
+
+/*! \brief Assigns a stable 32-bit id to each router name.
+
+  Router names are compared and hashed in many tables. Interning a name hashes it once;
+  afterwards the tables can be keyed by the id, and the name and its hash can be looked up
+  from the id at no cost. Ids are assigned sequentially from zero and are never reused, so
+  an id stays valid, and the reference returned by getName() stays valid, for the lifetime
+  of the interner.
+
+  The interner is not synchronized and may only be used on the main thread. Other threads,
+  such as the sidecar ingestion thread (see SidecarStatsHandler), must not construct Lsa or
+  RoutingTableEntry objects, which intern their router names; a thread that needs to do
+  so must first make intern() synchronized.
+ */
+class RouterNameInterner : boost::noncopyable
+{
+public:
+  /*! \brief Returns the interner shared by the whole process.
+   */
+  static RouterNameInterner&
+  getGlobal();
+
+  /*! \brief Returns the id of \p name, assigning a new one if needed.
+   */
+  RouterId
+  intern(const ndn::Name& name);
+
+  /*! \brief Returns the id of \p name, or std::nullopt if it was never interned.
+   */
+  std::optional<RouterId>
+  find(const ndn::Name& name) const;
+
+  const ndn::Name&
+  getName(RouterId id) const
+  {
+    return m_entries.at(id).name;
+  }
+
+  size_t
+  getHash(RouterId id) const
+  {
+    return m_entries.at(id).hash;
+  }
+
+  size_t
+  size() const
+  {
+    return m_entries.size();
+  }
+
+private:
+  struct Entry
+  {
+    ndn::Name name;
+    size_t hash;
+  };
+
+  // std::deque keeps references to the names valid as it grows
+  std::deque<Entry> m_entries;
+  // hash of the name => id; names are compared only on hash collisions
+  std::unordered_multimap<size_t, RouterId> m_ids;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_ROUTER_NAME_INTERNER_HPP
@@ -56,7 +56,16 @@ enum {
   ProcessingWeight          = 153,
   LoadWeight                = 154,
   UsageWeight               = 155,
-  IsServiceFunction         = 156
+  IsServiceFunction         = 156,
+  ServiceLatencyP50         = 157,
+  ServiceLatencyP95         = 158,
+  ServiceLatencyP99         = 159,
+  LatencyWeight             = 160,
+  WorkerCapacity            = 161,
+  MeanServiceTime           = 162,
+  UtilizationTrend          = 163,
+  MaxConcurrency            = 164,
+  Overloaded                = 165
 };
 
 } // namespace nlsr::tlv
@@ -0,0 +1,171 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "communication/multipath-segment-fetcher.hpp"
+
+#include "tests/io-key-chain-fixture.hpp"
+#include "tests/test-common.hpp"
+
+#include <ndn-cxx/lp/tags.hpp>
+#include <ndn-cxx/security/validator-null.hpp>
+#include <ndn-cxx/util/dummy-client-face.hpp>
+
+namespace nlsr::tests {
+
+class MultipathSegmentFetcherFixture : public IoKeyChainFixture
+{
+public:
+  MultipathSegmentFetcherFixture()
+  {
+    for (uint8_t i = 0; i < 100; ++i) {
+      object.push_back(i);
+    }
+  }
+
+  /*! \brief Answers every pending Interest with the segment it asks for.
+      Each face holds its own version of the object.
+   */
+  void
+  answerInterests(uint64_t nSegments, std::map<uint64_t, size_t>& nSegmentInterestsPerFace)
+  {
+    auto interests = face.sentInterests;
+    face.sentInterests.clear();
+    for (const auto& interest : interests) {
+      auto tag = interest.getTag<ndn::lp::NextHopFaceIdTag>();
+      uint64_t faceId = tag ? tag->get() : 0;
+      uint64_t segNum = 0;
+      if (interest.getName()[-1].isSegment()) {
+        segNum = interest.getName()[-1].toSegment();
+        ++nSegmentInterestsPerFace[faceId];
+      }
+      face.receive(makeSegment(faceId, segNum, nSegments));
+    }
+    advanceClocks(1_ms);
+  }
+
+  ndn::Data
+  makeSegment(uint64_t version, uint64_t segNum, uint64_t nSegments)
+  {
+    size_t segmentSize = (object.size() + nSegments - 1) / nSegments;
+    size_t begin = segNum * segmentSize;
+    size_t end = std::min(object.size(), begin + segmentSize);
+
+    ndn::Data data(ndn::Name(baseName).appendVersion(version).appendSegment(segNum));
+    data.setContent(ndn::make_span(object.data() + begin, end - begin));
+    data.setFinalBlock(ndn::name::Component::fromSegment(nSegments - 1));
+    m_keyChain.sign(data);
+    return data;
+  }
+
+public:
+  ndn::DummyClientFace face{m_io, m_keyChain};
+  ndn::Name baseName{"/localhop/ndn/nlsr/LSA/site/%C1.Router/router/NAME/3"};
+  std::vector<uint8_t> object;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestMultipathSegmentFetcher, MultipathSegmentFetcherFixture)
+
+BOOST_AUTO_TEST_CASE(SpreadOverFaces)
+{
+  MultipathSegmentFetcher::Options options;
+  auto fetcher = MultipathSegmentFetcher::start(face, baseName, 11,
+                                                ndn::security::getAcceptAllValidator(), options);
+  ndn::ConstBufferPtr result;
+  fetcher->onComplete.connect([&] (const ndn::ConstBufferPtr& buffer) { result = buffer; });
+  size_t nErrors = 0;
+  fetcher->onError.connect([&] (uint32_t, const std::string&) { ++nErrors; });
+  size_t nValidated = 0;
+  fetcher->afterSegmentValidated.connect([&] (const ndn::Data&) { ++nValidated; });
+
+  advanceClocks(1_ms);
+  fetcher->addFace(22);
+  // the same face again is ignored
+  fetcher->addFace(11);
+  BOOST_CHECK_EQUAL(fetcher->getNFaces(), 2);
+  advanceClocks(1_ms);
+
+  // only the first face probes before the size is known
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 1);
+
+  std::map<uint64_t, size_t> nSegmentInterestsPerFace;
+  for (int i = 0; i < 20 && result == nullptr; ++i) {
+    answerInterests(10, nSegmentInterestsPerFace);
+  }
+
+  BOOST_REQUIRE(result != nullptr);
+  BOOST_CHECK_EQUAL(nErrors, 0);
+  BOOST_CHECK_EQUAL(nValidated, 10);
+  BOOST_CHECK_EQUAL_COLLECTIONS(result->begin(), result->end(), object.begin(), object.end());
+  BOOST_CHECK_GT(nSegmentInterestsPerFace[11], 0);
+  BOOST_CHECK_GT(nSegmentInterestsPerFace[22], 0);
+}
+
+BOOST_AUTO_TEST_CASE(SmallObjectSinglePath)
+{
+  MultipathSegmentFetcher::Options options;
+  options.minSegmentsForMultipath = 4;
+  auto fetcher = MultipathSegmentFetcher::start(face, baseName, 11,
+                                                ndn::security::getAcceptAllValidator(), options);
+  ndn::ConstBufferPtr result;
+  fetcher->onComplete.connect([&] (const ndn::ConstBufferPtr& buffer) { result = buffer; });
+  fetcher->addFace(22);
+  advanceClocks(1_ms);
+
+  std::map<uint64_t, size_t> nSegmentInterestsPerFace;
+  for (int i = 0; i < 5 && result == nullptr; ++i) {
+    answerInterests(2, nSegmentInterestsPerFace);
+  }
+
+  BOOST_REQUIRE(result != nullptr);
+  BOOST_CHECK_EQUAL(result->size(), object.size());
+  BOOST_CHECK_EQUAL(nSegmentInterestsPerFace[11], 1);
+  BOOST_CHECK_EQUAL(nSegmentInterestsPerFace[22], 0);
+}
+
+BOOST_AUTO_TEST_CASE(FailOverOnTimeout)
+{
+  MultipathSegmentFetcher::Options options;
+  options.interestLifetime = 1_s;
+  auto fetcher = MultipathSegmentFetcher::start(face, baseName, 11,
+                                                ndn::security::getAcceptAllValidator(), options);
+  ndn::ConstBufferPtr result;
+  fetcher->onComplete.connect([&] (const ndn::ConstBufferPtr& buffer) { result = buffer; });
+  uint32_t errorCode = 0;
+  fetcher->onError.connect([&] (uint32_t code, const std::string&) { errorCode = code; });
+  fetcher->addFace(22);
+
+  // the discovery Interest towards face 11 times out, face 22 takes over
+  advanceClocks(10_ms, 150);
+  face.sentInterests.erase(face.sentInterests.begin());
+
+  std::map<uint64_t, size_t> nSegmentInterestsPerFace;
+  for (int i = 0; i < 10 && result == nullptr; ++i) {
+    answerInterests(2, nSegmentInterestsPerFace);
+  }
+
+  BOOST_CHECK(result != nullptr);
+  BOOST_CHECK_EQUAL(errorCode, 0);
+  BOOST_CHECK_EQUAL(nSegmentInterestsPerFace[11], 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
@@ -20,6 +20,7 @@
  */
 
 #include "lsa/adj-lsa.hpp"
+#include "tlv-nlsr.hpp"
 
 #include "tests/boost-test.hpp"
 
@@ -182,6 +183,34 @@ BOOST_AUTO_TEST_CASE(InitializeFromContent)
   BOOST_CHECK_EQUAL(adjlsa1, adjlsa2);
 }
 
+BOOST_AUTO_TEST_CASE(DecodeOnDemand)
+{
+  ndn::Block wire(ADJ_LSA_EXTRA_NEIGHBOR);
+  auto received = std::make_shared<AdjLsa>(wire);
+  BOOST_CHECK(received->wireEncode().data() == wire.data());
+  BOOST_CHECK_EQUAL(received->getAdl().size(), 2);
+
+  received->releaseContent();
+  BOOST_CHECK_EQUAL(std::distance(received->begin(), received->end()), 2);
+
+  AdjLsa known(ndn::Block{ADJ_LSA1});
+  received->setSeqNo(known.getSeqNo() + 1);
+  auto [updated, namesToAdd, namesToRemove] = known.update(received);
+  BOOST_CHECK(updated);
+  BOOST_CHECK_EQUAL(known.getAdl().size(), 2);
+
+  // the updated LSA is backed by the received wire
+  known.releaseContent();
+  BOOST_CHECK_EQUAL(known, *received);
+
+  // adjacencies of an unexpected type are rejected on receipt
+  ndn::Block badWire(ADJ_LSA1);
+  badWire.parse();
+  badWire.push_back(ndn::Block(nlsr::tlv::PrefixInfo));
+  badWire.encode();
+  BOOST_CHECK_THROW(AdjLsa{badWire}, ndn::tlv::Error);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace nlsr::tests
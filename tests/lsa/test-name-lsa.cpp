@@ -21,6 +21,7 @@
 
 #include "lsa/name-lsa.hpp"
 #include "name-prefix-list.hpp"
+#include "tlv-nlsr.hpp"
 
 #include "ndn-cxx/encoding/buffer-stream.hpp"
 
@@ -233,6 +234,151 @@ BOOST_AUTO_TEST_CASE(Update)
   BOOST_CHECK(it != namesToAdd.end());
 }
 
+BOOST_AUTO_TEST_CASE(DecodeOnDemand)
+{
+  NamePrefixList npl{ndn::Name("name1"), ndn::Name("name2")};
+  NameLsa original("router1", 12, ndn::time::system_clock::now() + 1_h, npl);
+  ServiceFunctionInfo sfInfo{};
+  sfInfo.utilization = 0.5;
+  sfInfo.processingWeight = 1.0;
+  original.setServiceFunctionInfo("name1", sfInfo);
+  const ndn::Block& wire = original.wireEncode();
+
+  NameLsa decoded(wire);
+  // the received buffer is re-used rather than encoded again
+  BOOST_CHECK(decoded.wireEncode().data() == wire.data());
+  BOOST_CHECK_EQUAL(decoded.getSeqNo(), 12);
+  BOOST_CHECK_EQUAL(decoded.getNpl(), npl);
+  BOOST_CHECK_EQUAL(decoded.getServiceFunctionInfo("name1").utilization, 0.5);
+
+  // released content is decoded again on the next access
+  decoded.releaseContent();
+  BOOST_CHECK_EQUAL(decoded.getServiceFunctionInfoMapSize(), 1);
+  BOOST_CHECK_EQUAL(decoded, original);
+
+  // a new sequence number keeps the content
+  decoded.releaseContent();
+  decoded.setSeqNo(13);
+  NameLsa reencoded(decoded.wireEncode());
+  BOOST_CHECK_EQUAL(reencoded.getSeqNo(), 13);
+  BOOST_CHECK_EQUAL(reencoded.getNpl(), npl);
+}
+
+BOOST_AUTO_TEST_CASE(UpdateKeepsReceivedWire)
+{
+  NamePrefixList npl{ndn::Name("name1")};
+  NameLsa origin("router1", 1, ndn::time::system_clock::now() + 1_h, npl);
+  ServiceFunctionInfo sfInfo{};
+  sfInfo.utilization = 0.5;
+  origin.setServiceFunctionInfo("name1", sfInfo);
+  NameLsa known(origin.wireEncode());
+
+  // only the Service Function info changes
+  sfInfo.utilization = 0.75;
+  origin.setServiceFunctionInfo("name1", sfInfo);
+  origin.setSeqNo(2);
+  auto received = std::make_shared<NameLsa>(origin.wireEncode());
+  BOOST_CHECK_EQUAL(std::get<0>(known.update(received)), true);
+
+  // the content is backed by the received wire, so it can still be released
+  BOOST_CHECK(known.m_contentWire.hasWire());
+  known.releaseContent();
+  BOOST_CHECK(!known.m_isContentDecoded);
+  BOOST_CHECK_EQUAL(known.getServiceFunctionInfo("name1").utilization, 0.75);
+  BOOST_CHECK_EQUAL(known.getNpl(), npl);
+
+  // Service Function info missing from the received LSA is kept, so the content is encoded again
+  NameLsa withoutSfInfo("router1", 3, ndn::time::system_clock::now() + 1_h, NamePrefixList{ndn::Name("name2")});
+  received = std::make_shared<NameLsa>(withoutSfInfo.wireEncode());
+  BOOST_CHECK_EQUAL(std::get<0>(known.update(received)), true);
+  BOOST_CHECK(!known.m_contentWire.hasWire());
+  BOOST_CHECK_EQUAL(known.getServiceFunctionInfo("name1").utilization, 0.75);
+}
+
+BOOST_AUTO_TEST_CASE(ServiceFunctionInfoRoundTrip)
+{
+  NameLsa original("router1", 1, ndn::time::system_clock::now() + 1_h, NamePrefixList{});
+  ServiceFunctionInfo sfInfo{};
+  sfInfo.utilization = 0.25;
+  sfInfo.load = 0.75;
+  sfInfo.usageCount = 300;
+  original.setServiceFunctionInfo("/func", sfInfo);
+
+  NameLsa decoded(original.wireEncode());
+  BOOST_REQUIRE_EQUAL(decoded.getServiceFunctionInfoMapSize(), 1);
+  auto decodedInfo = decoded.getServiceFunctionInfo("/func");
+  BOOST_CHECK_EQUAL(decodedInfo.utilization, 0.25);
+  BOOST_CHECK_EQUAL(decodedInfo.load, 0.75);
+  BOOST_CHECK_EQUAL(decodedInfo.usageCount, 300);
+  // no latency summary was advertised
+  BOOST_CHECK_EQUAL(decodedInfo.latencyP99, 0);
+
+  sfInfo.latencyP50 = 1200;
+  sfInfo.latencyP95 = 48000;
+  sfInfo.latencyP99 = 250000;
+  sfInfo.latencyWeight = 2.0;
+  original.setServiceFunctionInfo("/func", sfInfo);
+  NameLsa withLatency(original.wireEncode());
+  decodedInfo = withLatency.getServiceFunctionInfo("/func");
+  BOOST_CHECK_EQUAL(decodedInfo.latencyP50, 1200);
+  BOOST_CHECK_EQUAL(decodedInfo.latencyP95, 48000);
+  BOOST_CHECK_EQUAL(decodedInfo.latencyP99, 250000);
+  BOOST_CHECK_EQUAL(decodedInfo.latencyWeight, 2.0);
+  BOOST_CHECK_EQUAL(decodedInfo.meanServiceTime, 0);
+
+  sfInfo.workerCapacity = 4;
+  sfInfo.meanServiceTime = 8000;
+  original.setServiceFunctionInfo("/func", sfInfo);
+  NameLsa withQueueingInputs(original.wireEncode());
+  decodedInfo = withQueueingInputs.getServiceFunctionInfo("/func");
+  BOOST_CHECK_EQUAL(decodedInfo.workerCapacity, 4);
+  BOOST_CHECK_EQUAL(decodedInfo.meanServiceTime, 8000);
+  // without an advertised time, the info dates from its receipt
+  BOOST_CHECK(decodedInfo.lastUpdateTime > ndn::time::system_clock::now() - 1_min);
+  BOOST_CHECK_EQUAL(decodedInfo.utilizationTrend, 0.0);
+
+  auto measured = ndn::time::fromUnixTimestamp(ndn::time::toUnixTimestamp(ndn::time::system_clock::now() - 30_s));
+  sfInfo.lastUpdateTime = measured;
+  sfInfo.utilizationTrend = -0.015;
+  original.setServiceFunctionInfo("/func", sfInfo);
+  NameLsa withForecast(original.wireEncode());
+  decodedInfo = withForecast.getServiceFunctionInfo("/func");
+  BOOST_CHECK(decodedInfo.lastUpdateTime == measured);
+  BOOST_CHECK_EQUAL(decodedInfo.utilizationTrend, -0.015);
+
+  // a time in the future is capped at the receive time
+  sfInfo.lastUpdateTime = ndn::time::system_clock::now() + 1_h;
+  original.setServiceFunctionInfo("/func", sfInfo);
+  NameLsa fromTheFuture(original.wireEncode());
+  decodedInfo = fromTheFuture.getServiceFunctionInfo("/func");
+  BOOST_CHECK(decodedInfo.lastUpdateTime <= ndn::time::system_clock::now());
+  BOOST_CHECK_EQUAL(decodedInfo.maxConcurrency, 0);
+  BOOST_CHECK(!decodedInfo.isOverloaded);
+
+  sfInfo.maxConcurrency = 16;
+  sfInfo.isOverloaded = true;
+  original.setServiceFunctionInfo("/func", sfInfo);
+  NameLsa overloaded(original.wireEncode());
+  decodedInfo = overloaded.getServiceFunctionInfo("/func");
+  BOOST_CHECK_EQUAL(decodedInfo.maxConcurrency, 16);
+  BOOST_CHECK(decodedInfo.isOverloaded);
+}
+
+BOOST_AUTO_TEST_CASE(MalformedContent)
+{
+  NameLsa lsa("router1", 1, ndn::time::system_clock::now(), NamePrefixList{});
+  ndn::Block wire = lsa.wireEncode();
+  wire.parse();
+  // PrefixInfo without a Name
+  wire.push_back(ndn::Block(nlsr::tlv::PrefixInfo));
+  wire.encode();
+
+  NameLsa decoded;
+  BOOST_REQUIRE_NO_THROW(decoded.wireDecode(wire));
+  BOOST_CHECK_THROW(decoded.decodeContent(), ndn::tlv::Error);
+  BOOST_CHECK_EQUAL(decoded.getNpl().size(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace nlsr::tests
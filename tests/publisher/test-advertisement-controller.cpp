@@ -0,0 +1,174 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "publisher/advertisement-controller.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace nlsr::tests {
+
+using Decision = AdvertisementController::Decision;
+
+class AdvertisementControllerFixture
+{
+public:
+  AdvertisementControllerFixture()
+  {
+    options.smoothing = 1.0;
+    options.minInterval = 5_s;
+    options.maxInterval = 60_s;
+  }
+
+  ServiceFunctionInfo
+  makeInfo(double utilization, uint32_t usageCount = 10)
+  {
+    ServiceFunctionInfo info{};
+    info.utilization = utilization;
+    info.usageCount = usageCount;
+    return info;
+  }
+
+  Decision
+  evaluate(AdvertisementController& controller, ServiceFunctionInfo info)
+  {
+    return controller.evaluate(info, now);
+  }
+
+public:
+  AdvertisementController::Options options;
+  ndn::time::steady_clock::time_point now = ndn::time::steady_clock::now();
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestAdvertisementController, AdvertisementControllerFixture)
+
+BOOST_AUTO_TEST_CASE(Thresholds)
+{
+  AdvertisementController controller(options);
+  BOOST_CHECK(evaluate(controller, makeInfo(0.41)) == Decision::ADVERTISE);
+
+  // small changes are suppressed, however long ago the last advertisement was
+  now += 10_s;
+  BOOST_CHECK(evaluate(controller, makeInfo(0.42)) == Decision::SUPPRESS);
+  BOOST_CHECK(evaluate(controller, makeInfo(0.42, 11)) == Decision::SUPPRESS);
+
+  // beyond the absolute threshold
+  BOOST_CHECK(evaluate(controller, makeInfo(0.50)) == Decision::ADVERTISE);
+
+  // beyond the relative threshold of the usage count
+  now += 10_s;
+  BOOST_CHECK(evaluate(controller, makeInfo(0.50, 13)) == Decision::ADVERTISE);
+
+  // dropping to zero
+  now += 10_s;
+  BOOST_CHECK(evaluate(controller, makeInfo(0.0, 0)) == Decision::ADVERTISE);
+
+  BOOST_CHECK_EQUAL(controller.getNAdvertised(), 4);
+  BOOST_CHECK_EQUAL(controller.getNSuppressed(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(WeightDrift)
+{
+  AdvertisementController controller(options);
+  auto info = makeInfo(0.4);
+  info.processingWeight = 0.5;
+  info.loadWeight = 0.3;
+  info.usageWeight = 0.2;
+  BOOST_CHECK(evaluate(controller, info) == Decision::ADVERTISE);
+
+  // learned weights drifting a little are not worth an advertisement
+  for (int i = 1; i <= 5; ++i) {
+    now += 10_s;
+    info.processingWeight += 0.002;
+    info.loadWeight -= 0.002;
+    BOOST_CHECK(evaluate(controller, info) == Decision::SUPPRESS);
+  }
+
+  now += 10_s;
+  info.processingWeight = 0.6;
+  info.loadWeight = 0.2;
+  BOOST_CHECK(evaluate(controller, info) == Decision::ADVERTISE);
+}
+
+BOOST_AUTO_TEST_CASE(Intervals)
+{
+  AdvertisementController controller(options);
+  auto start = now;
+  BOOST_CHECK(evaluate(controller, makeInfo(0.2)) == Decision::ADVERTISE);
+
+  // a significant change within the minimum interval waits for its end
+  now += 1_s;
+  BOOST_CHECK(evaluate(controller, makeInfo(0.8)) == Decision::DEFER);
+  BOOST_CHECK(controller.getNextCheckTime() == start + 5_s);
+  now = start + 5_s;
+  BOOST_CHECK(evaluate(controller, makeInfo(0.8)) == Decision::ADVERTISE);
+
+  // nonzero metrics may decay, so they are checked every minimum interval
+  BOOST_CHECK(controller.getNextCheckTime() == now + 5_s);
+
+  // unchanged info is refreshed at the maximum interval
+  now += 30_s;
+  BOOST_CHECK(evaluate(controller, makeInfo(0.8)) == Decision::SUPPRESS);
+  now = start + 65_s;
+  BOOST_CHECK(evaluate(controller, makeInfo(0.8)) == Decision::ADVERTISE);
+
+  // idle metrics only need the refresh
+  now += 1_s;
+  BOOST_CHECK(evaluate(controller, makeInfo(0.0, 0)) == Decision::DEFER);
+  now += 5_s;
+  BOOST_CHECK(evaluate(controller, makeInfo(0.0, 0)) == Decision::ADVERTISE);
+  BOOST_CHECK(controller.getNextCheckTime() == now + 60_s);
+}
+
+BOOST_AUTO_TEST_CASE(Overload)
+{
+  AdvertisementController controller(options);
+  BOOST_CHECK(evaluate(controller, makeInfo(0.9)) == Decision::ADVERTISE);
+
+  // the overload state bypasses the minimum interval both ways
+  now += 1_s;
+  auto info = makeInfo(0.9);
+  info.isOverloaded = true;
+  BOOST_CHECK(evaluate(controller, info) == Decision::ADVERTISE);
+  now += 1_s;
+  BOOST_CHECK(evaluate(controller, info) == Decision::SUPPRESS);
+  now += 1_s;
+  info.isOverloaded = false;
+  BOOST_CHECK(evaluate(controller, info) == Decision::ADVERTISE);
+}
+
+BOOST_AUTO_TEST_CASE(Smoothing)
+{
+  options.smoothing = 0.5;
+  AdvertisementController controller(options);
+  auto info = makeInfo(0.2, 10);
+  BOOST_CHECK(controller.evaluate(info, now) == Decision::ADVERTISE);
+
+  // a single spike is halved
+  now += 10_s;
+  info = makeInfo(1.0, 30);
+  controller.evaluate(info, now);
+  BOOST_CHECK_CLOSE(info.utilization, 0.6, 0.001);
+  BOOST_CHECK_EQUAL(info.usageCount, 20);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "publisher/function-monitor.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace nlsr::tests {
+
+namespace {
+
+constexpr int64_t BASE = 1762916330000000; // 2025-11-12 02:58:50 UTC
+
+SidecarRecord
+makeRecord(int64_t inTime, int64_t processingTime, uint32_t workers = 0)
+{
+  SidecarRecord record;
+  record.serviceCallInTime = BASE + inTime;
+  record.serviceCallOutTime = BASE + inTime + processingTime;
+  record.workers = workers;
+  return record;
+}
+
+ndn::time::system_clock::time_point
+toTimePoint(int64_t inTime)
+{
+  return ndn::time::system_clock::time_point(ndn::time::microseconds(BASE + inTime));
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(TestFunctionMonitor)
+
+BOOST_AUTO_TEST_CASE(Info)
+{
+  FunctionMonitor monitor("/relay/a", "relay-a", FunctionMonitor::Options{});
+  BOOST_CHECK_EQUAL(monitor.getPrefix(), "/relay/a");
+  BOOST_CHECK_EQUAL(monitor.getCallName(), "relay-a");
+  BOOST_CHECK_EQUAL(monitor.getStats().count("error"), 1);
+
+  monitor.add(makeRecord(0, 100000, 2));
+  monitor.add(makeRecord(250000, 200000, 2));
+  BOOST_CHECK_EQUAL(monitor.getWorkerCapacity(), 2);
+  BOOST_CHECK_EQUAL(monitor.getMaxConcurrency(), 2);
+
+  auto info = monitor.makeServiceFunctionInfo(toTimePoint(500000));
+  BOOST_CHECK_CLOSE(info.utilization, 0.15, 0.001);
+  BOOST_CHECK_EQUAL(info.load, 0.0);
+  BOOST_CHECK_EQUAL(info.usageCount, 2);
+  BOOST_CHECK_EQUAL(info.workerCapacity, 2);
+  BOOST_CHECK_EQUAL(info.meanServiceTime, 150000);
+  BOOST_CHECK(info.lastUpdateTime == toTimePoint(250000));
+  BOOST_CHECK_EQUAL(monitor.getStats().at("worker_capacity"), "2");
+
+  // the function received no request for more than twice the window
+  info = monitor.makeServiceFunctionInfo(toTimePoint(3000000));
+  BOOST_CHECK_EQUAL(info.utilization, 0.0);
+  BOOST_CHECK_EQUAL(info.usageCount, 0);
+  BOOST_CHECK_EQUAL(info.workerCapacity, 0);
+  BOOST_CHECK(info.lastUpdateTime == toTimePoint(250000));
+}
+
+BOOST_AUTO_TEST_CASE(ConfiguredLimits)
+{
+  FunctionMonitor::Options options;
+  options.workerCapacity = 4;
+  options.maxConcurrency = 1;
+  FunctionMonitor monitor("/relay/a", "", options);
+
+  BOOST_CHECK(!monitor.add(makeRecord(0, 100000, 2)));
+  BOOST_CHECK_EQUAL(monitor.getWorkerCapacity(), 4);
+  // a second request arrives while the first one is in flight
+  BOOST_CHECK(monitor.add(makeRecord(50000, 100000, 2)));
+  BOOST_CHECK(monitor.getOverloadDetector().isOverloaded());
+
+  auto info = monitor.update(toTimePoint(200000));
+  BOOST_CHECK_CLOSE(info.utilization, 0.05, 0.001);
+  BOOST_CHECK_EQUAL(info.maxConcurrency, 1);
+  BOOST_CHECK(info.isOverloaded);
+}
+
+BOOST_AUTO_TEST_CASE(WeightLearning)
+{
+  FunctionMonitor::Options options;
+  options.processingWeight = 0.5;
+  options.loadWeight = 0.3;
+  options.usageWeight = 0.2;
+  FunctionMonitor monitor("/relay/a", "", options);
+  BOOST_CHECK(!monitor.getWeightLearner());
+  monitor.add(makeRecord(0, 100000));
+  BOOST_CHECK_EQUAL(monitor.getStats().count("weight_samples"), 0);
+
+  options.weightLearning.emplace();
+  FunctionMonitor learning("/relay/a", "", options);
+  learning.add(makeRecord(0, 100000));
+  auto info = learning.update(toTimePoint(200000));
+  BOOST_REQUIRE(learning.getWeightLearner());
+  BOOST_CHECK_EQUAL(learning.getWeightLearner()->getNSamples(), 1);
+  // too few samples to change the weights
+  BOOST_CHECK_EQUAL(info.processingWeight, 0.5);
+  BOOST_CHECK_EQUAL(info.loadWeight, 0.3);
+  BOOST_CHECK_EQUAL(info.usageWeight, 0.2);
+  BOOST_CHECK_EQUAL(learning.getStats().at("weight_samples"), "1");
+
+  // re-advertising the same window does not feed the learner again
+  auto weights = learning.getWeightLearner()->getWeights();
+  for (int i = 0; i < 10; ++i) {
+    learning.update(toTimePoint(300000 + i * 10000));
+  }
+  BOOST_CHECK_EQUAL(learning.getWeightLearner()->getNSamples(), 1);
+  BOOST_CHECK_EQUAL(learning.getWeightLearner()->getWeights().processing, weights.processing);
+  BOOST_CHECK_EQUAL(learning.getWeightLearner()->getWeights().load, weights.load);
+  BOOST_CHECK_EQUAL(learning.getWeightLearner()->getWeights().usage, weights.usage);
+
+  learning.add(makeRecord(400000, 100000));
+  learning.update(toTimePoint(600000));
+  BOOST_CHECK_EQUAL(learning.getWeightLearner()->getNSamples(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
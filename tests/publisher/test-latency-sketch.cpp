@@ -0,0 +1,84 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "publisher/latency-sketch.hpp"
+
+#include "tests/boost-test.hpp"
+
+#include <cmath>
+
+namespace nlsr::tests {
+
+BOOST_AUTO_TEST_SUITE(TestLatencySketch)
+
+BOOST_AUTO_TEST_CASE(Quantiles)
+{
+  LatencySketch sketch;
+  BOOST_CHECK(sketch.empty());
+  BOOST_CHECK_EQUAL(sketch.getQuantile(0.99), 0);
+
+  // small values are exact
+  for (int64_t value = 1; value <= 20; ++value) {
+    sketch.record(value);
+  }
+  sketch.record(-5);
+  BOOST_CHECK_EQUAL(sketch.getCount(), 20);
+  BOOST_CHECK_EQUAL(sketch.getQuantile(0.0), 1);
+  BOOST_CHECK_EQUAL(sketch.getQuantile(0.5), 10);
+  BOOST_CHECK_EQUAL(sketch.getQuantile(0.95), 19);
+  BOOST_CHECK_EQUAL(sketch.getQuantile(1.0), 20);
+
+  // larger values are within the relative error
+  sketch.clear();
+  for (int64_t value = 1000; value <= 100000; value += 1000) {
+    sketch.record(value);
+  }
+  BOOST_CHECK_CLOSE(static_cast<double>(sketch.getQuantile(0.5)), 50000.0, 3.2);
+  BOOST_CHECK_CLOSE(static_cast<double>(sketch.getQuantile(0.99)), 99000.0, 3.2);
+  BOOST_CHECK_CLOSE(static_cast<double>(sketch.getQuantile(1.0)), 100000.0, 3.2);
+  sketch.record(int64_t(1) << 40);
+  BOOST_CHECK_CLOSE(static_cast<double>(sketch.getQuantile(1.0)), std::ldexp(1.0, 40), 3.2);
+}
+
+BOOST_AUTO_TEST_CASE(MergeSubtract)
+{
+  LatencySketch fast;
+  LatencySketch slow;
+  for (int i = 0; i < 90; ++i) {
+    fast.record(1000);
+  }
+  slow.record(500000, 10);
+
+  LatencySketch total;
+  total.merge(fast);
+  total.merge(slow);
+  BOOST_CHECK_EQUAL(total.getCount(), 100);
+  BOOST_CHECK_CLOSE(static_cast<double>(total.getQuantile(0.5)), 1000.0, 3.2);
+  BOOST_CHECK_CLOSE(static_cast<double>(total.getQuantile(0.95)), 500000.0, 3.2);
+
+  total.subtract(slow);
+  BOOST_CHECK_EQUAL(total.getCount(), 90);
+  BOOST_CHECK_CLOSE(static_cast<double>(total.getQuantile(0.99)), 1000.0, 3.2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
@@ -0,0 +1,80 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "publisher/latest-value-slot.hpp"
+
+#include "tests/boost-test.hpp"
+
+#include <thread>
+
+namespace nlsr::tests {
+
+BOOST_AUTO_TEST_SUITE(TestLatestValueSlot)
+
+BOOST_AUTO_TEST_CASE(LatestWins)
+{
+  LatestValueSlot<int> slot;
+  BOOST_CHECK(slot.take() == nullptr);
+
+  // only the first put into an empty slot asks for a wakeup
+  BOOST_CHECK_EQUAL(slot.put(std::make_unique<int>(1)), true);
+  BOOST_CHECK_EQUAL(slot.put(std::make_unique<int>(2)), false);
+  auto value = slot.take();
+  BOOST_REQUIRE(value != nullptr);
+  BOOST_CHECK_EQUAL(*value, 2);
+  BOOST_CHECK(slot.take() == nullptr);
+
+  BOOST_CHECK_EQUAL(slot.put(std::make_unique<int>(3)), true);
+}
+
+BOOST_AUTO_TEST_CASE(AcrossThreads)
+{
+  LatestValueSlot<int> slot;
+  const int nValues = 100000;
+  std::atomic<int> nWakeups{0};
+  std::thread producer([&] {
+    for (int i = 1; i <= nValues; ++i) {
+      if (slot.put(std::make_unique<int>(i))) {
+        ++nWakeups;
+      }
+    }
+  });
+
+  // values are taken in increasing order, and the last one is never lost
+  int last = 0;
+  int nTaken = 0;
+  while (last < nValues) {
+    auto value = slot.take();
+    if (value != nullptr) {
+      BOOST_REQUIRE_GT(*value, last);
+      last = *value;
+      ++nTaken;
+    }
+  }
+  producer.join();
+
+  BOOST_CHECK_EQUAL(nTaken, nWakeups.load());
+  BOOST_CHECK(slot.take() == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
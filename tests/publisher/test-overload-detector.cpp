@@ -0,0 +1,104 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "publisher/overload-detector.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace nlsr::tests {
+
+class OverloadDetectorFixture
+{
+public:
+  static SidecarRecord
+  makeRecord(int64_t arrival, int64_t completion)
+  {
+    SidecarRecord record;
+    record.sidecarInTime = arrival;
+    record.sidecarOutTime = completion;
+    return record;
+  }
+
+public:
+  OverloadDetector detector{OverloadDetector::Options{}};
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestOverloadDetector, OverloadDetectorFixture)
+
+BOOST_AUTO_TEST_CASE(SetAndClear)
+{
+  // two requests served one after the other
+  BOOST_CHECK(!detector.add(makeRecord(1000, 2000), 2));
+  BOOST_CHECK(!detector.add(makeRecord(2000, 3000), 2));
+  BOOST_CHECK_EQUAL(detector.getInFlight(), 1);
+  BOOST_CHECK(!detector.isOverloaded());
+
+  // three requests overlap at 3500; the one that arrived last is logged first
+  BOOST_CHECK(!detector.add(makeRecord(3100, 4000), 2));
+  BOOST_CHECK(!detector.add(makeRecord(3200, 4500), 2));
+  BOOST_CHECK(detector.add(makeRecord(3500, 4200), 2));
+  BOOST_CHECK_EQUAL(detector.getInFlight(), 3);
+  BOOST_CHECK(detector.isOverloaded());
+
+  BOOST_CHECK(!detector.add(makeRecord(4100, 5000), 2));
+  BOOST_CHECK_EQUAL(detector.getInFlight(), 3);
+
+  // 2 in flight is not above the limit, but above 80% of it
+  BOOST_CHECK(!detector.add(makeRecord(4600, 5100), 2));
+  BOOST_CHECK_EQUAL(detector.getInFlight(), 2);
+  BOOST_CHECK(detector.isOverloaded());
+
+  BOOST_CHECK(detector.add(makeRecord(6000, 7000), 2));
+  BOOST_CHECK_EQUAL(detector.getInFlight(), 1);
+  BOOST_CHECK(!detector.isOverloaded());
+}
+
+BOOST_AUTO_TEST_CASE(Expire)
+{
+  BOOST_CHECK(!detector.add(makeRecord(1000, 5000), 1));
+  BOOST_CHECK(detector.add(makeRecord(2000, 6000), 1));
+  BOOST_CHECK(detector.isOverloaded());
+
+  BOOST_CHECK(!detector.expire(6000 + 999999));
+  BOOST_CHECK(detector.isOverloaded());
+  BOOST_CHECK(detector.expire(6000 + 1000000));
+  BOOST_CHECK(!detector.isOverloaded());
+  BOOST_CHECK(!detector.expire(6000 + 2000000));
+}
+
+BOOST_AUTO_TEST_CASE(ProcessingInterval)
+{
+  // without sidecar times, the service call times are used
+  SidecarRecord record;
+  record.serviceCallInTime = 1000;
+  record.serviceCallOutTime = 3000;
+  BOOST_CHECK(!detector.add(record, 1));
+  record.serviceCallInTime = 2000;
+  BOOST_CHECK(detector.add(record, 1));
+
+  // a record without any interval is ignored
+  BOOST_CHECK(!detector.add(SidecarRecord{}, 1));
+  BOOST_CHECK(detector.isOverloaded());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
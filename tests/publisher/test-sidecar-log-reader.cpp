@@ -0,0 +1,138 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "publisher/sidecar-log-reader.hpp"
+
+#include "tests/boost-test.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+namespace nlsr::tests {
+
+class SidecarLogReaderFixture
+{
+public:
+  ~SidecarLogReaderFixture()
+  {
+    std::error_code ec;
+    std::filesystem::remove(logPath, ec); // ignore error
+    std::filesystem::remove(rotatedPath, ec);
+  }
+
+  void
+  append(const std::string& text, const std::string& path)
+  {
+    std::ofstream(path, std::ios::app) << text;
+  }
+
+  std::vector<std::string>
+  readNewLines()
+  {
+    std::vector<std::string> lines;
+    reader.readNewLines([&] (std::string_view line) { lines.emplace_back(line); });
+    return lines;
+  }
+
+public:
+  std::string logPath{"/tmp/nlsr-sidecar-test.log"};
+  std::string rotatedPath{"/tmp/nlsr-sidecar-test.log.1"};
+  SidecarLogReader reader{logPath};
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestSidecarLogReader, SidecarLogReaderFixture)
+
+BOOST_AUTO_TEST_CASE(Append)
+{
+  // missing file
+  BOOST_CHECK(readNewLines().empty());
+
+  append("line1\nline2\npart", logPath);
+  auto lines = readNewLines();
+  BOOST_REQUIRE_EQUAL(lines.size(), 2);
+  BOOST_CHECK_EQUAL(lines[0], "line1");
+  BOOST_CHECK_EQUAL(lines[1], "line2");
+  BOOST_CHECK(readNewLines().empty());
+
+  // the partial line is completed by the next append
+  append("ial\nline4\n", logPath);
+  lines = readNewLines();
+  BOOST_REQUIRE_EQUAL(lines.size(), 2);
+  BOOST_CHECK_EQUAL(lines[0], "partial");
+  BOOST_CHECK_EQUAL(lines[1], "line4");
+  BOOST_CHECK_EQUAL(reader.getOffset(), 26);
+}
+
+BOOST_AUTO_TEST_CASE(Truncate)
+{
+  append("line1\nline2\n", logPath);
+  BOOST_CHECK_EQUAL(readNewLines().size(), 2);
+
+  std::ofstream(logPath, std::ios::trunc) << "new\n";
+  auto lines = readNewLines();
+  BOOST_REQUIRE_EQUAL(lines.size(), 1);
+  BOOST_CHECK_EQUAL(lines[0], "new");
+  BOOST_CHECK_EQUAL(reader.getOffset(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(LongLine)
+{
+  append("line1\n" + std::string(SidecarLogReader::MAX_LINE_LENGTH + 1, 'x'), logPath);
+  auto lines = readNewLines();
+  BOOST_REQUIRE_EQUAL(lines.size(), 1);
+  BOOST_CHECK_EQUAL(lines[0], "line1");
+
+  // the tail of the dropped line is discarded along with it
+  append("tail\nline2\n", logPath);
+  lines = readNewLines();
+  BOOST_REQUIRE_EQUAL(lines.size(), 1);
+  BOOST_CHECK_EQUAL(lines[0], "line2");
+}
+
+BOOST_AUTO_TEST_CASE(Rotate)
+{
+  append("line1\n", logPath);
+  BOOST_CHECK_EQUAL(readNewLines().size(), 1);
+
+  // a line written just before the rotation is still read from the old file
+  append("line2\n", logPath);
+  std::filesystem::rename(logPath, rotatedPath);
+  append("line3\n", logPath);
+
+  auto lines = readNewLines();
+  BOOST_REQUIRE_EQUAL(lines.size(), 2);
+  BOOST_CHECK_EQUAL(lines[0], "line2");
+  BOOST_CHECK_EQUAL(lines[1], "line3");
+  BOOST_CHECK_EQUAL(reader.getOffset(), 6);
+
+  // the log file disappears and comes back
+  std::filesystem::remove(logPath);
+  BOOST_CHECK(readNewLines().empty());
+  append("line4\n", logPath);
+  lines = readNewLines();
+  BOOST_REQUIRE_EQUAL(lines.size(), 1);
+  BOOST_CHECK_EQUAL(lines[0], "line4");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
@@ -0,0 +1,122 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "publisher/sidecar-log-watcher.hpp"
+
+#include "tests/boost-test.hpp"
+#include "tests/io-fixture.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+namespace nlsr::tests {
+
+class SidecarLogWatcherFixture : public IoFixture
+{
+public:
+  SidecarLogWatcherFixture()
+  {
+    std::filesystem::create_directories(dirPath);
+  }
+
+  ~SidecarLogWatcherFixture() override
+  {
+    std::error_code ec;
+    std::filesystem::remove_all(dirPath, ec); // ignore error
+  }
+
+  std::unique_ptr<SidecarLogWatcher>
+  makeWatcher(const SidecarLogWatcher::Options& options)
+  {
+    return std::make_unique<SidecarLogWatcher>(m_io, scheduler, logPath, options,
+                                               [this] { ++nChanges; });
+  }
+
+  void
+  append(const std::string& text)
+  {
+    std::ofstream(logPath, std::ios::app) << text;
+  }
+
+public:
+  std::string dirPath{"/tmp/nlsr-sidecar-watcher-test"};
+  std::string logPath{dirPath + "/service.log"};
+  ndn::Scheduler scheduler{m_io};
+  size_t nChanges = 0;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestSidecarLogWatcher, SidecarLogWatcherFixture)
+
+BOOST_AUTO_TEST_CASE(AppendAndRotate)
+{
+  SidecarLogWatcher::Options options;
+  options.minUpdateInterval = 500_ms;
+  auto watcher = makeWatcher(options);
+  watcher->start();
+  BOOST_REQUIRE(watcher->isEventDriven());
+
+  append("line1\n");
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(nChanges, 1);
+
+  // changes within the minimum update interval are coalesced
+  append("line2\n");
+  advanceClocks(10_ms);
+  append("line3\n");
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(nChanges, 1);
+  advanceClocks(10_ms, 50);
+  BOOST_CHECK_EQUAL(nChanges, 2);
+
+  // truncation
+  std::ofstream(logPath, std::ios::trunc) << "new\n";
+  advanceClocks(10_ms, 60);
+  BOOST_CHECK_EQUAL(nChanges, 3);
+
+  // rotation
+  std::filesystem::rename(logPath, logPath + ".1");
+  append("line4\n");
+  advanceClocks(10_ms, 60);
+  BOOST_CHECK_EQUAL(nChanges, 4);
+
+  // other files in the directory are ignored
+  std::ofstream(dirPath + "/other.log") << "other\n";
+  advanceClocks(10_ms, 60);
+  BOOST_CHECK_EQUAL(nChanges, 4);
+}
+
+BOOST_AUTO_TEST_CASE(PollingFallback)
+{
+  SidecarLogWatcher::Options options;
+  options.pollInterval = 1_s;
+  options.useInotify = false;
+  auto watcher = makeWatcher(options);
+  watcher->start();
+  BOOST_CHECK(!watcher->isEventDriven());
+
+  advanceClocks(100_ms, 25);
+  BOOST_CHECK_EQUAL(nChanges, 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
@@ -0,0 +1,165 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "publisher/sidecar-record.hpp"
+
+#include "tests/boost-test.hpp"
+
+#include <cstdlib>
+#include <ctime>
+
+namespace nlsr::tests {
+
+namespace {
+
+/*! \brief Sets the local time zone for the lifetime of the object.
+ */
+class TimeZoneGuard
+{
+public:
+  explicit
+  TimeZoneGuard(const char* timeZone)
+  {
+    const char* previous = std::getenv("TZ");
+    if (previous != nullptr) {
+      m_previous = previous;
+    }
+    ::setenv("TZ", timeZone, 1);
+    ::tzset();
+  }
+
+  ~TimeZoneGuard()
+  {
+    if (m_previous) {
+      ::setenv("TZ", m_previous->c_str(), 1);
+    }
+    else {
+      ::unsetenv("TZ");
+    }
+    ::tzset();
+  }
+
+private:
+  std::optional<std::string> m_previous;
+};
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(TestSidecarRecord)
+
+BOOST_AUTO_TEST_CASE(Timestamp)
+{
+  BOOST_CHECK_EQUAL(parseSidecarTimestamp("2025-11-12 02:58:50.676086").value_or(0), 1762916330676086);
+  BOOST_CHECK_EQUAL(parseSidecarTimestamp("2024-02-29 23:59:59.5").value_or(0), 1709251199500000);
+  BOOST_CHECK_EQUAL(parseSidecarTimestamp("1970-01-01 00:00:01").value_or(0), 1000000);
+
+  BOOST_CHECK(!parseSidecarTimestamp("2023-02-29 23:59:59"));
+  BOOST_CHECK(!parseSidecarTimestamp("2025-11-12 24:00:00"));
+  BOOST_CHECK(!parseSidecarTimestamp("2025-11-12 02:58:5x"));
+  BOOST_CHECK(!parseSidecarTimestamp("2025-11-12 02:58:50."));
+  BOOST_CHECK(!parseSidecarTimestamp("2025/11/12"));
+
+  BOOST_CHECK_EQUAL(formatSidecarTimestamp(1762916330676086), "2025-11-12 02:58:50.676086");
+  BOOST_CHECK_EQUAL(formatSidecarTimestamp(0), "1970-01-01 00:00:00.000000");
+}
+
+BOOST_AUTO_TEST_CASE(LocalTimestamp)
+{
+  // west of UTC, with daylight saving time
+  {
+    TimeZoneGuard guard("EST5EDT,M3.2.0,M11.1.0");
+    BOOST_CHECK_EQUAL(parseSidecarTimestamp("2025-11-11 21:58:50.676086", SidecarTimeZone::LOCAL).value_or(0),
+                      1762916330676086);
+    BOOST_CHECK_EQUAL(parseSidecarTimestamp("2025-07-01 12:00:00", SidecarTimeZone::LOCAL).value_or(0),
+                      1751385600000000);
+    // UTC timestamps do not depend on the local time zone
+    BOOST_CHECK_EQUAL(parseSidecarTimestamp("2025-11-12 02:58:50.676086", SidecarTimeZone::UTC).value_or(0),
+                      1762916330676086);
+  }
+
+  // east of UTC, with a half-hour offset
+  TimeZoneGuard guard("IST-5:30");
+  auto record = parseSidecarRecord(R"({"sidecar": {"in_time": "2025-03-01 05:30:00", )"
+                                   R"("out_time": "2025-03-01 05:30:00.2"}})", SidecarTimeZone::LOCAL);
+  BOOST_REQUIRE(record);
+  BOOST_CHECK_EQUAL(record->sidecarInTime, 1740787200000000);
+  BOOST_CHECK_EQUAL(record->getProcessingTime(), 200000);
+}
+
+BOOST_AUTO_TEST_CASE(Parse)
+{
+  auto record = parseSidecarRecord(R"(  {"service_call": {"call_name": "f\"1", )"
+    R"("in_time": "2025-11-12 02:58:50.676086", "out_time": "2025-11-12 02:58:50.776086", )"
+    R"("port_num": 5000, "in_datasize": 1024, "out_datasize": "512"}, )"
+    R"("sidecar": {"in_time": "2025-11-12 02:58:50.600000", "out_time": "2025-11-12 02:58:50.800000", )"
+    R"("workers": 8}, )"
+    R"("sfc_time": "2025-11-12 02:58:50.500000", "host_name": "h1", )"
+    R"("extra": {"in_time": "2030-01-01 00:00:00"}}  )");
+  BOOST_REQUIRE(record);
+  BOOST_CHECK_EQUAL(record->serviceCallInTime, 1762916330676086);
+  BOOST_CHECK_EQUAL(record->serviceCallOutTime, 1762916330776086);
+  BOOST_CHECK_EQUAL(record->sidecarInTime, 1762916330600000);
+  BOOST_CHECK_EQUAL(record->sidecarOutTime, 1762916330800000);
+  BOOST_CHECK_EQUAL(record->sfcTime, 1762916330500000);
+  BOOST_CHECK_EQUAL(record->inDataSize, 1024);
+  BOOST_CHECK_EQUAL(record->outDataSize, 512);
+  BOOST_CHECK_EQUAL(record->workers, 8);
+  BOOST_CHECK_EQUAL(record->callName, "f\"1");
+  BOOST_CHECK_EQUAL(record->getTimestamp(), record->serviceCallInTime);
+  BOOST_CHECK_EQUAL(record->getProcessingTime(), 100000);
+  BOOST_CHECK_EQUAL(record->getQueueingDelay().value_or(-1), 76086);
+  BOOST_CHECK_EQUAL(record->getSidecarOverhead().value_or(-1), 100000);
+
+  // only the sidecar times
+  record = parseSidecarRecord(R"({"sidecar": {"in_time": "2025-11-12 02:58:50.6", )"
+                              R"("out_time": "2025-11-12 02:58:50.8"}})");
+  BOOST_REQUIRE(record);
+  BOOST_CHECK_EQUAL(record->getTimestamp(), 1762916330600000);
+  BOOST_CHECK_EQUAL(record->getProcessingTime(), 200000);
+  BOOST_CHECK(!record->getQueueingDelay());
+  BOOST_CHECK(!record->getSidecarOverhead());
+
+  // escape sequences in the call name
+  record = parseSidecarRecord(R"({"service_call": {"call_name": "a\\b\/c\td\u00e9\ud83d\ude00\x\u12"}})");
+  BOOST_REQUIRE(record);
+  BOOST_CHECK_EQUAL(record->callName, "a\\b/c\td\xc3\xa9\xf0\x9f\x98\x80\\x\\u12");
+}
+
+BOOST_AUTO_TEST_CASE(Malformed)
+{
+  BOOST_CHECK(!parseSidecarRecord(""));
+  BOOST_CHECK(!parseSidecarRecord("not json"));
+  BOOST_CHECK(!parseSidecarRecord("{}"));
+  BOOST_CHECK(!parseSidecarRecord(R"({"call_name": "f1"})"));
+  BOOST_CHECK(!parseSidecarRecord(R"({"service_call": {"in_time": )"));
+
+  // a malformed field is ignored, the others are kept
+  auto record = parseSidecarRecord(R"({"sidecar": {"in_time": "bad", "out_time": "2025-11-12 02:58:50.8"}})");
+  BOOST_REQUIRE(record);
+  BOOST_CHECK_EQUAL(record->sidecarInTime, 0);
+  BOOST_CHECK_EQUAL(record->sidecarOutTime, 1762916330800000);
+  BOOST_CHECK_EQUAL(record->getTimestamp(), 0);
+  BOOST_CHECK_EQUAL(record->getProcessingTime(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
@@ -0,0 +1,111 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "publisher/sidecar-shm-ring.hpp"
+
+#include "tests/boost-test.hpp"
+
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace nlsr::tests {
+
+class SidecarShmRingFixture
+{
+public:
+  ~SidecarShmRingFixture()
+  {
+    SidecarShmRing::unlink(name);
+  }
+
+  SidecarCallRecord
+  makeCallRecord(int64_t inTime)
+  {
+    SidecarCallRecord record{};
+    record.serviceCallInTime = inTime;
+    record.serviceCallOutTime = inTime + 1000;
+    record.inDataSize = 100;
+    record.workers = 4;
+    return record;
+  }
+
+public:
+  std::string name = "/nlsr-test-ring-" + std::to_string(::getpid());
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestSidecarShmRing, SidecarShmRingFixture)
+
+BOOST_AUTO_TEST_CASE(PushDrain)
+{
+  BOOST_CHECK_THROW(SidecarShmRing::open(name), SidecarShmRing::Error);
+
+  auto producer = SidecarShmRing::create(name, 3);
+  BOOST_CHECK_EQUAL(producer->getCapacity(), 4);
+  auto consumer = SidecarShmRing::open(name);
+  BOOST_CHECK_EQUAL(consumer->getCapacity(), 4);
+
+  std::vector<int64_t> inTimes;
+  auto onRecord = [&] (const SidecarCallRecord& record) { inTimes.push_back(record.serviceCallInTime); };
+  BOOST_CHECK_EQUAL(consumer->drain(onRecord), 0);
+
+  // the fifth record does not fit
+  for (int64_t i = 1; i <= 5; ++i) {
+    BOOST_CHECK_EQUAL(producer->push(makeCallRecord(i)), i <= 4);
+  }
+  BOOST_CHECK_EQUAL(consumer->getNDropped(), 1);
+
+  BOOST_CHECK_EQUAL(consumer->drain(onRecord, 3), 3);
+  BOOST_CHECK(producer->push(makeCallRecord(6)));
+  BOOST_CHECK(producer->push(makeCallRecord(7)));
+  BOOST_CHECK_EQUAL(consumer->drain(onRecord), 3);
+  std::vector<int64_t> expected{1, 2, 3, 4, 6, 7};
+  BOOST_CHECK_EQUAL_COLLECTIONS(inTimes.begin(), inTimes.end(), expected.begin(), expected.end());
+
+  SidecarRecord record = makeCallRecord(10).toRecord();
+  BOOST_CHECK_EQUAL(record.getProcessingTime(), 1000);
+  BOOST_CHECK_EQUAL(record.workers, 4);
+  BOOST_CHECK_EQUAL(SidecarCallRecord::fromRecord(record).inDataSize, 100);
+  BOOST_CHECK_EQUAL(SidecarCallRecord::fromRecord(record).callNameHash, 0);
+  record.callName = "relay";
+  BOOST_CHECK_EQUAL(SidecarCallRecord::fromRecord(record).callNameHash, SidecarCallRecord::hashCallName("relay"));
+  BOOST_CHECK_NE(SidecarCallRecord::hashCallName("relay"), 0);
+  BOOST_CHECK_NE(SidecarCallRecord::hashCallName("relay"), SidecarCallRecord::hashCallName("relay2"));
+
+  BOOST_CHECK(!consumer->isClosed());
+  producer->close();
+  BOOST_CHECK(consumer->isClosed());
+}
+
+BOOST_AUTO_TEST_CASE(NotARing)
+{
+  int fd = ::shm_open(name.data(), O_RDWR | O_CREAT, 0600);
+  BOOST_REQUIRE_GE(fd, 0);
+  BOOST_REQUIRE_EQUAL(::ftruncate(fd, 4096), 0);
+  ::close(fd);
+  BOOST_CHECK_THROW(SidecarShmRing::open(name), SidecarShmRing::Error);
+
+  BOOST_CHECK_THROW(SidecarShmRing::create(name, 0), SidecarShmRing::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
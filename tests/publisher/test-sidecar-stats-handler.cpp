@@ -0,0 +1,137 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "publisher/sidecar-stats-handler.hpp"
+
+#include "tests/publisher/publisher-fixture.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+
+namespace nlsr::tests {
+
+class SidecarStatsHandlerFixture : public PublisherFixture
+{
+public:
+  SidecarStatsHandlerFixture()
+    : handler(*nlsr.m_sidecarStatsHandler)
+  {
+  }
+
+  std::string
+  requestDataset(const ndn::Name& name)
+  {
+    face.receive(ndn::Interest(name).setCanBePrefix(true));
+    advanceClocks(30_ms);
+
+    BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+    ndn::Block parser(face.sentData[0].getContent());
+    face.sentData.clear();
+    parser.parse();
+    BOOST_REQUIRE_EQUAL(parser.elements_size(), 1);
+    return ndn::encoding::readString(parser.elements().front());
+  }
+
+public:
+  SidecarStatsHandler& handler;
+  const ndn::Name statsName{"/localhost/nlsr/sidecar-stats"};
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestSidecarStatsHandler, SidecarStatsHandlerFixture)
+
+BOOST_AUTO_TEST_CASE(CachedDataset)
+{
+  auto first = requestDataset(statsName);
+  uint64_t version = handler.m_sidecarStatsCache.version;
+  BOOST_CHECK_EQUAL(version, handler.m_statsVersion);
+
+  // nothing changed, the cached content is served
+  BOOST_CHECK_EQUAL(requestDataset(statsName), first);
+  BOOST_CHECK_EQUAL(handler.m_sidecarStatsCache.version, version);
+
+  SidecarRecord record;
+  record.serviceCallInTime = 1762916330000000;
+  record.serviceCallOutTime = record.serviceCallInTime + 2000;
+  handler.addRecord(record);
+  advanceClocks(1_s);
+
+  auto second = requestDataset(statsName);
+  BOOST_CHECK_NE(second, first);
+  BOOST_CHECK_GT(handler.m_sidecarStatsCache.version, version);
+
+  // the other datasets have their own cache
+  BOOST_CHECK_EQUAL(handler.m_serviceStatsCache.version, 0);
+  requestDataset("/localhost/nlsr/service-stats");
+  BOOST_CHECK_EQUAL(handler.m_serviceStatsCache.version, handler.m_statsVersion);
+}
+
+BOOST_AUTO_TEST_CASE(ShmRecordsByCallName)
+{
+  conf.addServiceFunctionSource({"/relay/a", "", "a"});
+  conf.addServiceFunctionSource({"/relay/b", "", "b"});
+  ndn::mgmt::Dispatcher dispatcher(face, m_keyChain);
+  SidecarStatsHandler keyed(dispatcher, lsdb, conf, "");
+  BOOST_REQUIRE_EQUAL(keyed.m_functions.size(), 2);
+
+  SidecarRecord record;
+  record.serviceCallInTime = 1762916330000000;
+  record.serviceCallOutTime = record.serviceCallInTime + 2000;
+  record.callName = "b";
+  BOOST_CHECK(keyed.addRecord(SidecarCallRecord::fromRecord(record)));
+  BOOST_CHECK_EQUAL(keyed.m_functions[0]->getWindow().getNRequests(), 0);
+  BOOST_CHECK_EQUAL(keyed.m_functions[1]->getWindow().getNRequests(), 1);
+
+  // no function takes the records of other calls
+  record.callName = "c";
+  BOOST_CHECK(!keyed.addRecord(SidecarCallRecord::fromRecord(record)));
+  record.callName = "";
+  BOOST_CHECK(!keyed.addRecord(SidecarCallRecord::fromRecord(record)));
+  BOOST_CHECK_EQUAL(keyed.m_nNewRecords, 1);
+}
+
+BOOST_AUTO_TEST_CASE(AdvertiseSnapshot)
+{
+  const ndn::Name& prefix = handler.m_functions.front()->getPrefix();
+  SidecarStatsHandler::StatsSnapshot snapshot;
+  snapshot.isSample = true;
+  snapshot.functions.emplace_back();
+  snapshot.functions.back().prefix = prefix;
+  snapshot.functions.back().info.utilization = 0.4;
+  snapshot.functions.back().info.usageCount = 7;
+
+  auto nameLsa = lsdb.findLsa<NameLsa>(conf.getRouterPrefix());
+  BOOST_REQUIRE(nameLsa);
+  uint64_t seqNo = nameLsa->getSeqNo();
+  handler.advertise(snapshot);
+
+  nameLsa = lsdb.findLsa<NameLsa>(conf.getRouterPrefix());
+  BOOST_REQUIRE(nameLsa);
+  BOOST_CHECK_GT(nameLsa->getSeqNo(), seqNo);
+  auto info = nameLsa->getServiceFunctionInfo(prefix);
+  BOOST_CHECK_EQUAL(info.utilization, 0.4);
+  BOOST_CHECK_EQUAL(info.usageCount, 7);
+  // the snapshot is shared with the datasets and stays as sampled
+  BOOST_CHECK_EQUAL(snapshot.functions.back().info.utilization, 0.4);
+  BOOST_CHECK_EQUAL(handler.m_advertisers.at(prefix).getNAdvertised(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
@@ -0,0 +1,161 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "publisher/sidecar-stats-window.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace nlsr::tests {
+
+namespace {
+
+constexpr int64_t BASE = 1762916330000000; // 2025-11-12 02:58:50 UTC
+
+SidecarRecord
+makeRecord(int64_t inTime, int64_t processingTime, uint64_t nBytes = 0)
+{
+  SidecarRecord record;
+  record.serviceCallInTime = BASE + inTime;
+  record.serviceCallOutTime = BASE + inTime + processingTime;
+  record.inDataSize = nBytes;
+  return record;
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(TestSidecarStatsWindow)
+
+BOOST_AUTO_TEST_CASE(Totals)
+{
+  SidecarStatsWindow window(1000000);
+  BOOST_CHECK_EQUAL(window.getWindowLength(), 1000000);
+  BOOST_CHECK_EQUAL(window.getUtilization(), 0.0);
+
+  window.add(makeRecord(0, 100000, 1000));
+  window.add(makeRecord(250000, 200000, 500));
+  BOOST_CHECK_EQUAL(window.getNRequests(), 2);
+  BOOST_CHECK_EQUAL(window.getBusyTime(), 300000);
+  BOOST_CHECK_CLOSE(window.getUtilization(), 0.3, 0.001);
+  BOOST_CHECK_CLOSE(window.getRequestRate(), 2.0, 0.001);
+  BOOST_CHECK_CLOSE(window.getThroughput(), 1500.0, 0.001);
+  BOOST_CHECK_EQUAL(window.getLatestTimestamp(), BASE + 250000);
+
+  // a record without timestamp is ignored
+  window.add(SidecarRecord{});
+  BOOST_CHECK_EQUAL(window.getNRequests(), 2);
+
+  // utilization is capped
+  window.add(makeRecord(300000, 2000000));
+  BOOST_CHECK_EQUAL(window.getUtilization(), 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(Slide)
+{
+  SidecarStatsWindow window(1000000, 100000);
+  window.add(makeRecord(0, 100000));
+  window.add(makeRecord(500000, 100000));
+  BOOST_CHECK_EQUAL(window.getNRequests(), 2);
+
+  // the bucket of the first record leaves the window
+  window.add(makeRecord(1050000, 100000));
+  BOOST_CHECK_EQUAL(window.getNRequests(), 2);
+  BOOST_CHECK_EQUAL(window.getBusyTime(), 200000);
+
+  // records older than the window are dropped, late ones inside it are counted
+  window.add(makeRecord(10000, 100000));
+  BOOST_CHECK_EQUAL(window.getNRequests(), 2);
+  window.add(makeRecord(900000, 100000));
+  BOOST_CHECK_EQUAL(window.getNRequests(), 3);
+  BOOST_CHECK_EQUAL(window.getLatestTimestamp(), BASE + 1050000);
+
+  // a gap longer than the window empties it
+  window.add(makeRecord(5000000, 50000));
+  BOOST_CHECK_EQUAL(window.getNRequests(), 1);
+  BOOST_CHECK_EQUAL(window.getBusyTime(), 50000);
+}
+
+BOOST_AUTO_TEST_CASE(Concurrency)
+{
+  SidecarStatsWindow window(1000000);
+
+  // two overlapping requests: 400 ms with one in flight, 200 ms with two
+  window.add(makeRecord(0, 500000));
+  window.add(makeRecord(300000, 300000));
+  auto occupancy = window.getOccupancy(1);
+  BOOST_CHECK_CLOSE(occupancy.meanConcurrency, 0.8, 0.001);
+  BOOST_CHECK_CLOSE(occupancy.utilization, 0.6, 0.001);
+
+  // with 8 workers, the function is mostly idle
+  occupancy = window.getOccupancy(8);
+  BOOST_CHECK_CLOSE(occupancy.meanConcurrency, 0.8, 0.001);
+  BOOST_CHECK_CLOSE(occupancy.utilization, 0.1, 0.001);
+
+  // eight parallel requests over the whole window saturate eight workers
+  for (int i = 0; i < 8; ++i) {
+    window.add(makeRecord(600000, 1000000));
+  }
+  occupancy = window.getOccupancy(8);
+  BOOST_CHECK_CLOSE(occupancy.meanConcurrency, 8.0, 0.001);
+  BOOST_CHECK_CLOSE(occupancy.utilization, 1.0, 0.001);
+  BOOST_CHECK_CLOSE(window.getUtilization(1), 1.0, 0.001);
+  BOOST_CHECK_CLOSE(window.getUtilization(16), 0.5, 0.001);
+}
+
+BOOST_AUTO_TEST_CASE(QueueingDelay)
+{
+  SidecarStatsWindow window(1000000, 100000);
+  BOOST_CHECK_EQUAL(window.getMeanQueueingDelay(), 0.0);
+
+  // waited 20 ms and 60 ms in the sidecar
+  auto record = makeRecord(100000, 100000);
+  record.sidecarInTime = record.serviceCallInTime - 20000;
+  window.add(record);
+  record = makeRecord(200000, 300000);
+  record.sidecarInTime = record.serviceCallInTime - 60000;
+  window.add(record);
+  // no sidecar time, the delay is not known
+  window.add(makeRecord(300000, 200000));
+
+  BOOST_CHECK_CLOSE(window.getMeanQueueingDelay(), 40000.0, 0.001);
+  BOOST_CHECK_CLOSE(window.getMeanProcessingTime(), 200000.0, 0.001);
+
+  // the sidecar span covers the queueing delay and 10 ms after the service call
+  record = makeRecord(400000, 100000);
+  record.sidecarInTime = record.serviceCallInTime - 30000;
+  record.sidecarOutTime = record.serviceCallOutTime + 10000;
+  window.add(record);
+  BOOST_CHECK_EQUAL(window.getOverheadSketch().getCount(), 1);
+  BOOST_CHECK_CLOSE(static_cast<double>(window.getOverheadSketch().getQuantile(0.5)), 40000.0, 3.2);
+  BOOST_CHECK_EQUAL(window.getServiceTimeSketch().getCount(), 4);
+
+  // the delays leave the window with their buckets
+  window.add(makeRecord(1250000, 100000));
+  BOOST_CHECK_CLOSE(window.getMeanQueueingDelay(), 30000.0, 0.001);
+  BOOST_CHECK_CLOSE(window.getMeanProcessingTime(), 133333.333, 0.001);
+  BOOST_CHECK_EQUAL(window.getServiceTimeSketch().getCount(), 3);
+  window.add(makeRecord(1450000, 100000));
+  BOOST_CHECK_CLOSE(window.getMeanQueueingDelay(), 0.0, 0.001);
+  BOOST_CHECK(window.getOverheadSketch().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
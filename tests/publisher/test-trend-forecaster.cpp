@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "publisher/trend-forecaster.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace nlsr::tests {
+
+BOOST_AUTO_TEST_SUITE(TestTrendForecaster)
+
+BOOST_AUTO_TEST_CASE(FirstSample)
+{
+  TrendForecaster forecaster(TrendForecaster::Options{});
+  auto start = ndn::time::system_clock::now();
+  forecaster.update(0.4, start);
+  BOOST_CHECK_EQUAL(forecaster.getLevel(), 0.4);
+  BOOST_CHECK_EQUAL(forecaster.getTrend(), 0.0);
+  BOOST_CHECK_EQUAL(forecaster.forecast(10_s), 0.4);
+}
+
+BOOST_AUTO_TEST_CASE(LinearRamp)
+{
+  TrendForecaster forecaster(TrendForecaster::Options{});
+  auto start = ndn::time::system_clock::now();
+  // 0.02 per second, sampled at irregular intervals
+  const int offsets[] = {0, 2, 5, 6, 10, 15, 17, 20, 26, 30, 35, 40};
+  for (int offset : offsets) {
+    forecaster.update(0.1 + 0.02 * offset, start + ndn::time::seconds(offset));
+  }
+  BOOST_CHECK_CLOSE(forecaster.getTrend(), 0.02, 5);
+  BOOST_CHECK_CLOSE(forecaster.forecast(5_s), 0.1 + 0.02 * 45, 5);
+
+  // an old or repeated sample does not move the level
+  double level = forecaster.getLevel();
+  forecaster.update(0.0, start + 40_s);
+  forecaster.update(0.0, start + 1_s);
+  BOOST_CHECK_EQUAL(forecaster.getLevel(), level);
+}
+
+BOOST_AUTO_TEST_CASE(IdleDecay)
+{
+  TrendForecaster forecaster(TrendForecaster::Options{});
+  auto start = ndn::time::system_clock::now();
+  for (int i = 0; i <= 10; ++i) {
+    forecaster.update(0.1 + 0.02 * i, start + ndn::time::seconds(i));
+  }
+  double level = forecaster.getLevel();
+  double trend = forecaster.getTrend();
+  BOOST_REQUIRE_GT(trend, 0.01);
+
+  // without a newer sample, the trend fades by the trend smoothing at each interval
+  forecaster.update(0.3, start + 10_s);
+  BOOST_CHECK_CLOSE(forecaster.getTrend(), trend * 0.7, 1e-6);
+  for (int i = 0; i < 30; ++i) {
+    forecaster.update(0.3, start + 10_s);
+  }
+  BOOST_CHECK_SMALL(forecaster.getTrend(), 1e-4);
+  BOOST_CHECK_EQUAL(forecaster.getLevel(), level);
+  BOOST_CHECK_CLOSE(forecaster.forecast(60_s), level, 1);
+}
+
+BOOST_AUTO_TEST_CASE(Steady)
+{
+  TrendForecaster forecaster(TrendForecaster::Options{});
+  auto start = ndn::time::system_clock::now();
+  for (int i = 0; i < 20; ++i) {
+    forecaster.update(0.6, start + ndn::time::seconds(5 * i));
+  }
+  BOOST_CHECK_CLOSE(forecaster.getLevel(), 0.6, 1e-6);
+  BOOST_CHECK_SMALL(forecaster.getTrend(), 1e-9);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
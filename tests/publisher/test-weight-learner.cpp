@@ -0,0 +1,119 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "publisher/weight-learner.hpp"
+
+#include "tests/boost-test.hpp"
+
+#include <cmath>
+
+namespace nlsr::tests {
+
+class WeightLearnerFixture
+{
+public:
+  /*! \brief Returns the sample with index \p i; the inputs vary independently of each other.
+   */
+  static ServiceFunctionInfo
+  makeSample(int i)
+  {
+    ServiceFunctionInfo info;
+    info.utilization = 0.5 + 0.4 * std::sin(i * 0.7);
+    info.load = 0.5 + 0.4 * std::cos(i * 1.3);
+    info.usageCount = static_cast<uint32_t>(50 + 40 * std::sin(i * 2.9));
+    return info;
+  }
+
+  /// the latency depends on the utilization only
+  static double
+  getLatency(const ServiceFunctionInfo& info)
+  {
+    return 0.01 + 0.2 * info.utilization;
+  }
+
+public:
+  WeightLearner::Weights initial{0.4, 0.4, 0.2};
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestWeightLearner, WeightLearnerFixture)
+
+BOOST_AUTO_TEST_CASE(Converge)
+{
+  WeightLearner learner(initial, WeightLearner::Options{});
+  for (int i = 0; i < 9; ++i) {
+    auto info = makeSample(i);
+    learner.update(info, getLatency(info));
+  }
+  // too few samples yet
+  BOOST_CHECK_EQUAL(learner.getWeights().processing, 0.4);
+  BOOST_CHECK_EQUAL(learner.getWeights().load, 0.4);
+  BOOST_CHECK_EQUAL(learner.getWeights().usage, 0.2);
+
+  for (int i = 9; i < 100; ++i) {
+    auto info = makeSample(i);
+    learner.update(info, getLatency(info));
+  }
+  BOOST_CHECK_EQUAL(learner.getNSamples(), 100);
+  // the weights keep their sum and go to the utilization
+  BOOST_CHECK_CLOSE(learner.getWeights().processing, 1.0, 1.0);
+  BOOST_CHECK_SMALL(learner.getWeights().load, 0.01);
+  BOOST_CHECK_SMALL(learner.getWeights().usage, 0.01);
+}
+
+BOOST_AUTO_TEST_CASE(RateLimitAndBounds)
+{
+  WeightLearner::Options options;
+  options.minSamples = 1;
+  options.maxStep = 0.02;
+  options.minWeight = 0.1;
+  options.maxWeight = 0.6;
+  WeightLearner learner(initial, options);
+
+  auto previous = learner.getWeights();
+  for (int i = 0; i < 100; ++i) {
+    auto info = makeSample(i);
+    learner.update(info, getLatency(info));
+    const auto& weights = learner.getWeights();
+    BOOST_CHECK_LE(std::abs(weights.processing - previous.processing), 0.02 + 1e-9);
+    BOOST_CHECK_LE(std::abs(weights.load - previous.load), 0.02 + 1e-9);
+    BOOST_CHECK_LE(std::abs(weights.usage - previous.usage), 0.02 + 1e-9);
+    previous = weights;
+  }
+  BOOST_CHECK_CLOSE(learner.getWeights().processing, 0.6, 1e-6);
+  BOOST_CHECK_CLOSE(learner.getWeights().load, 0.1, 1e-6);
+  BOOST_CHECK_CLOSE(learner.getWeights().usage, 0.1, 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(NoPredictor)
+{
+  WeightLearner learner(initial, WeightLearner::Options{});
+  for (int i = 0; i < 50; ++i) {
+    learner.update(makeSample(i), 0.05);
+  }
+  // a constant latency is explained by the intercept alone
+  BOOST_CHECK_CLOSE(learner.getWeights().processing, 0.4, 1e-6);
+  BOOST_CHECK_CLOSE(learner.getWeights().load, 0.4, 1e-6);
+  BOOST_CHECK_CLOSE(learner.getWeights().usage, 0.2, 1e-6);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
@@ -385,6 +385,40 @@ BOOST_AUTO_TEST_CASE(PrefixWithdrawalFibUpdateBug) // #5179
   BOOST_CHECK_EQUAL(numRegister, 3);
 }
 
+BOOST_AUTO_TEST_CASE(TrafficSplit)
+{
+  fib.setTrafficSplit("/func", {{router1FaceUri, 75}, {router2FaceUri, 25},
+                                {ndn::FaceUri("udp4://10.0.0.99:6363"), 1}});
+  advanceClocks(10_ms);
+
+  BOOST_REQUIRE_EQUAL(interests.size(), 1);
+  const auto& name = interests[0].getName();
+  BOOST_CHECK_EQUAL(name.getPrefix(4), "/localhost/nfd/strategy-choice/set");
+  ndn::nfd::ControlParameters params;
+  params.wireDecode(name.at(4).blockFromValue());
+  BOOST_CHECK_EQUAL(params.getName(), "/func");
+  // the face without a Face ID is left out
+  BOOST_CHECK_EQUAL(params.getStrategy(),
+                    ndn::Name(conf.getLoadBalancingStrategy()).append("1~75").append("2~25"));
+  interests.clear();
+
+  // unchanged weights are not set again
+  fib.setTrafficSplit("/func", {{router1FaceUri, 75}, {router2FaceUri, 25}});
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(interests.size(), 0);
+
+  fib.setTrafficSplit("/func", {{router1FaceUri, 50}, {router2FaceUri, 50}});
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(interests.size(), 1);
+  interests.clear();
+
+  // removing the prefix unsets the strategy
+  fib.remove("/func");
+  advanceClocks(10_ms);
+  BOOST_REQUIRE_EQUAL(interests.size(), 1);
+  BOOST_CHECK_EQUAL(interests[0].getName().getPrefix(4), "/localhost/nfd/strategy-choice/unset");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace nlsr::tests
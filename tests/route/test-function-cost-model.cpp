@@ -0,0 +1,122 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "route/function-cost-model.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace nlsr::tests {
+
+BOOST_AUTO_TEST_SUITE(TestFunctionCostModel)
+
+BOOST_AUTO_TEST_CASE(Linear)
+{
+  ServiceFunctionInfo info{};
+  info.utilization = 0.5;
+  info.load = 0.25;
+  info.usageCount = 200;
+  info.processingWeight = 0.4;
+  info.loadWeight = 0.4;
+  info.usageWeight = 0.2;
+  info.latencyP99 = 100000;
+  info.latencyWeight = 10.0;
+
+  LinearFunctionCostModel model;
+  BOOST_CHECK_CLOSE(model.computeCost(info), 0.2 + 0.1 + 0.4 + 1.0, 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(WaitProbability)
+{
+  // a single worker waits with the probability that it is busy
+  BOOST_CHECK_CLOSE(QueueingFunctionCostModel::computeWaitProbability(1, 0.6), 0.6, 1e-9);
+  // 2 workers at rho 0.5: C = 2 * rho^2 / (1 + rho)
+  BOOST_CHECK_CLOSE(QueueingFunctionCostModel::computeWaitProbability(2, 0.5), 1.0 / 3, 1e-9);
+  BOOST_CHECK_EQUAL(QueueingFunctionCostModel::computeWaitProbability(4, 0.0), 0.0);
+
+  // many workers at moderate utilization rarely wait
+  double p = QueueingFunctionCostModel::computeWaitProbability(200, 0.5);
+  BOOST_CHECK_GE(p, 0.0);
+  BOOST_CHECK_LT(p, 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(SojournTime)
+{
+  // M/M/1: S / (1 - rho)
+  BOOST_CHECK_CLOSE(QueueingFunctionCostModel::computeSojournTime(1, 0.5, 10.0), 20.0, 1e-9);
+  BOOST_CHECK_CLOSE(QueueingFunctionCostModel::computeSojournTime(1, 0.9, 10.0), 100.0, 1e-9);
+  // an idle instance costs its service time
+  BOOST_CHECK_CLOSE(QueueingFunctionCostModel::computeSojournTime(8, 0.0, 10.0), 10.0, 1e-9);
+  // more workers at the same utilization queue less
+  BOOST_CHECK_LT(QueueingFunctionCostModel::computeSojournTime(4, 0.9, 10.0),
+                 QueueingFunctionCostModel::computeSojournTime(1, 0.9, 10.0));
+  // saturation is capped
+  BOOST_CHECK_CLOSE(QueueingFunctionCostModel::computeSojournTime(1, 1.5, 10.0), 1000.0, 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(Queueing)
+{
+  ServiceFunctionInfo info{};
+  info.utilization = 0.5;
+  info.processingWeight = 1.0;
+
+  QueueingFunctionCostModel model(1000.0);
+  // without a mean service time, the linear model applies
+  BOOST_CHECK_CLOSE(model.computeCost(info), 0.5, 1e-9);
+
+  info.workerCapacity = 1;
+  info.meanServiceTime = 4000;
+  BOOST_CHECK_CLOSE(model.computeCost(info), 8.0, 1e-9);
+
+  // latency blows up near saturation while the linear cost barely moves
+  info.utilization = 0.95;
+  BOOST_CHECK_CLOSE(model.computeCost(info), 80.0, 1e-6);
+  BOOST_CHECK_CLOSE(LinearFunctionCostModel().computeCost(info), 0.95, 1e-9);
+
+  // 0 workers is treated as 1
+  info.workerCapacity = 0;
+  BOOST_CHECK_CLOSE(model.computeCost(info), 80.0, 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(Extrapolate)
+{
+  auto now = ndn::time::system_clock::now();
+  ServiceFunctionInfo info{};
+  info.utilization = 0.5;
+  info.lastUpdateTime = now - 4_s;
+
+  // no trend, nothing to extrapolate
+  BOOST_CHECK_EQUAL(extrapolateServiceFunctionInfo(info, now, 10_s).utilization, 0.5);
+
+  info.utilizationTrend = 0.05;
+  BOOST_CHECK_CLOSE(extrapolateServiceFunctionInfo(info, now, 10_s).utilization, 0.7, 1e-6);
+  // limited by the horizon
+  BOOST_CHECK_CLOSE(extrapolateServiceFunctionInfo(info, now, 2_s).utilization, 0.6, 1e-6);
+  BOOST_CHECK_EQUAL(extrapolateServiceFunctionInfo(info, now, 0_s).utilization, 0.5);
+  // and by the range of utilization
+  info.utilizationTrend = 0.5;
+  BOOST_CHECK_EQUAL(extrapolateServiceFunctionInfo(info, now, 10_s).utilization, 1.0);
+  info.utilizationTrend = -0.5;
+  BOOST_CHECK_EQUAL(extrapolateServiceFunctionInfo(info, now, 10_s).utilization, 0.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
@@ -54,6 +54,14 @@ BOOST_AUTO_TEST_CASE(Basic)
   BOOST_CHECK_NE(mn3, *mn1);
   BOOST_CHECK_NE(mn3, *mn2);
   BOOST_CHECK_EQUAL(map1.getRouterNameByMappingNo(mn3).has_value(), false);
+
+  // a router added again keeps its mapping number
+  map1.addEntry(RouterNameInterner::getGlobal().intern(name2));
+  BOOST_CHECK_EQUAL(map1.size(), 2);
+  auto id2 = map1.getRouterIdByMappingNo(*mn2);
+  BOOST_REQUIRE(id2.has_value());
+  BOOST_CHECK_EQUAL(RouterNameInterner::getGlobal().getName(*id2), name2);
+  BOOST_CHECK_EQUAL(map1.getMappingNoByRouterId(*id2).value_or(-1), *mn2);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
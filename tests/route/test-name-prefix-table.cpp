@@ -37,7 +37,8 @@ public:
     : lsdb(face, m_keyChain, conf)
     , fib(face, m_scheduler, conf.getAdjacencyList(), conf, m_keyChain)
     , rt(m_scheduler, lsdb, conf)
-    , npt(conf.getRouterPrefix(), fib, rt, rt.afterRoutingChange, lsdb.onLsdbModified)
+    , npt(conf.getRouterPrefix(), fib, rt, rt.afterRoutingChange, lsdb.onLsdbModified,
+          lsdb, conf, m_scheduler)
   {
   }
 
@@ -63,6 +64,103 @@ public:
   NamePrefixTable npt;
 };
 
+class ServiceFunctionFixture : public NamePrefixTableFixture
+{
+public:
+  /*! \brief Installs the Name LSA of \p router, advertising \p info for functionPrefix.
+   */
+  void
+  installInstance(const ndn::Name& router, const ServiceFunctionInfo& info, uint64_t seqNo = 1)
+  {
+    PrefixInfo prefixInfo(functionPrefix, 0);
+    prefixInfo.setIsServiceFunction(true);
+    NamePrefixList npl;
+    npl.insert(prefixInfo);
+    NameLsa lsa(router, seqNo, time::system_clock::now() + 3600_s, npl);
+    lsa.setServiceFunctionInfo(functionPrefix, info);
+    lsdb.installLsa(std::make_shared<NameLsa>(lsa));
+  }
+
+  ServiceFunctionInfo
+  makeInfo(double utilization, bool isOverloaded = false)
+  {
+    ServiceFunctionInfo info{};
+    info.utilization = utilization;
+    info.usageCount = 10;
+    info.workerCapacity = 4;
+    info.isOverloaded = isOverloaded;
+    info.lastUpdateTime = time::system_clock::now();
+    return info;
+  }
+
+  /*! \brief Installs the Adjacency LSAs of this router, routerA and routerB,
+   *         with this router linked to routerA and routerB at the given costs.
+   */
+  void
+  installAdjacencies(double costA, double costB, uint64_t seqNo = 1)
+  {
+    Adjacent thisRouter(conf.getRouterPrefix(), ndn::FaceUri("udp4://10.0.0.1"), 0,
+                        Adjacent::STATUS_ACTIVE, 0, 0);
+    Adjacent adjacentA(routerA, ndn::FaceUri(faceA), costA, Adjacent::STATUS_ACTIVE, 0, 0);
+    Adjacent adjacentB(routerB, ndn::FaceUri(faceB), costB, Adjacent::STATUS_ACTIVE, 0, 0);
+    auto expiration = time::system_clock::now() + 3600_s;
+
+    AdjacencyList thisAdjacencies;
+    thisAdjacencies.insert(adjacentA);
+    thisAdjacencies.insert(adjacentB);
+    lsdb.installLsa(std::make_shared<AdjLsa>(conf.getRouterPrefix(), seqNo, expiration, thisAdjacencies));
+
+    thisRouter.setLinkCost(costA);
+    AdjacencyList aAdjacencies;
+    aAdjacencies.insert(thisRouter);
+    lsdb.installLsa(std::make_shared<AdjLsa>(routerA, seqNo, expiration, aAdjacencies));
+
+    thisRouter.setLinkCost(costB);
+    AdjacencyList bAdjacencies;
+    bAdjacencies.insert(thisRouter);
+    lsdb.installLsa(std::make_shared<AdjLsa>(routerB, seqNo, expiration, bAdjacencies));
+  }
+
+  void
+  addRoute(const ndn::Name& router, const std::string& faceUri, double cost)
+  {
+    NextHop nextHop(ndn::FaceUri(faceUri), cost);
+    rt.addNextHop(router, nextHop);
+    npt.updateWithNewRoute(rt.m_rTable);
+  }
+
+  /*! \brief Returns the next hops of functionPrefix in the FIB, by face URI.
+   */
+  std::map<std::string, double>
+  getFibNextHops() const
+  {
+    std::map<std::string, double> nextHops;
+    auto it = fib.m_table.find(functionPrefix);
+    if (it != fib.m_table.end()) {
+      for (const auto& nextHop : it->second.nexthopSet.getNextHops()) {
+        nextHops.emplace(nextHop.getConnectingFaceUri().toString(), nextHop.getRouteCost());
+      }
+    }
+    return nextHops;
+  }
+
+  /*! \brief Recomputes the next hops of functionPrefix and returns them, by face URI.
+   */
+  std::map<std::string, double>
+  updateFibNextHops()
+  {
+    npt.updateFibEntry(functionPrefix);
+    return getFibNextHops();
+  }
+
+public:
+  const ndn::Name functionPrefix{"/func/relay"};
+  const ndn::Name routerA{"/ndn/site1/%C1.Router/a"};
+  const ndn::Name routerB{"/ndn/site2/%C1.Router/b"};
+  const std::string faceA{"udp4://10.0.0.2:6363"};
+  const std::string faceB{"udp4://10.0.0.3:6363"};
+};
+
 BOOST_AUTO_TEST_SUITE(TestNamePrefixTable)
 
 BOOST_FIXTURE_TEST_CASE(Bupt, NamePrefixTableFixture)
@@ -128,8 +226,9 @@ BOOST_FIXTURE_TEST_CASE(AddEntryToPool, NamePrefixTableFixture)
 
   npt.addRtpeToPool(rtpe1);
 
+  auto router1 = RouterNameInterner::getGlobal().intern("router1");
   BOOST_CHECK_EQUAL(npt.m_rtpool.size(), 1);
-  BOOST_CHECK_EQUAL(*(npt.m_rtpool.find("router1")->second), rtpe1);
+  BOOST_CHECK_EQUAL(*(npt.m_rtpool.find(router1)->second), rtpe1);
 }
 
 BOOST_FIXTURE_TEST_CASE(RemoveEntryFromPool, NamePrefixTableFixture)
@@ -142,7 +241,7 @@ BOOST_FIXTURE_TEST_CASE(RemoveEntryFromPool, NamePrefixTableFixture)
   npt.deleteRtpeFromPool(rtpePtr);
 
   BOOST_CHECK_EQUAL(npt.m_rtpool.size(), 0);
-  BOOST_CHECK_EQUAL(npt.m_rtpool.count("router1"), 0);
+  BOOST_CHECK_EQUAL(npt.m_rtpool.count(RouterNameInterner::getGlobal().intern("router1")), 0);
 }
 
 BOOST_FIXTURE_TEST_CASE(AddRoutingEntryToNptEntry, NamePrefixTableFixture)
@@ -269,7 +368,7 @@ BOOST_FIXTURE_TEST_CASE(RoutingTableUpdate, NamePrefixTableFixture)
                                    });
   BOOST_REQUIRE(nameIterator != npt.end());
 
-  auto iterator = npt.m_rtpool.find(destination);
+  auto iterator = npt.m_rtpool.find(RouterNameInterner::getGlobal().intern(destination));
   BOOST_REQUIRE(iterator != npt.m_rtpool.end());
   auto nextHops = (iterator->second)->getNexthopList();
   BOOST_CHECK_EQUAL(nextHops.size(), 2);
@@ -284,7 +383,7 @@ BOOST_FIXTURE_TEST_CASE(RoutingTableUpdate, NamePrefixTableFixture)
                                 return entry1.getNamePrefix() == entry->getNamePrefix();
                               });
   BOOST_REQUIRE(nameIterator != npt.end());
-  iterator = npt.m_rtpool.find(destination);
+  iterator = npt.m_rtpool.find(RouterNameInterner::getGlobal().intern(destination));
   BOOST_REQUIRE(iterator != npt.m_rtpool.end());
   nextHops = (iterator->second)->getNexthopList();
   BOOST_CHECK_EQUAL(nextHops.size(), 3);
@@ -352,6 +451,128 @@ BOOST_FIXTURE_TEST_CASE(UpdateFromLsdb, NamePrefixTableFixture)
   BOOST_CHECK_EQUAL(npt.m_table.size(), 0);
 }
 
+BOOST_FIXTURE_TEST_CASE(ShedOverloadedInstance, ServiceFunctionFixture)
+{
+  installInstance(routerA, makeInfo(0.5, true));
+  installInstance(routerB, makeInfo(0.5));
+  addRoute(routerA, faceA, 10);
+  addRoute(routerB, faceB, 20);
+
+  // the overloaded instance is left out at once, however cheaper it is
+  auto nextHops = updateFibNextHops();
+  BOOST_CHECK_EQUAL(nextHops.count(faceA), 0);
+  BOOST_CHECK_EQUAL(nextHops.count(faceB), 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(KeepLastInstance, ServiceFunctionFixture)
+{
+  installInstance(routerA, makeInfo(0.5, true));
+  addRoute(routerA, faceA, 10);
+  BOOST_CHECK_EQUAL(updateFibNextHops().count(faceA), 1);
+
+  // when every instance is overloaded, none of them is shed
+  installInstance(routerB, makeInfo(0.5, true));
+  addRoute(routerB, faceB, 20);
+  auto nextHops = updateFibNextHops();
+  BOOST_CHECK_EQUAL(nextHops.count(faceA), 1);
+  BOOST_CHECK_EQUAL(nextHops.count(faceB), 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(RestoreAfterHoldTime, ServiceFunctionFixture)
+{
+  conf.setOverloadHoldTime(5_s);
+  installInstance(routerA, makeInfo(0.5, true));
+  installInstance(routerB, makeInfo(0.5));
+  addRoute(routerA, faceA, 10);
+  addRoute(routerB, faceB, 20);
+  BOOST_CHECK_EQUAL(updateFibNextHops().count(faceA), 0);
+
+  // the overload ended, but the instance is not used again before the hold time
+  installInstance(routerA, makeInfo(0.5), 2);
+  BOOST_CHECK_EQUAL(updateFibNextHops().count(faceA), 0);
+  advanceClocks(1_s, 4);
+  BOOST_CHECK_EQUAL(updateFibNextHops().count(faceA), 0);
+
+  // the restoration installs the next hop by itself
+  advanceClocks(1_s, 2);
+  BOOST_CHECK_EQUAL(getFibNextHops().count(faceA), 1);
+  BOOST_CHECK_EQUAL(updateFibNextHops().count(faceB), 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(PreferLocalSite, ServiceFunctionFixture)
+{
+  // the instance of the own site is behind a costlier next hop
+  const ndn::Name localRouter("/ndn/site/%C1.Router/local");
+  conf.setSitePreference(true, 0.2);
+  installInstance(localRouter, makeInfo(0.5));
+  installInstance(routerB, makeInfo(0.5));
+  addRoute(localRouter, faceA, 30);
+  addRoute(routerB, faceB, 10);
+
+  auto nextHops = updateFibNextHops();
+  BOOST_REQUIRE_EQUAL(nextHops.size(), 2);
+  BOOST_CHECK_LT(nextHops.at(faceA), nextHops.at(faceB));
+  BOOST_CHECK(npt.getSiteSelections().at(functionPrefix).isLocalPreferred);
+  BOOST_CHECK_EQUAL(npt.getSiteSelections().at(functionPrefix).nLocalInstances, 1);
+  BOOST_CHECK_EQUAL(npt.getSiteSelections().at(functionPrefix).nRemoteInstances, 1);
+
+  // without enough headroom in the own site, the cheaper remote instance wins
+  installInstance(localRouter, makeInfo(0.9), 2);
+  nextHops = updateFibNextHops();
+  BOOST_REQUIRE_EQUAL(nextHops.size(), 2);
+  BOOST_CHECK_GT(nextHops.at(faceA), nextHops.at(faceB));
+  BOOST_CHECK(!npt.getSiteSelections().at(functionPrefix).isLocalPreferred);
+}
+
+BOOST_FIXTURE_TEST_CASE(NoLocalSite, ServiceFunctionFixture)
+{
+  // no instance in the own site: the instances are ranked by cost alone
+  conf.setSitePreference(true, 0.2);
+  installInstance(routerA, makeInfo(0.5));
+  installInstance(routerB, makeInfo(0.5));
+  addRoute(routerA, faceA, 30);
+  addRoute(routerB, faceB, 10);
+
+  auto nextHops = updateFibNextHops();
+  BOOST_REQUIRE_EQUAL(nextHops.size(), 2);
+  BOOST_CHECK_GT(nextHops.at(faceA), nextHops.at(faceB));
+  BOOST_CHECK(!npt.getSiteSelections().at(functionPrefix).isLocalPreferred);
+  BOOST_CHECK_EQUAL(npt.getSiteSelections().at(functionPrefix).nLocalInstances, 0);
+
+  // nor does a local instance change the costs when site preference is disabled
+  const ndn::Name localRouter("/ndn/site/%C1.Router/local");
+  const std::string localFace("udp4://10.0.0.4:6363");
+  conf.setSitePreference(false, 0.2);
+  installInstance(localRouter, makeInfo(0.5));
+  addRoute(localRouter, localFace, 20);
+  nextHops = updateFibNextHops();
+  BOOST_REQUIRE_EQUAL(nextHops.size(), 3);
+  BOOST_CHECK_LT(nextHops.at(faceB), nextHops.at(localFace));
+  BOOST_CHECK_LT(nextHops.at(localFace), nextHops.at(faceA));
+}
+
+BOOST_FIXTURE_TEST_CASE(ChainDetourCost, ServiceFunctionFixture)
+{
+  conf.addServiceFunctionChain("relay", {functionPrefix});
+  installAdjacencies(10, 30);
+  installInstance(routerA, makeInfo(0.5));
+  installInstance(routerB, makeInfo(0.5));
+  addRoute(routerA, faceA, 20);
+  addRoute(routerB, faceB, 20);
+
+  // routerB is 20 farther away than the selected routerA, and its next hop costs that much more
+  auto nextHops = updateFibNextHops();
+  BOOST_REQUIRE_EQUAL(nextHops.size(), 2);
+  BOOST_CHECK_CLOSE(nextHops.at(faceB) - nextHops.at(faceA), 20, 0.001);
+
+  // a changed adjacency LSDB moves the chain to routerB at the next routing table update
+  installAdjacencies(30, 10, 2);
+  npt.updateWithNewRoute(rt.m_rTable);
+  nextHops = updateFibNextHops();
+  BOOST_REQUIRE_EQUAL(nextHops.size(), 2);
+  BOOST_CHECK_CLOSE(nextHops.at(faceA) - nextHops.at(faceB), 20, 0.001);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace nlsr::tests
@@ -0,0 +1,155 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "route/service-function-prober.hpp"
+#include "adjacency-list.hpp"
+
+#include "tests/boost-test.hpp"
+#include "tests/io-key-chain-fixture.hpp"
+
+#include <ndn-cxx/lp/tags.hpp>
+#include <ndn-cxx/util/dummy-client-face.hpp>
+
+namespace nlsr::tests {
+
+class ServiceFunctionProberFixture : public IoKeyChainFixture
+{
+public:
+  ServiceFunctionProberFixture()
+  {
+    adjacencies.insert(Adjacent("/ndn/router1", face1, 0, Adjacent::STATUS_ACTIVE, 0, 11));
+    adjacencies.insert(Adjacent("/ndn/router2", face2, 0, Adjacent::STATUS_ACTIVE, 0, 22));
+    adjacencies.insert(Adjacent("/ndn/router3", face3, 0, Adjacent::STATUS_ACTIVE, 0, 33));
+    options.interval = 10_s;
+    options.maxFacesPerRound = 2;
+    options.interestLifetime = 1_s;
+  }
+
+  /*! \brief Advances the clocks until the first probe round of a new target.
+   */
+  void
+  waitForFirstRound()
+  {
+    for (int i = 0; i < 100 && face.sentInterests.empty(); ++i) {
+      advanceClocks(100_ms);
+    }
+  }
+
+  /*! \brief Answers the pending probes sent to \p faceId with Data after \p delay.
+   */
+  void
+  answerProbes(uint64_t faceId, ndn::time::milliseconds delay)
+  {
+    advanceClocks(delay);
+    auto interests = face.sentInterests;
+    face.sentInterests.clear();
+    for (const auto& interest : interests) {
+      auto tag = interest.getTag<ndn::lp::NextHopFaceIdTag>();
+      if (tag && tag->get() == faceId) {
+        ndn::Data data(interest.getName());
+        m_keyChain.sign(data);
+        face.receive(data);
+      }
+      else {
+        face.sentInterests.push_back(interest);
+      }
+    }
+    advanceClocks(1_ms);
+  }
+
+public:
+  ndn::DummyClientFace face{m_io, m_keyChain};
+  ndn::Scheduler scheduler{m_io};
+  AdjacencyList adjacencies;
+  ServiceFunctionProber::Options options;
+  const ndn::Name prefix{"/func"};
+  const ndn::FaceUri face1{"udp4://10.0.0.1:6363"};
+  const ndn::FaceUri face2{"udp4://10.0.0.2:6363"};
+  const ndn::FaceUri face3{"udp4://10.0.0.3:6363"};
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestServiceFunctionProber, ServiceFunctionProberFixture)
+
+BOOST_AUTO_TEST_CASE(RttAndFailures)
+{
+  ServiceFunctionProber prober(face, scheduler, adjacencies, options);
+  prober.setTargets(prefix, {face1, face2});
+  BOOST_REQUIRE(prober.getMeasurement(prefix, face1) != nullptr);
+  BOOST_CHECK(!prober.getMeasurement(prefix, face1)->srtt);
+  BOOST_CHECK(prober.getMeasurement(prefix, face3) == nullptr);
+
+  // the first round falls within the first interval
+  waitForFirstRound();
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 2);
+  for (const auto& interest : face.sentInterests) {
+    BOOST_CHECK(prefix.isPrefixOf(interest.getName()));
+    BOOST_CHECK_EQUAL(interest.getName().at(prefix.size()), ServiceFunctionProber::PROBE_COMPONENT);
+    BOOST_CHECK(interest.getMustBeFresh());
+  }
+
+  // face 1 answers after 20 ms, face 2 never does
+  answerProbes(11, 20_ms);
+  advanceClocks(100_ms, 2_s);
+  face.sentInterests.clear();
+
+  const auto* m1 = prober.getMeasurement(prefix, face1);
+  BOOST_REQUIRE(m1->srtt);
+  BOOST_CHECK_GE(*m1->srtt, 20_ms);
+  BOOST_CHECK_EQUAL(m1->successRate, 1.0);
+  BOOST_CHECK_EQUAL(m1->nProbes, 1);
+
+  const auto* m2 = prober.getMeasurement(prefix, face2);
+  BOOST_CHECK(!m2->srtt);
+  BOOST_CHECK_LT(m2->successRate, 1.0);
+  BOOST_CHECK_EQUAL(m2->nFailures, 1);
+}
+
+BOOST_AUTO_TEST_CASE(RateLimit)
+{
+  ServiceFunctionProber prober(face, scheduler, adjacencies, options);
+  prober.setTargets(prefix, {face1, face2, face3});
+
+  // at most 2 probes per round, one round per interval, and every face takes its turn
+  std::set<uint64_t> probedFaces;
+  waitForFirstRound();
+  for (int round = 0; round < 3; ++round) {
+    BOOST_CHECK_LE(face.sentInterests.size(), 2);
+    for (const auto& interest : face.sentInterests) {
+      probedFaces.insert(interest.getTag<ndn::lp::NextHopFaceIdTag>()->get());
+    }
+    face.sentInterests.clear();
+    advanceClocks(100_ms, 10_s);
+  }
+  BOOST_CHECK_EQUAL(probedFaces.size(), 3);
+
+  // a removed next hop loses its measurement, a removed prefix is no longer probed
+  prober.setTargets(prefix, {face1});
+  BOOST_CHECK(prober.getMeasurement(prefix, face2) == nullptr);
+  prober.removeTarget(prefix);
+  face.sentInterests.clear();
+  advanceClocks(1_s, 30_s);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 0);
+  BOOST_CHECK(prober.getMeasurement(prefix, face1) == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "route/sfc-chain-optimizer.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace nlsr::tests {
+
+class SfcChainOptimizerFixture
+{
+public:
+  std::optional<double>
+  getDistance(const ndn::Name& from, const ndn::Name& to) const
+  {
+    auto it = distances.find({from, to});
+    if (it == distances.end()) {
+      it = distances.find({to, from});
+    }
+    if (it == distances.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+public:
+  // line topology: /A - /B - /C - /D, 10 per link
+  std::map<std::pair<ndn::Name, ndn::Name>, double> distances{
+    {{"/A", "/B"}, 10}, {{"/A", "/C"}, 20}, {{"/A", "/D"}, 30},
+    {{"/B", "/C"}, 10}, {{"/B", "/D"}, 20}, {{"/C", "/D"}, 10},
+  };
+  ChainDistance distance = [this] (const ndn::Name& from, const ndn::Name& to) {
+    return getDistance(from, to);
+  };
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestSfcChainOptimizer, SfcChainOptimizerFixture)
+
+BOOST_AUTO_TEST_CASE(Empty)
+{
+  BOOST_CHECK(!optimizeChain("/A", {}, distance));
+  BOOST_CHECK(!optimizeChain("/A", {{{"/B", 0}}, {}}, distance));
+}
+
+BOOST_AUTO_TEST_CASE(WholeChain)
+{
+  std::vector<std::vector<ChainCandidate>> stages{
+    {{"/B", 0}, {"/D", 5}},
+    {{"/A", 0}, {"/D", 5}},
+  };
+  auto selection = optimizeChain("/A", stages, distance);
+  BOOST_REQUIRE(selection);
+  // /A -> /B -> /A costs 10 + 0 + 10 + 0, /A -> /D -> /D costs 30 + 5 + 0 + 5
+  BOOST_CHECK_EQUAL(selection->totalCost, 20);
+  std::vector<ndn::Name> expected{"/B", "/A"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(selection->routers.begin(), selection->routers.end(),
+                                expected.begin(), expected.end());
+
+  stages[1] = {{"/C", 0}, {"/D", 0}};
+  selection = optimizeChain("/A", stages, distance);
+  BOOST_REQUIRE(selection);
+  // /A -> /B -> /C costs 20, /A -> /D -> /D costs 35
+  BOOST_CHECK_EQUAL(selection->totalCost, 20);
+  BOOST_CHECK_EQUAL(selection->routers[0], "/B");
+  BOOST_CHECK_EQUAL(selection->routers[1], "/C");
+
+  // a loaded /C moves the second stage to /D
+  stages[1] = {{"/C", 50}, {"/D", 0}};
+  stages[0] = {{"/B", 0}, {"/D", 15}};
+  selection = optimizeChain("/A", stages, distance);
+  BOOST_REQUIRE(selection);
+  // /A -> /B -> /D costs 10 + 0 + 20 + 0, /A -> /D -> /D costs 30 + 15
+  BOOST_CHECK_EQUAL(selection->totalCost, 30);
+  BOOST_CHECK_EQUAL(selection->routers[0], "/B");
+  BOOST_CHECK_EQUAL(selection->routers[1], "/D");
+}
+
+BOOST_AUTO_TEST_CASE(DetourCosts)
+{
+  std::vector<std::vector<ChainCandidate>> stages{
+    {{"/B", 0}, {"/C", 0}},
+    {{"/D", 0}},
+  };
+  auto selection = optimizeChain("/A", stages, distance);
+  BOOST_REQUIRE(selection);
+  // both first-stage instances lie on the way to /D
+  BOOST_CHECK_EQUAL(selection->totalCost, 30);
+  BOOST_REQUIRE_EQUAL(selection->detourCosts.size(), 2);
+  BOOST_CHECK_EQUAL(selection->detourCosts[0].at("/B"), 0);
+  BOOST_CHECK_EQUAL(selection->detourCosts[0].at("/C"), 0);
+
+  stages[1] = {{"/A", 0}};
+  selection = optimizeChain("/A", stages, distance);
+  BOOST_REQUIRE(selection);
+  BOOST_CHECK_EQUAL(selection->routers[0], "/B");
+  // /A -> /C -> /A costs 20 more than /A -> /B -> /A
+  BOOST_CHECK_EQUAL(selection->detourCosts[0].at("/B"), 0);
+  BOOST_CHECK_EQUAL(selection->detourCosts[0].at("/C"), 20);
+  BOOST_CHECK_EQUAL(selection->detourCosts[1].at("/A"), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Unreachable)
+{
+  distances.erase({"/A", "/D"});
+  std::vector<std::vector<ChainCandidate>> stages{
+    {{"/D", 0}},
+  };
+  BOOST_CHECK(!optimizeChain("/A", stages, distance));
+
+  // an unreachable instance is left out, and the source itself is at distance 0
+  stages[0].push_back({"/A", 7});
+  auto selection = optimizeChain("/A", stages, distance);
+  BOOST_REQUIRE(selection);
+  BOOST_CHECK_EQUAL(selection->routers[0], "/A");
+  BOOST_CHECK_EQUAL(selection->totalCost, 7);
+  BOOST_CHECK_EQUAL(selection->detourCosts[0].count("/D"), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "route/traffic-split.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace nlsr::tests {
+
+BOOST_AUTO_TEST_SUITE(TestTrafficSplit)
+
+BOOST_AUTO_TEST_CASE(Headroom)
+{
+  ServiceFunctionInfo info{};
+  // an instance that advertises nothing counts as one idle worker
+  BOOST_CHECK_EQUAL(computeHeadroom(info), 1.0);
+
+  info.workerCapacity = 4;
+  info.utilization = 0.75;
+  BOOST_CHECK_CLOSE(computeHeadroom(info), 1.0, 1e-9);
+
+  info.utilization = 1.2;
+  BOOST_CHECK_EQUAL(computeHeadroom(info), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(Proportional)
+{
+  auto split = computeTrafficSplit({{"udp4://10.0.0.1:6363", 3.0},
+                                    {"udp4://10.0.0.2:6363", 1.0}});
+  BOOST_REQUIRE_EQUAL(split.size(), 2);
+  // 1 each is set aside, the other 98 are split 3:1 with the largest remainder rounding
+  BOOST_CHECK_EQUAL(split["udp4://10.0.0.1:6363"], 75);
+  BOOST_CHECK_EQUAL(split["udp4://10.0.0.2:6363"], 25);
+
+  split = computeTrafficSplit({{"udp4://10.0.0.1:6363", 1.0},
+                               {"udp4://10.0.0.2:6363", 1.0},
+                               {"udp4://10.0.0.3:6363", 1.0}});
+  uint32_t sum = 0;
+  for (const auto& [faceUri, weight] : split) {
+    BOOST_CHECK_GE(weight, 33);
+    sum += weight;
+  }
+  BOOST_CHECK_EQUAL(sum, 100);
+}
+
+BOOST_AUTO_TEST_CASE(Saturated)
+{
+  // a saturated instance keeps the minimum weight
+  auto split = computeTrafficSplit({{"udp4://10.0.0.1:6363", 2.0},
+                                    {"udp4://10.0.0.2:6363", 0.0}});
+  BOOST_CHECK_EQUAL(split["udp4://10.0.0.1:6363"], 99);
+  BOOST_CHECK_EQUAL(split["udp4://10.0.0.2:6363"], 1);
+
+  // without any headroom, traffic is split evenly
+  split = computeTrafficSplit({{"udp4://10.0.0.1:6363", 0.0},
+                               {"udp4://10.0.0.2:6363", 0.0}});
+  BOOST_CHECK_EQUAL(split["udp4://10.0.0.1:6363"], 50);
+  BOOST_CHECK_EQUAL(split["udp4://10.0.0.2:6363"], 50);
+
+  BOOST_CHECK(computeTrafficSplit({}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(PreferLocalSite)
+{
+  ServiceFunctionInfo busy{};
+  busy.workerCapacity = 4;
+  busy.utilization = 0.9;
+  ServiceFunctionInfo idle{};
+
+  // 1.4 of the 5 local workers are spare
+  auto selection = selectSite({{true, busy}, {true, idle}, {false, idle}}, 0.2);
+  BOOST_CHECK_EQUAL(selection.nLocalInstances, 2);
+  BOOST_CHECK_EQUAL(selection.nRemoteInstances, 1);
+  BOOST_CHECK_CLOSE(selection.localHeadroom, 1.4 / 5, 1e-9);
+  BOOST_CHECK_EQUAL(selection.isLocalPreferred, true);
+
+  // near saturation, requests spill over to the other sites
+  busy.utilization = 1.0;
+  selection = selectSite({{true, busy}, {false, idle}}, 0.2);
+  BOOST_CHECK_EQUAL(selection.localHeadroom, 0.0);
+  BOOST_CHECK_EQUAL(selection.isLocalPreferred, false);
+
+  // there is nothing to prefer without instances in both
+  BOOST_CHECK_EQUAL(selectSite({{true, idle}}, 0.2).isLocalPreferred, false);
+  BOOST_CHECK_EQUAL(selectSite({{false, idle}}, 0.2).isLocalPreferred, false);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
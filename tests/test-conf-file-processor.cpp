@@ -293,6 +293,21 @@ BOOST_AUTO_TEST_CASE(DefaultValuesGeneral)
   BOOST_CHECK_EQUAL(processConfigurationString(config), false);
 }
 
+BOOST_AUTO_TEST_CASE(SidecarLogTimeZone)
+{
+  BOOST_REQUIRE(processConfigurationString(SECTION_GENERAL));
+  BOOST_CHECK(conf.getSidecarLogTimeZone() == SidecarTimeZone::LOCAL);
+
+  std::string config = SECTION_GENERAL;
+  config.insert(config.find('}'), "  sidecar-log-timezone UTC\n");
+  BOOST_REQUIRE(processConfigurationString(config));
+  BOOST_CHECK(conf.getSidecarLogTimeZone() == SidecarTimeZone::UTC);
+
+  config = SECTION_GENERAL;
+  config.insert(config.find('}'), "  sidecar-log-timezone +0900\n");
+  BOOST_CHECK_EQUAL(processConfigurationString(config), false);
+}
+
 BOOST_AUTO_TEST_CASE(DefaultValuesNeighbors)
 {
   std::string config = SECTION_NEIGHBORS;
@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "lsdb-snapshot.hpp"
+#include "lsa/adj-lsa.hpp"
+#include "lsa/name-lsa.hpp"
+
+#include "tests/boost-test.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+#include <stdlib.h>
+
+namespace nlsr::tests {
+
+using namespace ndn::time_literals;
+
+class LsdbSnapshotFixture
+{
+public:
+  ~LsdbSnapshotFixture()
+  {
+    std::error_code ec;
+    std::filesystem::remove_all(stateDir, ec); // ignore error
+  }
+
+  std::shared_ptr<Lsa>
+  makeNameLsa(const ndn::Name& router, uint64_t seqNo,
+              const ndn::time::system_clock::time_point& expiration)
+  {
+    NamePrefixList npl{ndn::Name("/prefix").append(router.at(-1))};
+    return std::make_shared<NameLsa>(router, seqNo, expiration, npl);
+  }
+
+  static std::string
+  makeStateDir()
+  {
+    // concurrent test runs must not share the snapshot file
+    auto pattern = (std::filesystem::temp_directory_path() / "nlsr-snapshot-XXXXXX").string();
+    if (::mkdtemp(pattern.data()) == nullptr) {
+      BOOST_FAIL("Cannot create a temporary state directory");
+    }
+    return pattern;
+  }
+
+public:
+  const std::string stateDir = makeStateDir();
+  LsdbSnapshot snapshot{stateDir};
+  ndn::time::system_clock::time_point now = ndn::time::system_clock::now();
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestLsdbSnapshot, LsdbSnapshotFixture)
+
+BOOST_AUTO_TEST_CASE(Disabled)
+{
+  LsdbSnapshot disabled("");
+  BOOST_CHECK(!disabled.isEnabled());
+  BOOST_CHECK_NO_THROW(disabled.write({makeNameLsa("/ndn/site/router1", 1, now + 1_h)}));
+  BOOST_CHECK(disabled.load().empty());
+}
+
+BOOST_AUTO_TEST_CASE(MissingFile)
+{
+  BOOST_CHECK_EQUAL(snapshot.getFilePath(), stateDir + "/nlsrLsdb.snapshot");
+  BOOST_CHECK(snapshot.load().empty());
+}
+
+BOOST_AUTO_TEST_CASE(RoundTrip)
+{
+  AdjacencyList adjacencies;
+  auto nameLsa = makeNameLsa("/ndn/site/router1", 12, now + 1_h);
+  auto adjLsa = std::make_shared<AdjLsa>("/ndn/site/router2", 5, now + 30_min, adjacencies);
+  auto expiredLsa = makeNameLsa("/ndn/site/router3", 7, now - 1_s);
+
+  snapshot.write({nameLsa, adjLsa, expiredLsa});
+  auto records = snapshot.load(now);
+
+  BOOST_REQUIRE_EQUAL(records.size(), 2);
+  BOOST_CHECK_EQUAL(records[0].wire, nameLsa->wireEncode());
+  BOOST_CHECK(records[0].expirationTimePoint > now + 59_min);
+  BOOST_CHECK_EQUAL(records[1].wire, adjLsa->wireEncode());
+
+  NameLsa decoded(records[0].wire);
+  BOOST_CHECK_EQUAL(decoded.getOriginRouter(), "/ndn/site/router1");
+  BOOST_CHECK_EQUAL(decoded.getSeqNo(), 12);
+
+  // a later write replaces the previous snapshot
+  snapshot.write({adjLsa});
+  BOOST_CHECK_EQUAL(snapshot.load(now).size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Malformed)
+{
+  snapshot.write({makeNameLsa("/ndn/site/router1", 1, now + 1_h)});
+  auto size = std::filesystem::file_size(snapshot.getFilePath());
+  std::filesystem::resize_file(snapshot.getFilePath(), size - 12);
+  BOOST_CHECK_THROW(snapshot.load(now), LsdbSnapshot::Error);
+
+  std::ofstream(snapshot.getFilePath(), std::ios::trunc) << "not a snapshot file";
+  BOOST_CHECK_THROW(snapshot.load(now), LsdbSnapshot::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
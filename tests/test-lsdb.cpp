@@ -255,6 +255,103 @@ BOOST_AUTO_TEST_CASE(SegmentLsaData)
   fetcher->stop();
 }
 
+BOOST_AUTO_TEST_CASE(BootstrapFromNeighbor)
+{
+  ndn::Name originRouter("/ndn/site/%C1.Router/this-router");
+  auto nameLsa = lsdb.findLsa<NameLsa>(originRouter);
+  BOOST_REQUIRE(nameLsa != nullptr);
+  nameLsa->addName(PrefixInfo("/bootstrap/prefix", 0));
+  nameLsa->setSeqNo(nameLsa->getSeqNo() + 1);
+  lsdb.installLsa(nameLsa);
+
+  ndn::DummyClientFace face2(m_io, m_keyChain, {true, true});
+  face.linkTo(face2);
+
+  ConfParameter conf2(face2, m_keyChain);
+  DummyConfFileProcessor confProcessor2(conf2, SyncProtocol::PSYNC, HYPERBOLIC_STATE_OFF,
+                                        "/ndn", "/site", "/%C1.Router/other-router");
+
+  Lsdb lsdb2(face2, m_keyChain, conf2);
+  advanceClocks(10_ms, 10);
+  BOOST_CHECK(lsdb2.findLsa<NameLsa>(originRouter) == nullptr);
+
+  // without a trust anchor, every LSA of the dataset fails validation
+  lsdb2.fetchLsdbFromNeighbor(1);
+  advanceClocks(10_ms, 100);
+  BOOST_CHECK(lsdb2.findLsa<NameLsa>(originRouter) == nullptr);
+  BOOST_CHECK(!lsdb2.m_isLsdbBootstrapped);
+
+  conf2.getValidator().load(R"CONF(
+              trust-anchor
+                {
+                  type any
+                }
+            )CONF", "config-file-from-string");
+  lsdb2.fetchLsdbFromNeighbor(1);
+  advanceClocks(10_ms, 100);
+
+  auto fetched = lsdb2.findLsa<NameLsa>(originRouter);
+  BOOST_REQUIRE(fetched != nullptr);
+  BOOST_CHECK_EQUAL(fetched->getSeqNo(), nameLsa->getSeqNo());
+  BOOST_CHECK_EQUAL(fetched->getNpl(), nameLsa->getNpl());
+  BOOST_CHECK(lsdb2.m_isLsdbBootstrapped);
+
+  // the bootstrap transfer is done only once
+  face2.sentInterests.clear();
+  lsdb2.fetchLsdbFromNeighbor(1);
+  advanceClocks(10_ms);
+  for (const auto& interest : face2.sentInterests) {
+    BOOST_CHECK(!ndn::Name("/localhop/ndn/nlsr/LSDB").isPrefixOf(interest.getName()));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(LsdbDatasetAcrossModification)
+{
+  ndn::Name originRouter("/ndn/site/%C1.Router/this-router");
+  auto nameLsa = lsdb.findLsa<NameLsa>(originRouter);
+  BOOST_REQUIRE(nameLsa != nullptr);
+  for (int i = 0; i < 1000; ++i) {
+    nameLsa->addName(PrefixInfo(ndn::Name("/dataset/prefix").appendNumber(i), 0));
+  }
+  nameLsa->setSeqNo(nameLsa->getSeqNo() + 1);
+  lsdb.installLsa(nameLsa);
+
+  ndn::DummyClientFace face2(m_io, m_keyChain, {true, true});
+  face.linkTo(face2);
+  std::vector<ndn::Data> received;
+  auto fetch = [&] (const ndn::Interest& interest) {
+    face2.expressInterest(interest,
+                          [&] (const ndn::Interest&, const ndn::Data& data) { received.push_back(data); },
+                          nullptr, nullptr);
+    advanceClocks(10_ms, 10);
+  };
+  const ndn::Name datasetPrefix("/localhop/ndn/nlsr/LSDB");
+
+  fetch(ndn::Interest(datasetPrefix).setCanBePrefix(true).setMustBeFresh(true));
+  BOOST_REQUIRE_EQUAL(received.size(), 1);
+  BOOST_REQUIRE(received.back().getFinalBlock());
+  BOOST_REQUIRE_GT(received.back().getFinalBlock()->toSegment(), 0);
+  ndn::Name firstVersion = received.back().getName().getPrefix(-1);
+
+  // the LSDB changes, and another neighbor starts fetching the new version
+  nameLsa->addName(PrefixInfo("/dataset/changed", 0));
+  nameLsa->setSeqNo(nameLsa->getSeqNo() + 1);
+  lsdb.installLsa(nameLsa);
+  fetch(ndn::Interest(datasetPrefix).setCanBePrefix(true).setMustBeFresh(true));
+  BOOST_REQUIRE_EQUAL(received.size(), 2);
+  BOOST_CHECK_NE(received.back().getName().getPrefix(-1), firstVersion);
+
+  // the first neighbor can still finish the previous version
+  fetch(ndn::Interest(ndn::Name(firstVersion).appendSegment(1)));
+  BOOST_REQUIRE_EQUAL(received.size(), 3);
+  BOOST_CHECK_EQUAL(received.back().getName(), ndn::Name(firstVersion).appendSegment(1));
+
+  // but not after the retention period
+  advanceClocks(1_s, LSDB_DATASET_RETENTION.count());
+  fetch(ndn::Interest(ndn::Name(firstVersion).appendSegment(1)));
+  BOOST_CHECK_EQUAL(received.size(), 3);
+}
+
 BOOST_AUTO_TEST_CASE(ReceiveSegmentedLsaData)
 {
   ndn::Name router("/ndn/cs/%C1.Router/router1");
@@ -374,6 +471,28 @@ BOOST_AUTO_TEST_CASE(InstallNameLsa)
   BOOST_CHECK_EQUAL(nameList, newPrefixes);
 }
 
+BOOST_AUTO_TEST_CASE(InstallNameLsaWireStorage)
+{
+  conf.setLsaWireStorageEnabled(true);
+  connectSignal();
+
+  ndn::Name otherRouter("/ndn/site/%C1.router/other-router");
+  NamePrefixList prefixes{ndn::Name("/ndn/name1")};
+  NameLsa lsa(otherRouter, 1, ndn::time::system_clock::time_point::max(), prefixes);
+  lsdb.installLsa(std::make_shared<NameLsa>(lsa.wireEncode()));
+
+  auto installed = lsdb.findLsa<NameLsa>(otherRouter);
+  BOOST_REQUIRE(installed != nullptr);
+  BOOST_CHECK(installed->wireEncode().data() == lsa.wireEncode().data());
+  BOOST_CHECK_EQUAL(std::as_const(*installed).getNpl(), prefixes);
+
+  prefixes.insert(ndn::Name("/ndn/name2"));
+  NameLsa addLsa(otherRouter, 2, ndn::time::system_clock::time_point::max(), prefixes);
+  lsdb.installLsa(std::make_shared<NameLsa>(addLsa.wireEncode()));
+  checkSignalResult(LsdbUpdate::UPDATED, installed, {PrefixInfo(ndn::Name("/ndn/name2"), 0)}, {});
+  BOOST_CHECK_EQUAL(std::as_const(*installed).getNpl(), prefixes);
+}
+
 BOOST_AUTO_TEST_CASE(TestIsLsaNew)
 {
   ndn::Name originRouter("/ndn/memphis/%C1.Router/other-router");
@@ -0,0 +1,62 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "router-name-interner.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace nlsr::tests {
+
+BOOST_AUTO_TEST_SUITE(TestRouterNameInterner)
+
+BOOST_AUTO_TEST_CASE(Basic)
+{
+  RouterNameInterner interner;
+  ndn::Name router1("/ndn/site/%C1.Router/router1");
+  ndn::Name router2("/ndn/site/%C1.Router/router2");
+
+  BOOST_CHECK(!interner.find(router1).has_value());
+
+  RouterId id1 = interner.intern(router1);
+  RouterId id2 = interner.intern(router2);
+  BOOST_CHECK_NE(id1, id2);
+  BOOST_CHECK_EQUAL(interner.size(), 2);
+
+  // interning again returns the same id
+  BOOST_CHECK_EQUAL(interner.intern(ndn::Name(router1)), id1);
+  BOOST_CHECK_EQUAL(interner.size(), 2);
+  BOOST_CHECK_EQUAL(interner.find(router2).value_or(id1), id2);
+
+  BOOST_CHECK_EQUAL(interner.getName(id1), router1);
+  BOOST_CHECK_EQUAL(interner.getHash(id2), std::hash<ndn::Name>{}(router2));
+
+  // names stay valid as the table grows
+  const ndn::Name& name1 = interner.getName(id1);
+  for (int i = 0; i < 1000; ++i) {
+    interner.intern(ndn::Name("/ndn/site/%C1.Router").appendNumber(i));
+  }
+  BOOST_CHECK_EQUAL(name1, router1);
+  BOOST_CHECK_THROW(interner.getName(static_cast<RouterId>(interner.size())), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
@@ -213,6 +213,24 @@ BOOST_AUTO_TEST_CASE(LsdbSendLsaInterest)
   BOOST_CHECK_EQUAL(collector.getStatistics().get(Statistics::PacketType::SENT_LSA_INTEREST), 3);
 }
 
+BOOST_AUTO_TEST_CASE(LsdbSendLsaInterestMultipath)
+{
+  conf.setLsaMultipathFetchEnabled(true);
+  ndn::Name interestName("/localhop/ndn/nlsr/LSA/site/%C1.Router/router/NAME");
+  interestName.appendNumber(1);
+
+  lsdb.expressInterest(interestName, 0, 11, ndn::time::steady_clock::time_point::min());
+  this->advanceClocks(ndn::time::milliseconds(1), 10);
+
+  // a neighbor announcing the same LSA joins the running fetch without another count
+  lsdb.expressInterest(interestName, 0, 22, ndn::time::steady_clock::time_point::min());
+  this->advanceClocks(ndn::time::milliseconds(1), 10);
+
+  BOOST_CHECK_EQUAL(lsdb.m_multipathFetchers.at(interestName)->getNFaces(), 2);
+  BOOST_CHECK_EQUAL(collector.getStatistics().get(Statistics::PacketType::SENT_NAME_LSA_INTEREST), 1);
+  BOOST_CHECK_EQUAL(collector.getStatistics().get(Statistics::PacketType::SENT_LSA_INTEREST), 1);
+}
+
 /*
  * Tests the statistics collected upon processing incoming lsa
  * interests and respective outgoing data. This process will trigger